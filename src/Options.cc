@@ -10,7 +10,9 @@ Config nConfig;
 void ShowHelp() {
   std::cout << "--help | -h: Prints this.\n"
                "--load-layer | -l [layer.vlk]: The editor will instantly load "
-               "and select the layer saved within the given file.\n";
+               "and select the layer saved within the given file.\n"
+               "--load-stats | -s [stats.csv|stats.json]: Writes the load "
+               "stats of all assets to the given file when the engine exits.\n";
 }
 
 Result Init(int argc, char* argv[], Config&& config) {
@@ -20,10 +22,11 @@ Result Init(int argc, char* argv[], Config&& config) {
     projectDir += '/';
   }
 
-  const char* getoptString = "hl:";
+  const char* getoptString = "hl:s:";
   option allOptions[] = {
     {"help", no_argument, NULL, 'h'},
     {"load-layer", required_argument, NULL, 'l'},
+    {"load-stats", required_argument, NULL, 's'},
     {0, 0, 0, 0}};
   int currentOp = 0;
   while (currentOp != -1) {
@@ -31,6 +34,7 @@ Result Init(int argc, char* argv[], Config&& config) {
     switch (currentOp) {
     case 'h': ShowHelp(); return Result("Help requested.");
     case 'l': nConfig.mLoadLayers.Push(optarg); break;
+    case 's': nConfig.mLoadStatsFile = optarg; break;
     case '?': return Result("Invalid command line arguments.");
     }
   }
@@ -21,6 +21,9 @@ struct Config {
   std::string mProjectDirectory;
   EditorLevel mEditorLevel;
   Ds::Vector<std::string> mLoadLayers;
+  // When not empty, the load stats of all assets are written to this file
+  // before the engine is purged.
+  std::string mLoadStatsFile;
 };
 
 extern Config nConfig;
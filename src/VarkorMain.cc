@@ -7,11 +7,14 @@
 #include "Temporal.h"
 #include "Viewport.h"
 #include "debug/Draw.h"
+#include "debug/MemTrack.h"
+#include "ds/Arena.h"
 #include "editor/Editor.h"
 #include "ext/Tracy.h"
 #include "gfx/GlError.h"
 #include "gfx/Renderer.h"
 #include "gfx/UniformVector.h"
+#include "rsl/Async.h"
 #include "rsl/Library.h"
 #include "world/World.h"
 
@@ -51,14 +54,22 @@ void VarkorRun() {
     Viewport::SwapBuffers();
     Viewport::Update();
     Rsl::HandleInitialization();
+    Rsl::ResumeTasks();
 
     Framer::End();
+    Ds::ResetFrameArena();
+    Debug::MemTrack::Update();
 
     FrameMark;
   }
 }
 
 void VarkorPurge() {
+  if (!Options::nConfig.mLoadStatsFile.empty()) {
+    Result result = Rsl::WriteLoadStats(Options::nConfig.mLoadStatsFile);
+    LogErrorIf(!result.Success(), result.mError.c_str());
+  }
+  Rsl::PurgeTasks();
   Editor::Purge();
   World::Purge();
   Gfx::Renderer::Purge();
@@ -1,3 +1,5 @@
+#include <mutex>
+
 #include "Viewport.h"
 #include "Input.h"
 #include "Log.h"
@@ -12,6 +14,8 @@ void ErrorCallback(int code, const char* description);
 
 GLFWwindow* nWindow;
 GLFWwindow* nSharedWindow;
+std::mutex nSharedContextMutex;
+thread_local unsigned int nSharedContextUses = 0;
 bool nActive = true;
 int nWidth;
 int nHeight;
@@ -67,12 +71,26 @@ void SwapBuffers() {
   glfwSwapBuffers(nWindow);
 }
 
-void StartContextSharing() {
-  glfwMakeContextCurrent(nSharedWindow);
+SharedContext::SharedContext(): mOwner(glfwGetCurrentContext() == nullptr) {
+  if (mOwner) {
+    nSharedContextMutex.lock();
+    glfwMakeContextCurrent(nSharedWindow);
+    ++nSharedContextUses;
+  }
+}
+
+SharedContext::~SharedContext() {
+  if (mOwner) {
+    // Flushing makes the commands visible to the other contexts once they
+    // complete.
+    glFlush();
+    glfwMakeContextCurrent(nullptr);
+    nSharedContextMutex.unlock();
+  }
 }
 
-void EndContextSharing() {
-  glfwMakeContextCurrent(nullptr);
+unsigned int SharedContextUses() {
+  return nSharedContextUses;
 }
 
 int Width() {
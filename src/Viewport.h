@@ -9,8 +9,23 @@ void Init(const char* windowName, bool visible = true);
 void Update();
 void Purge();
 void SwapBuffers();
-void StartContextSharing();
-void EndContextSharing();
+
+// Threads other than the main thread share a single context. A SharedContext
+// makes that context current on the calling thread for the guard's lifetime so
+// gl calls can be made. Nothing happens when a context is already current,
+// which is the case on the main thread and within another SharedContext.
+struct SharedContext {
+  SharedContext();
+  ~SharedContext();
+  SharedContext(const SharedContext& other) = delete;
+  SharedContext& operator=(const SharedContext& other) = delete;
+
+private:
+  bool mOwner;
+};
+// The number of times a SharedContext made the shared context current on the
+// calling thread. Comparing counts tells whether work used the shared context.
+unsigned int SharedContextUses();
 
 int Width();
 int Height();
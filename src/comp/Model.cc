@@ -25,12 +25,16 @@ void Model::VRenderable(const World::Object& owner) {
   if (!mVisible) {
     return;
   }
-  const Gfx::Model* model = Rsl::TryGetRes<Gfx::Model>(mModelId);
+  Comp::Transform& transform = owner.Get<Comp::Transform>();
+  float priority =
+    Gfx::Collection::InitPriority(transform.GetWorldTranslation(owner));
+  const Gfx::Model* model =
+    Rsl::TryGetRes<Gfx::Model>(mModelId, ResId(), priority);
   if (model == nullptr) {
     return;
   }
 
-  Mat4 ownerTransform = owner.Get<Comp::Transform>().GetWorldMatrix(owner);
+  Mat4 ownerTransform = transform.GetWorldMatrix(owner);
   for (size_t i = 0; i < model->RenderableCount(); ++i) {
     Gfx::Renderable::Floater floater = model->GetFloater(i);
     floater.mOwner = owner.mMemberId;
@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "ds/SmallVector.h"
 #include "vlk/Valkor.h"
 #include "world/Object.h"
 #include "world/Types.h"
@@ -23,7 +24,7 @@ struct Relationship {
   inline bool HasRelationship() const;
 
   MemberId mParent;
-  Ds::Vector<MemberId> mChildren;
+  Ds::SmallVector<MemberId, 4> mChildren;
 };
 #pragma pack(pop)
 
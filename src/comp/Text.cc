@@ -65,7 +65,7 @@ void Text::VRenderable(const World::Object& owner) {
   size_t currentCharacter = 0;
   auto& transformComp = owner.Get<Comp::Transform>();
   const Mat4& ownerTransformation = transformComp.GetWorldMatrix(owner);
-  Ds::Vector<Line> lines = GetLines(*font);
+  Ds::SmallVector<Line, 8> lines = GetLines(*font);
   for (const Line& line: lines) {
     switch (mAlign) {
     case Alignment::Left: baselineOffset[0] = -halfWidth; break;
@@ -122,8 +122,8 @@ void Text::VEdit(const World::Object& owner) {
   ImGui::PopID();
 }
 
-Ds::Vector<Text::Line> Text::GetLines(const Gfx::Font& font) const {
-  Ds::Vector<Line> lines;
+Ds::SmallVector<Text::Line, 8> Text::GetLines(const Gfx::Font& font) const {
+  Ds::SmallVector<Line, 8> lines;
 
   auto isWhitespace = [](char codepoint) -> bool {
     return (codepoint == ' ' || codepoint == '\t' || codepoint == '\n');
@@ -4,7 +4,7 @@
 #include <glad/glad.h>
 #include <string>
 
-#include "ds/Vector.h"
+#include "ds/SmallVector.h"
 #include "gfx/Font.h"
 #include "math/Matrix4.h"
 #include "rsl/ResourceId.h"
@@ -32,7 +32,7 @@ struct Text {
     float mWidth;
   };
   // Find the lines for a word wrapped version of the rendererd text.
-  Ds::Vector<Line> GetLines(const Gfx::Font& font) const;
+  Ds::SmallVector<Line, 8> GetLines(const Gfx::Font& font) const;
 
   ResId mFontId;
   ResId mMaterialId;
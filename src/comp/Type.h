@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "ds/SmallVector.h"
 #include "ds/Vector.h"
 #include "gfx/Renderable.h"
 #include "util/Delegate.h"
@@ -32,7 +33,7 @@ struct Type {
 struct TypeData {
   std::string mName;
   size_t mSize;
-  Ds::Vector<TypeId> mDependencies;
+  Ds::SmallVector<TypeId, 4> mDependencies;
   Ds::Vector<TypeId> mDependants;
   void (*mDefaultConstruct)(void* data);
   void (*mCopyConstruct)(void* from, void* to);
@@ -1,19 +1,21 @@
 // This is for basic memory debugging under windows while building with msvc
-// debug. Calling InitMemLeakOutput at any point during execution will print all
-// memory leaks to stdout after the program exits. This file should be included
-// with any file that calls new. alloc should be used a replacement for the new
-// keyword in any case where new memory is allocted. It should not be used when
-// new is used for placement new. The alloc keyword will allow the memory leak
-// output to contain file and line number information for memory blocks.
+// debug. Calling EnableLeakOutput at any point during execution will print all
+// memory leaks to stdout after the program exits. alloc should be used in place
+// of the new keyword in any case where new memory is allocated, but not for
+// placement new. Per subsystem allocation statistics on every platform are
+// provided by debug/MemTrack.h.
 
 #ifndef debug_MemLeak_h
 #define debug_MemLeak_h
 
-// todo: Investigate new ways to track memory leaks that don't involve replacing
-// the new keyword for lines that perform actual memory allocation.
+// The debug heap's operator new gives leaks a file and line number, but it
+// can't be used for alloc when debug/MemTrack.cc replaces the global operator
+// new and delete. Leaks are still reported without their locations then.
 #if defined WIN32 && defined _DEBUG
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
+#endif
+#if defined WIN32 && defined _DEBUG && !defined VARKOR_MEMTRACK
 #define alloc new (_CLIENT_BLOCK, __FILE__, __LINE__)
 #else
 #define alloc new
@@ -22,9 +24,4 @@
 void EnableLeakOutput();
 void DisableLeakOutput();
 
-#ifdef TRACY_ENABLE
-void* operator new(size_t size);
-void operator delete(void* data) noexcept;
-#endif
-
 #endif
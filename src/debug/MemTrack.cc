@@ -0,0 +1,293 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "debug/MemTrack.h"
+
+#ifdef TRACY_ENABLE
+#include "ext/Tracy.h"
+#endif
+
+namespace Debug {
+namespace MemTrack {
+
+typedef std::chrono::steady_clock Clock;
+
+// The atomics are modified by any thread that allocates. The remaining values
+// are only used by Update and the getters on the main thread.
+struct TagData {
+  std::atomic<size_t> mLiveBytes;
+  std::atomic<size_t> mPeakBytes;
+  std::atomic<size_t> mLiveAllocations;
+  std::atomic<size_t> mTotalAllocations;
+  std::atomic<size_t> mTotalBytes;
+
+  size_t mPreviousTotalAllocations;
+  size_t mPreviousTotalBytes;
+  float mAllocationsPerSecond;
+  float mBytesPerSecond;
+};
+TagData nTagData[(int)Tag::Count];
+thread_local Tag nCurrentTag = Tag::Untagged;
+
+float nRatePeriod = 1.0f;
+Clock::time_point nPreviousRateTime;
+
+// Every allocation is preceded by a header. The header is padded so the memory
+// that follows it has the same alignment that malloc provides. Over-aligned
+// allocations are offset further into their block, and the offset is used to
+// find the start of the block when it's freed.
+struct Header {
+  size_t mSize;
+  Tag mTag;
+  unsigned int mOffset;
+};
+constexpr size_t nHeaderSize = alignof(std::max_align_t);
+static_assert(sizeof(Header) <= nHeaderSize, "The Header must fit.");
+
+const char* GetTagName(Tag tag) {
+  switch (tag) {
+  case Tag::Untagged: return "Untagged";
+  case Tag::World: return "World";
+  case Tag::Rsl: return "Rsl";
+  case Tag::Vlk: return "Vlk";
+  case Tag::Gfx: return "Gfx";
+  case Tag::Editor: return "Editor";
+  case Tag::Count: break;
+  }
+  return "Invalid";
+}
+
+Scope::Scope(Tag tag): mPreviousTag(nCurrentTag) {
+  nCurrentTag = tag;
+}
+
+Scope::~Scope() {
+  nCurrentTag = mPreviousTag;
+}
+
+Tag CurrentTag() {
+  return nCurrentTag;
+}
+
+Stats GetStats(Tag tag) {
+  const TagData& data = nTagData[(int)tag];
+  Stats stats;
+  stats.mLiveBytes = data.mLiveBytes.load(std::memory_order_relaxed);
+  stats.mPeakBytes = data.mPeakBytes.load(std::memory_order_relaxed);
+  stats.mLiveAllocations =
+    data.mLiveAllocations.load(std::memory_order_relaxed);
+  stats.mTotalAllocations =
+    data.mTotalAllocations.load(std::memory_order_relaxed);
+  stats.mAllocationsPerSecond = data.mAllocationsPerSecond;
+  stats.mBytesPerSecond = data.mBytesPerSecond;
+  return stats;
+}
+
+Stats GetTotalStats() {
+  // The peak of the total is the sum of the tag peaks, so it is an upper bound.
+  Stats total = {0, 0, 0, 0, 0.0f, 0.0f};
+  for (int i = 0; i < (int)Tag::Count; ++i) {
+    Stats stats = GetStats((Tag)i);
+    total.mLiveBytes += stats.mLiveBytes;
+    total.mPeakBytes += stats.mPeakBytes;
+    total.mLiveAllocations += stats.mLiveAllocations;
+    total.mTotalAllocations += stats.mTotalAllocations;
+    total.mAllocationsPerSecond += stats.mAllocationsPerSecond;
+    total.mBytesPerSecond += stats.mBytesPerSecond;
+  }
+  return total;
+}
+
+void Update() {
+  Clock::time_point currentTime = Clock::now();
+  std::chrono::duration<float> elapsed = currentTime - nPreviousRateTime;
+  if (elapsed.count() < nRatePeriod) {
+    return;
+  }
+  for (TagData& data: nTagData) {
+    size_t totalAllocations =
+      data.mTotalAllocations.load(std::memory_order_relaxed);
+    size_t totalBytes = data.mTotalBytes.load(std::memory_order_relaxed);
+    data.mAllocationsPerSecond =
+      (float)(totalAllocations - data.mPreviousTotalAllocations) /
+      elapsed.count();
+    data.mBytesPerSecond =
+      (float)(totalBytes - data.mPreviousTotalBytes) / elapsed.count();
+    data.mPreviousTotalAllocations = totalAllocations;
+    data.mPreviousTotalBytes = totalBytes;
+  }
+  nPreviousRateTime = currentTime;
+}
+
+void* Allocate(size_t size, size_t alignment) {
+  // Blocks from malloc are aligned to nHeaderSize, so an over-aligned
+  // allocation needs at most alignment - nHeaderSize extra bytes to be moved
+  // forward to an aligned address.
+  size_t padding = alignment > nHeaderSize ? alignment - nHeaderSize : 0;
+  char* block = (char*)malloc(nHeaderSize + padding + size);
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  char* allocation = block + nHeaderSize;
+  if (alignment > nHeaderSize) {
+    size_t misalignment = (uintptr_t)allocation % alignment;
+    if (misalignment != 0) {
+      allocation += alignment - misalignment;
+    }
+  }
+  Header* header = (Header*)(allocation - nHeaderSize);
+  header->mSize = size;
+  header->mTag = nCurrentTag;
+  header->mOffset = (unsigned int)(allocation - block);
+
+  TagData& data = nTagData[(int)header->mTag];
+  size_t liveBytes =
+    data.mLiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+  size_t peakBytes = data.mPeakBytes.load(std::memory_order_relaxed);
+  while (liveBytes > peakBytes &&
+         !data.mPeakBytes.compare_exchange_weak(
+           peakBytes, liveBytes, std::memory_order_relaxed)) {
+  }
+  data.mLiveAllocations.fetch_add(1, std::memory_order_relaxed);
+  data.mTotalAllocations.fetch_add(1, std::memory_order_relaxed);
+  data.mTotalBytes.fetch_add(size, std::memory_order_relaxed);
+
+#ifdef TRACY_ENABLE
+  TracyAlloc(allocation, size);
+#endif
+  return allocation;
+}
+
+void* TryAllocate(size_t size, size_t alignment) noexcept {
+  try {
+    return Allocate(size, alignment);
+  }
+  catch (const std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+void Deallocate(void* allocation) {
+  if (allocation == nullptr) {
+    return;
+  }
+#ifdef TRACY_ENABLE
+  TracyFree(allocation);
+#endif
+  Header* header = (Header*)((char*)allocation - nHeaderSize);
+  TagData& data = nTagData[(int)header->mTag];
+  data.mLiveBytes.fetch_sub(header->mSize, std::memory_order_relaxed);
+  data.mLiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+  free((char*)allocation - header->mOffset);
+}
+
+} // namespace MemTrack
+} // namespace Debug
+
+#ifdef VARKOR_MEMTRACK
+// Every replaceable form of operator new and delete is replaced so no
+// allocation escapes tracking. The sizes given to sized deletes aren't needed
+// because the header holds the size.
+void* operator new(size_t size) {
+  return Debug::MemTrack::Allocate(size, 0);
+}
+
+void* operator new[](size_t size) {
+  return Debug::MemTrack::Allocate(size, 0);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return Debug::MemTrack::Allocate(size, (size_t)alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return Debug::MemTrack::Allocate(size, (size_t)alignment);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return Debug::MemTrack::TryAllocate(size, 0);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return Debug::MemTrack::TryAllocate(size, 0);
+}
+
+void* operator new(
+  size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return Debug::MemTrack::TryAllocate(size, (size_t)alignment);
+}
+
+void* operator new[](
+  size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return Debug::MemTrack::TryAllocate(size, (size_t)alignment);
+}
+
+void operator delete(void* allocation) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete[](void* allocation) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete(void* allocation, size_t) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete[](void* allocation, size_t) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete(void* allocation, std::align_val_t) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete[](void* allocation, std::align_val_t) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete(void* allocation, size_t, std::align_val_t) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete[](void* allocation, size_t, std::align_val_t) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete(void* allocation, const std::nothrow_t&) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete[](void* allocation, const std::nothrow_t&) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete(
+  void* allocation, std::align_val_t, const std::nothrow_t&) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+void operator delete[](
+  void* allocation, std::align_val_t, const std::nothrow_t&) noexcept {
+  Debug::MemTrack::Deallocate(allocation);
+}
+
+#elif defined TRACY_ENABLE
+// Tracy still profiles memory when allocations aren't tracked.
+void* operator new(size_t size) {
+  void* data = malloc(size);
+  if (data == nullptr) {
+    throw std::bad_alloc();
+  }
+  TracyAlloc(data, size);
+  return data;
+}
+
+void operator delete(void* data) noexcept {
+  TracyFree(data);
+  free(data);
+}
+#endif
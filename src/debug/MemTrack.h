@@ -0,0 +1,57 @@
+// Every allocation made with the global operator new is attributed to the tag
+// that is active on the allocating thread. A Scope sets the active tag, and
+// memory is returned to the tag it was allocated under no matter which thread
+// frees it. Each allocation carries a small header and updates a few relaxed
+// atomics, so tracking is cheap enough to leave on in builds with debug info.
+//
+// Allocations are only tracked when VARKOR_MEMTRACK is defined. Otherwise the
+// global operator new and delete aren't replaced and every stat stays zero.
+
+#ifndef debug_MemTrack_h
+#define debug_MemTrack_h
+
+#include <cstddef>
+
+namespace Debug {
+namespace MemTrack {
+
+enum class Tag {
+  Untagged,
+  World,
+  Rsl,
+  Vlk,
+  Gfx,
+  Editor,
+  Count,
+};
+const char* GetTagName(Tag tag);
+
+struct Scope {
+  Scope(Tag tag);
+  ~Scope();
+
+private:
+  Tag mPreviousTag;
+};
+Tag CurrentTag();
+
+struct Stats {
+  size_t mLiveBytes;
+  size_t mPeakBytes;
+  size_t mLiveAllocations;
+  size_t mTotalAllocations;
+  // These are averages over the last rate period.
+  float mAllocationsPerSecond;
+  float mBytesPerSecond;
+};
+Stats GetStats(Tag tag);
+Stats GetTotalStats();
+
+// This should be called once per frame so allocation rates are kept up to date.
+extern float nRatePeriod;
+void Update();
+
+} // namespace MemTrack
+} // namespace Debug
+
+#endif
@@ -0,0 +1,21 @@
+#include "ds/Allocator.h"
+#include "debug/MemLeak.h"
+#include "ds/Arena.h"
+
+namespace Ds {
+
+void* HeapAllocator::Allocate(size_t byteCount) {
+  return alloc char[byteCount];
+}
+
+void HeapAllocator::Deallocate(void* allocation) {
+  delete[] (char*)allocation;
+}
+
+void* FrameAllocator::Allocate(size_t byteCount) {
+  return FrameArena().Allocate(byteCount);
+}
+
+void FrameAllocator::Deallocate(void*) {}
+
+} // namespace Ds
@@ -0,0 +1,27 @@
+#ifndef ds_Allocator_h
+#define ds_Allocator_h
+
+#include <cstddef>
+
+namespace Ds {
+
+// Containers that take an allocator as a template parameter get their raw
+// memory through its static Allocate and Deallocate functions.
+
+// Allocates from the global heap. This is the default.
+struct HeapAllocator {
+  static void* Allocate(size_t byteCount);
+  static void Deallocate(void* allocation);
+};
+
+// Allocates from the calling thread's frame arena. Deallocate does nothing
+// because everything is released when the frame arena is reset. A container
+// using this must not outlive the frame it was created in.
+struct FrameAllocator {
+  static void* Allocate(size_t byteCount);
+  static void Deallocate(void* allocation);
+};
+
+} // namespace Ds
+
+#endif
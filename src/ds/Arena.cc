@@ -0,0 +1,93 @@
+#include "ds/Arena.h"
+#include "debug/MemLeak.h"
+
+namespace Ds {
+
+constexpr size_t nFrameArenaBlockSize = 1 << 20;
+
+char* Arena::Block::Data() {
+  return (char*)this + smBlockHeaderSize;
+}
+
+Arena::Arena(size_t blockSize):
+  mHead(nullptr),
+  mOffset(0),
+  mBlockSize(blockSize),
+  mUsage(0),
+  mPeakUsage(0) {}
+
+Arena::~Arena() {
+  DeleteBlocks();
+}
+
+void* Arena::Allocate(size_t byteCount) {
+  size_t size = (byteCount + smAlignment - 1) & ~(smAlignment - 1);
+  if (mHead == nullptr || mOffset + size > mHead->mSize) {
+    AddBlock(size);
+  }
+  void* allocation = mHead->Data() + mOffset;
+  mOffset += size;
+  mUsage += size;
+  if (mUsage > mPeakUsage) {
+    mPeakUsage = mUsage;
+  }
+  return allocation;
+}
+
+void Arena::Reset() {
+  mOffset = 0;
+  mUsage = 0;
+  if (mHead == nullptr || mHead->mNext == nullptr) {
+    return;
+  }
+
+  // When multiple blocks were needed, they are replaced with a single block
+  // that can hold all of them so the next reset period uses one block.
+  size_t capacity = Capacity();
+  DeleteBlocks();
+  AddBlock(capacity);
+}
+
+size_t Arena::Usage() const {
+  return mUsage;
+}
+
+size_t Arena::PeakUsage() const {
+  return mPeakUsage;
+}
+
+size_t Arena::Capacity() const {
+  size_t capacity = 0;
+  for (Block* block = mHead; block != nullptr; block = block->mNext) {
+    capacity += block->mSize;
+  }
+  return capacity;
+}
+
+void Arena::AddBlock(size_t minimumSize) {
+  size_t size = minimumSize > mBlockSize ? minimumSize : mBlockSize;
+  Block* block = (Block*)alloc char[smBlockHeaderSize + size];
+  block->mNext = mHead;
+  block->mSize = size;
+  mHead = block;
+  mOffset = 0;
+}
+
+void Arena::DeleteBlocks() {
+  while (mHead != nullptr) {
+    Block* next = mHead->mNext;
+    delete[] (char*)mHead;
+    mHead = next;
+  }
+}
+
+Arena& FrameArena() {
+  thread_local Arena frameArena(nFrameArenaBlockSize);
+  return frameArena;
+}
+
+void ResetFrameArena() {
+  FrameArena().Reset();
+}
+
+} // namespace Ds
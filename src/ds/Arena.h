@@ -0,0 +1,57 @@
+#ifndef ds_Arena_h
+#define ds_Arena_h
+
+#include <cstddef>
+
+namespace Ds {
+
+// A linear allocator. Allocations are made by bumping an offset within a block
+// and they can't be freed individually. Reset releases every allocation at once
+// and keeps the memory so following allocations don't touch the global heap.
+struct Arena {
+public:
+  Arena(size_t blockSize);
+  ~Arena();
+  Arena(const Arena& other) = delete;
+  Arena& operator=(const Arena& other) = delete;
+
+  void* Allocate(size_t byteCount);
+  void Reset();
+
+  size_t Usage() const;
+  size_t PeakUsage() const;
+  size_t Capacity() const;
+
+  constexpr static size_t smAlignment = alignof(std::max_align_t);
+
+private:
+  struct Block {
+    Block* mNext;
+    size_t mSize;
+    char* Data();
+  };
+  // Block headers are padded so the data following them is aligned.
+  constexpr static size_t smBlockHeaderSize =
+    (sizeof(Block) + smAlignment - 1) & ~(smAlignment - 1);
+
+  // Allocations are made from mHead. When it is full, a new block is created
+  // and placed in front of it.
+  Block* mHead;
+  size_t mOffset;
+  size_t mBlockSize;
+  size_t mUsage;
+  size_t mPeakUsage;
+
+  void AddBlock(size_t minimumSize);
+  void DeleteBlocks();
+};
+
+// Every thread has its own frame arena for data that only lives until the end of
+// the current frame. The main thread's frame arena is reset at the end of every
+// frame. Other threads are responsible for resetting their own.
+Arena& FrameArena();
+void ResetFrameArena();
+
+} // namespace Ds
+
+#endif
@@ -11,7 +11,7 @@ template<typename T>
 struct HashSet;
 template<typename K, typename V>
 struct HashMap;
-template<typename T>
+template<typename T, typename A>
 struct Vector;
 
 template<typename K, typename V>
@@ -37,7 +37,8 @@ private:
   friend Map<K, V>;
   friend HashSet<KvPair<K, V>>;
   friend HashMap<K, V>;
-  friend Vector<KvPair<K, V>>;
+  template<typename T, typename A>
+  friend struct Vector;
 };
 
 template<typename K, typename V>
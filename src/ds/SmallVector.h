@@ -0,0 +1,94 @@
+#ifndef ds_SmallVector_h
+#define ds_SmallVector_h
+
+#include <cstdlib>
+#include <initializer_list>
+
+#include "Result.h"
+#include "ds/Sort.h"
+
+namespace Ds {
+
+// A SmallVector has the same interface as a Vector, but it stores its first N
+// elements inside of itself. Only when the size exceeds N will the elements be
+// moved to an allocation on the heap. This is meant for vectors that usually
+// hold a handful of elements and are created or filled often.
+template<typename T, size_t N>
+struct SmallVector {
+  static_assert(N > 0, "A SmallVector requires inline capacity.");
+
+public:
+  SmallVector();
+  SmallVector(const SmallVector<T, N>& other);
+  SmallVector(SmallVector<T, N>&& other);
+  SmallVector(const std::initializer_list<T>& other);
+  ~SmallVector();
+  void Push(const T& value);
+  void Push(T&& value);
+  void Push(const T& value, size_t count);
+  template<typename... Args>
+  void Emplace(Args&&... args);
+  void Insert(size_t index, const T& value);
+  void Insert(size_t index, T&& value);
+  void Swap(size_t indexA, size_t indexB);
+  void Sort();
+  template<typename GreaterThan>
+  void Sort(GreaterThan greaterThan);
+  void RadixSort();
+  template<typename GetKey>
+  void RadixSort(GetKey getKey);
+  void Pop();
+  void Clear();
+  void Remove(size_t index);
+  void LazyRemove(size_t index);
+  template<typename... Args>
+  void Resize(size_t newSize, Args&&... args);
+  void Reserve(size_t newCapacity);
+  void Shrink();
+
+  template<typename CT>
+  VResult<size_t> Find(const CT& value) const;
+  template<typename CT>
+  bool Contains(const CT& value) const;
+  size_t Size() const;
+  bool Empty() const;
+  size_t Capacity() const;
+  bool Inline() const;
+  const T* CData() const;
+  T* Data();
+  T& Top() const;
+
+  const T& operator[](size_t index) const;
+  T& operator[](size_t index);
+  SmallVector<T, N>& operator=(const SmallVector<T, N>& other);
+  SmallVector<T, N>& operator=(SmallVector<T, N>&& other);
+  SmallVector<T, N>& operator=(const std::initializer_list<T>& other);
+
+  T* begin();
+  T* end();
+  const T* begin() const;
+  const T* end() const;
+
+  constexpr static size_t smInlineCapacity = N;
+  const static float smGrowthFactor;
+
+private:
+  T* mData;
+  size_t mSize;
+  size_t mCapacity;
+  alignas(T) char mInlineData[N * sizeof(T)];
+
+private:
+  T* InlineData();
+  void VerifyIndex(size_t index) const;
+  void CreateGap(size_t index);
+  void Grow();
+  void Grow(size_t newCapacity);
+  void Relocate(T* newData, size_t newCapacity);
+};
+
+} // namespace Ds
+
+#include "SmallVector.hh"
+
+#endif
@@ -0,0 +1,414 @@
+#include <sstream>
+#include <utility>
+
+#include "Error.h"
+#include "debug/MemLeak.h"
+#include "util/Memory.h"
+
+namespace Ds {
+
+template<typename T, size_t N>
+const float SmallVector<T, N>::smGrowthFactor = 2.0f;
+
+template<typename T, size_t N>
+SmallVector<T, N>::SmallVector():
+  mData(InlineData()), mSize(0), mCapacity(N) {}
+
+template<typename T, size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector<T, N>& other): SmallVector() {
+  Reserve(other.mSize);
+  Util::CopyConstructRange<T>(other.mData, mData, other.mSize);
+  mSize = other.mSize;
+}
+
+template<typename T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector<T, N>&& other): SmallVector() {
+  *this = std::move(other);
+}
+
+template<typename T, size_t N>
+SmallVector<T, N>::SmallVector(const std::initializer_list<T>& list):
+  SmallVector() {
+  *this = list;
+}
+
+template<typename T, size_t N>
+SmallVector<T, N>::~SmallVector() {
+  Clear();
+  if (!Inline()) {
+    delete[] (char*)mData;
+  }
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Push(const T& value) {
+  if (mSize >= mCapacity) {
+    Grow();
+  }
+  new (mData + mSize) T(value);
+  ++mSize;
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Push(T&& value) {
+  if (mSize >= mCapacity) {
+    Grow();
+  }
+  new (mData + mSize) T(std::forward<T>(value));
+  ++mSize;
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Push(const T& value, size_t count) {
+  size_t newSize = mSize + count;
+  size_t newCapacity = mCapacity;
+  while (newSize > newCapacity) {
+    newCapacity = (size_t)((float)newCapacity * smGrowthFactor);
+  }
+  if (newCapacity > mCapacity) {
+    Grow(newCapacity);
+  }
+  for (size_t i = mSize; i < newSize; ++i) {
+    new (mData + i) T(value);
+  }
+  mSize = newSize;
+}
+
+template<typename T, size_t N>
+template<typename... Args>
+void SmallVector<T, N>::Emplace(Args&&... args) {
+  if (mSize >= mCapacity) {
+    Grow();
+  }
+  new (mData + mSize) T(std::forward<Args>(args)...);
+  ++mSize;
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Insert(size_t index, const T& value) {
+  if (index == mSize) {
+    Push(value);
+    return;
+  }
+  CreateGap(index);
+  mData[index] = value;
+  ++mSize;
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Insert(size_t index, T&& value) {
+  if (index == mSize) {
+    Push(std::move(value));
+    return;
+  }
+  CreateGap(index);
+  mData[index] = std::move(value);
+  ++mSize;
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Swap(size_t indexA, size_t indexB) {
+  T temp = std::move(mData[indexA]);
+  mData[indexA] = std::move(mData[indexB]);
+  mData[indexB] = std::move(temp);
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Sort() {
+  auto greaterThan = [](const T& a, const T& b) -> bool {
+    return a > b;
+  };
+  Introsort(mData, mSize, greaterThan);
+}
+
+template<typename T, size_t N>
+template<typename GreaterThan>
+void SmallVector<T, N>::Sort(GreaterThan greaterThan) {
+  Introsort(mData, mSize, greaterThan);
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::RadixSort() {
+  Ds::RadixSort(mData, mSize);
+}
+
+template<typename T, size_t N>
+template<typename GetKey>
+void SmallVector<T, N>::RadixSort(GetKey getKey) {
+  Ds::RadixSort(mData, mSize, getKey);
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Pop() {
+  if (mSize != 0) {
+    mData[mSize - 1].~T();
+    --mSize;
+  }
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Clear() {
+  Util::DestructRange<T>(mData, mSize);
+  mSize = 0;
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Remove(size_t index) {
+  VerifyIndex(index);
+  for (size_t i = index + 1; i < mSize; ++i) {
+    mData[i - 1] = std::move(mData[i]);
+  }
+  mData[mSize - 1].~T();
+  --mSize;
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::LazyRemove(size_t index) {
+  VerifyIndex(index);
+  if (mSize == 1) {
+    Pop();
+    return;
+  }
+  --mSize;
+  mData[index] = std::move(mData[mSize]);
+  mData[mSize].~T();
+}
+
+template<typename T, size_t N>
+template<typename... Args>
+void SmallVector<T, N>::Resize(size_t newSize, Args&&... args) {
+  for (size_t i = newSize; i < mSize; ++i) {
+    mData[i].~T();
+  }
+  if (newSize > mCapacity) {
+    Grow(newSize);
+  }
+  for (size_t i = mSize; i < newSize; ++i) {
+    new (mData + i) T(args...);
+  }
+  mSize = newSize;
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Reserve(size_t newCapacity) {
+  if (mCapacity >= newCapacity) {
+    return;
+  }
+  Grow(newCapacity);
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Shrink() {
+  if (Inline() || mSize == mCapacity) {
+    return;
+  }
+
+  // Elements return to the inline storage when they fit inside of it.
+  if (mSize <= N) {
+    Relocate(InlineData(), N);
+    return;
+  }
+  T* newData = (T*)alloc char[sizeof(T) * mSize];
+  Relocate(newData, mSize);
+}
+
+template<typename T, size_t N>
+template<typename CT>
+VResult<size_t> SmallVector<T, N>::Find(const CT& value) const {
+  for (size_t i = 0; i < mSize; ++i) {
+    if (mData[i] == value) {
+      return i;
+    }
+  }
+  return Result("Value not found");
+}
+
+template<typename T, size_t N>
+template<typename CT>
+bool SmallVector<T, N>::Contains(const CT& value) const {
+  return Find(value).Success();
+}
+
+template<typename T, size_t N>
+size_t SmallVector<T, N>::Size() const {
+  return mSize;
+}
+
+template<typename T, size_t N>
+bool SmallVector<T, N>::Empty() const {
+  return mSize == 0;
+}
+
+template<typename T, size_t N>
+size_t SmallVector<T, N>::Capacity() const {
+  return mCapacity;
+}
+
+template<typename T, size_t N>
+bool SmallVector<T, N>::Inline() const {
+  return (const char*)mData == mInlineData;
+}
+
+template<typename T, size_t N>
+const T* SmallVector<T, N>::CData() const {
+  return mData;
+}
+
+template<typename T, size_t N>
+T* SmallVector<T, N>::Data() {
+  return mData;
+}
+
+template<typename T, size_t N>
+T& SmallVector<T, N>::Top() const {
+  LogAbortIf(mSize == 0, "The SmallVector is empty.");
+  return mData[mSize - 1];
+}
+
+template<typename T, size_t N>
+const T& SmallVector<T, N>::operator[](size_t index) const {
+  VerifyIndex(index);
+  return mData[index];
+}
+
+template<typename T, size_t N>
+T& SmallVector<T, N>::operator[](size_t index) {
+  VerifyIndex(index);
+  return mData[index];
+}
+
+template<typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(
+  const SmallVector<T, N>& other) {
+  if (this == &other) {
+    return *this;
+  }
+  if (mSize >= other.mSize) {
+    Util::CopyAssignRange<T>(other.mData, mData, other.mSize);
+    Util::DestructRange<T>(mData + other.mSize, mSize - other.mSize);
+    mSize = other.mSize;
+    return *this;
+  }
+  Reserve(other.mSize);
+  Util::CopyAssignRange<T>(other.mData, mData, mSize);
+  T* from = other.mData + mSize;
+  T* to = mData + mSize;
+  Util::CopyConstructRange<T>(from, to, other.mSize - mSize);
+  mSize = other.mSize;
+  return *this;
+}
+
+template<typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(SmallVector<T, N>&& other) {
+  if (this == &other) {
+    return *this;
+  }
+  Clear();
+
+  // Heap allocations are taken from the other vector, but inline elements must
+  // be moved individually.
+  if (!other.Inline()) {
+    if (!Inline()) {
+      delete[] (char*)mData;
+    }
+    mData = other.mData;
+    mCapacity = other.mCapacity;
+    mSize = other.mSize;
+    other.mData = other.InlineData();
+    other.mCapacity = N;
+    other.mSize = 0;
+    return *this;
+  }
+  Util::MoveConstructRange<T>(other.mData, mData, other.mSize);
+  mSize = other.mSize;
+  other.Clear();
+  return *this;
+}
+
+template<typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(
+  const std::initializer_list<T>& list) {
+  Clear();
+  Reserve(list.size());
+  for (const T& element: list) {
+    Push(element);
+  }
+  return *this;
+}
+
+template<typename T, size_t N>
+T* SmallVector<T, N>::begin() {
+  return mData;
+}
+
+template<typename T, size_t N>
+T* SmallVector<T, N>::end() {
+  return mData + mSize;
+}
+
+template<typename T, size_t N>
+const T* SmallVector<T, N>::begin() const {
+  return mData;
+}
+
+template<typename T, size_t N>
+const T* SmallVector<T, N>::end() const {
+  return mData + mSize;
+}
+
+template<typename T, size_t N>
+T* SmallVector<T, N>::InlineData() {
+  return (T*)mInlineData;
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::VerifyIndex(size_t index) const {
+  if (index >= mSize) {
+    std::stringstream error;
+    error << index << " is not a valid index.";
+    LogAbort(error.str().c_str());
+  }
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::CreateGap(size_t index) {
+  VerifyIndex(index);
+  if (mSize >= mCapacity) {
+    Grow();
+  }
+  new (mData + mSize) T(std::move(*(mData + mSize - 1)));
+  for (size_t i = mSize - 1; i > index; --i) {
+    mData[i] = std::move(mData[i - 1]);
+  }
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Grow() {
+  size_t newCapacity = (size_t)((float)mCapacity * smGrowthFactor);
+  if (newCapacity <= mCapacity) {
+    newCapacity = mCapacity + 1;
+  }
+  Grow(newCapacity);
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Grow(size_t newCapacity) {
+  LogAbortIf(
+    newCapacity <= mCapacity,
+    "The new capacity must be greater than the current capacity.");
+  T* newData = (T*)alloc char[sizeof(T) * newCapacity];
+  Relocate(newData, newCapacity);
+}
+
+template<typename T, size_t N>
+void SmallVector<T, N>::Relocate(T* newData, size_t newCapacity) {
+  Util::MoveConstructRange<T>(mData, newData, mSize);
+  Util::DestructRange<T>(mData, mSize);
+  if (!Inline()) {
+    delete[] (char*)mData;
+  }
+  mData = newData;
+  mCapacity = newCapacity;
+}
+
+} // namespace Ds
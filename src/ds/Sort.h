@@ -0,0 +1,67 @@
+#ifndef ds_Sort_h
+#define ds_Sort_h
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace Ds {
+
+// All comparison sorts take a greaterThan(a, b) that returns true when a should
+// come after b. It is a template parameter rather than a function pointer so
+// the comparison can be inlined.
+
+// An introsort. Ranges are partitioned around a median of three pivot, small
+// ranges are finished with an insertion sort, and ranges that partition poorly
+// fall back to a heapsort. The worst case is O(n log n) and the recursion depth
+// is logarithmic in the size of the range.
+template<typename T, typename GreaterThan>
+void Introsort(T* data, size_t size, GreaterThan greaterThan);
+template<typename T, typename GreaterThan>
+void InsertionSort(T* data, size_t size, GreaterThan greaterThan);
+template<typename T, typename GreaterThan>
+void Heapsort(T* data, size_t size, GreaterThan greaterThan);
+
+// A stable least significant digit radix sort. It handles integer and floating
+// point keys one byte at a time and skips the bytes that are the same for every
+// key. The first version sorts arithmetic elements by value and the second
+// sorts elements by the arithmetic key that getKey(const T&) returns.
+template<typename T>
+void RadixSort(T* data, size_t size);
+template<typename T, typename GetKey>
+void RadixSort(T* data, size_t size, GetKey getKey);
+
+template<size_t Bytes>
+struct RadixUnsigned {};
+template<>
+struct RadixUnsigned<1> {
+  typedef uint8_t Type;
+};
+template<>
+struct RadixUnsigned<2> {
+  typedef uint16_t Type;
+};
+template<>
+struct RadixUnsigned<4> {
+  typedef uint32_t Type;
+};
+template<>
+struct RadixUnsigned<8> {
+  typedef uint64_t Type;
+};
+// Maps an arithmetic key to an unsigned integer with the same ordering.
+template<typename K>
+typename RadixUnsigned<sizeof(K)>::Type RadixKey(K key);
+
+template<typename T, typename GreaterThan>
+void IntrosortRange(
+  T* data, size_t size, int depthLimit, GreaterThan greaterThan);
+template<typename T, typename GreaterThan>
+size_t IntrosortPartition(T* data, size_t size, GreaterThan greaterThan);
+template<typename T, typename GreaterThan>
+void SiftDown(T* data, size_t root, size_t size, GreaterThan greaterThan);
+
+} // namespace Ds
+
+#include "Sort.hh"
+
+#endif
@@ -0,0 +1,214 @@
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "debug/MemLeak.h"
+#include "util/Memory.h"
+
+namespace Ds {
+
+template<typename T, typename GreaterThan>
+void Introsort(T* data, size_t size, GreaterThan greaterThan) {
+  int depthLimit = 0;
+  for (size_t i = size; i > 1; i >>= 1) {
+    depthLimit += 2;
+  }
+  IntrosortRange(data, size, depthLimit, greaterThan);
+}
+
+template<typename T, typename GreaterThan>
+void InsertionSort(T* data, size_t size, GreaterThan greaterThan) {
+  for (size_t i = 1; i < size; ++i) {
+    if (!greaterThan(data[i - 1], data[i])) {
+      continue;
+    }
+    T value = std::move(data[i]);
+    size_t j = i;
+    do {
+      data[j] = std::move(data[j - 1]);
+      --j;
+    } while (j > 0 && greaterThan(data[j - 1], value));
+    data[j] = std::move(value);
+  }
+}
+
+template<typename T, typename GreaterThan>
+void Heapsort(T* data, size_t size, GreaterThan greaterThan) {
+  if (size < 2) {
+    return;
+  }
+  for (size_t i = size / 2; i > 0; --i) {
+    SiftDown(data, i - 1, size, greaterThan);
+  }
+  for (size_t end = size - 1; end > 0; --end) {
+    Util::Swap(data, 0, end);
+    SiftDown(data, 0, end, greaterThan);
+  }
+}
+
+template<typename T>
+void RadixSort(T* data, size_t size) {
+  RadixSort(data, size, [](const T& value) -> const T& {
+    return value;
+  });
+}
+
+template<typename T, typename GetKey>
+void RadixSort(T* data, size_t size, GetKey getKey) {
+  typedef decltype(RadixKey(getKey(*data))) Key;
+  constexpr size_t passCount = sizeof(Key);
+  if (size < 2) {
+    return;
+  }
+
+  // The counts for every byte are gathered with a single pass over the keys.
+  size_t counts[passCount][256] = {};
+  for (size_t i = 0; i < size; ++i) {
+    Key key = RadixKey(getKey(data[i]));
+    for (size_t pass = 0; pass < passCount; ++pass) {
+      ++counts[pass][(key >> (pass * 8)) & 0xff];
+    }
+  }
+
+  T* scratch = (T*)alloc char[sizeof(T) * size];
+  T* from = data;
+  T* to = scratch;
+  for (size_t pass = 0; pass < passCount; ++pass) {
+    size_t* count = counts[pass];
+    size_t shift = pass * 8;
+    Key firstKey = RadixKey(getKey(from[0]));
+    if (count[(firstKey >> shift) & 0xff] == size) {
+      continue;
+    }
+
+    // Turn the counts into the starting index of each byte's bucket and move
+    // every element into its bucket while keeping their relative order.
+    size_t offset = 0;
+    for (size_t byte = 0; byte < 256; ++byte) {
+      size_t byteCount = count[byte];
+      count[byte] = offset;
+      offset += byteCount;
+    }
+    for (size_t i = 0; i < size; ++i) {
+      size_t byte = (RadixKey(getKey(from[i])) >> shift) & 0xff;
+      new (to + count[byte]) T(std::move(from[i]));
+      from[i].~T();
+      ++count[byte];
+    }
+    std::swap(from, to);
+  }
+  if (from != data) {
+    Util::MoveConstructRange<T>(from, data, size);
+    Util::DestructRange<T>(from, size);
+  }
+  delete[] (char*)scratch;
+}
+
+template<typename K>
+typename RadixUnsigned<sizeof(K)>::Type RadixKey(K key) {
+  static_assert(std::is_arithmetic_v<K>, "Radix keys must be arithmetic.");
+  typedef typename RadixUnsigned<sizeof(K)>::Type Unsigned;
+  constexpr Unsigned signBit = (Unsigned)1 << (sizeof(K) * 8 - 1);
+  Unsigned bits;
+  std::memcpy(&bits, &key, sizeof(K));
+  if constexpr (std::is_floating_point_v<K>) {
+    // Negative floats are ordered by decreasing magnitude, so every bit is
+    // flipped for those. Positive floats only need to be placed above them.
+    if (bits & signBit) {
+      return (Unsigned)~bits;
+    }
+    return (Unsigned)(bits | signBit);
+  } else if constexpr (std::is_signed_v<K>) {
+    return (Unsigned)(bits ^ signBit);
+  } else {
+    return bits;
+  }
+}
+
+template<typename T, typename GreaterThan>
+void IntrosortRange(
+  T* data, size_t size, int depthLimit, GreaterThan greaterThan) {
+  constexpr size_t insertionSortSize = 16;
+  while (size > insertionSortSize) {
+    if (depthLimit == 0) {
+      Heapsort(data, size, greaterThan);
+      return;
+    }
+    --depthLimit;
+
+    // Recursing into the smaller side and looping on the larger side keeps the
+    // stack depth logarithmic.
+    size_t pivot = IntrosortPartition(data, size, greaterThan);
+    size_t leftSize = pivot;
+    size_t rightSize = size - pivot - 1;
+    if (leftSize < rightSize) {
+      IntrosortRange(data, leftSize, depthLimit, greaterThan);
+      data += pivot + 1;
+      size = rightSize;
+    } else {
+      IntrosortRange(data + pivot + 1, rightSize, depthLimit, greaterThan);
+      size = leftSize;
+    }
+  }
+  InsertionSort(data, size, greaterThan);
+}
+
+template<typename T, typename GreaterThan>
+size_t IntrosortPartition(T* data, size_t size, GreaterThan greaterThan) {
+  // Order the first, center, and last elements and use the median as the
+  // pivot. The last element then stops the forward scan before the end.
+  size_t center = size / 2;
+  size_t last = size - 1;
+  if (greaterThan(data[0], data[center])) {
+    Util::Swap(data, 0, center);
+  }
+  if (greaterThan(data[center], data[last])) {
+    Util::Swap(data, center, last);
+  }
+  if (greaterThan(data[0], data[center])) {
+    Util::Swap(data, 0, center);
+  }
+  Util::Swap(data, 0, center);
+
+  // A Hoare partition. Both scans stop on elements equal to the pivot so
+  // ranges with many duplicates are still split evenly.
+  const T& pivot = data[0];
+  size_t i = 1;
+  size_t j = last;
+  while (true) {
+    while (greaterThan(pivot, data[i])) {
+      ++i;
+    }
+    while (greaterThan(data[j], pivot)) {
+      --j;
+    }
+    if (i >= j) {
+      break;
+    }
+    Util::Swap(data, i, j);
+    ++i;
+    --j;
+  }
+  Util::Swap(data, 0, j);
+  return j;
+}
+
+template<typename T, typename GreaterThan>
+void SiftDown(T* data, size_t root, size_t size, GreaterThan greaterThan) {
+  T value = std::move(data[root]);
+  size_t child = 2 * root + 1;
+  while (child < size) {
+    if (child + 1 < size && greaterThan(data[child + 1], data[child])) {
+      ++child;
+    }
+    if (!greaterThan(data[child], value)) {
+      break;
+    }
+    data[root] = std::move(data[child]);
+    root = child;
+    child = 2 * root + 1;
+  }
+  data[root] = std::move(value);
+}
+
+} // namespace Ds
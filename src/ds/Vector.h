@@ -4,15 +4,18 @@
 #include <cstdlib>
 
 #include "Result.h"
+#include "ds/Allocator.h"
+#include "ds/Sort.h"
 
 namespace Ds {
 
-template<typename T>
+// The allocator A provides the memory for the elements. See ds/Allocator.h.
+template<typename T, typename A = HeapAllocator>
 struct Vector {
 public:
   Vector();
-  Vector(const Vector<T>& other);
-  Vector(Vector<T>&& other);
+  Vector(const Vector<T, A>& other);
+  Vector(Vector<T, A>&& other);
   Vector(const std::initializer_list<T>& other);
   ~Vector();
   void Push(const T& value);
@@ -24,7 +27,11 @@ public:
   void Insert(size_t index, T&& value);
   void Swap(size_t indexA, size_t indexB);
   void Sort();
-  void Sort(bool (*greaterThan)(const T&, const T&));
+  template<typename GreaterThan>
+  void Sort(GreaterThan greaterThan);
+  void RadixSort();
+  template<typename GetKey>
+  void RadixSort(GetKey getKey);
   void Pop();
   void Clear();
   void Remove(size_t index);
@@ -47,9 +54,9 @@ public:
 
   const T& operator[](size_t index) const;
   T& operator[](size_t index);
-  Vector<T>& operator=(const Vector<T>& other);
-  Vector<T>& operator=(Vector<T>&& other);
-  Vector<T>& operator=(const std::initializer_list<T>& other);
+  Vector<T, A>& operator=(const Vector<T, A>& other);
+  Vector<T, A>& operator=(Vector<T, A>&& other);
+  Vector<T, A>& operator=(const std::initializer_list<T>& other);
 
   T* begin();
   T* end();
@@ -65,9 +72,6 @@ private:
   size_t mCapacity;
 
 private:
-  void Quicksort(int start, int end, bool (*greaterThan)(const T&, const T&));
-  int Partition(int start, int end, bool (*greaterThan)(const T&, const T&));
-
   void VerifyIndex(size_t index) const;
   void CreateGap(size_t index);
   void Grow();
@@ -7,16 +7,16 @@
 
 namespace Ds {
 
-template<typename T>
-const size_t Vector<T>::smStartCapacity = 10;
-template<typename T>
-const float Vector<T>::smGrowthFactor = 2.0f;
+template<typename T, typename A>
+const size_t Vector<T, A>::smStartCapacity = 10;
+template<typename T, typename A>
+const float Vector<T, A>::smGrowthFactor = 2.0f;
 
-template<typename T>
-Vector<T>::Vector(): mData(nullptr), mSize(0), mCapacity(0) {}
+template<typename T, typename A>
+Vector<T, A>::Vector(): mData(nullptr), mSize(0), mCapacity(0) {}
 
-template<typename T>
-Vector<T>::Vector(const Vector<T>& other):
+template<typename T, typename A>
+Vector<T, A>::Vector(const Vector<T, A>& other):
   mSize(other.mSize), mCapacity(other.mSize) {
   if (other.mData == nullptr) {
     mData = nullptr;
@@ -26,29 +26,29 @@ Vector<T>::Vector(const Vector<T>& other):
   Util::CopyConstructRange<T>(other.mData, mData, other.mSize);
 }
 
-template<typename T>
-Vector<T>::Vector(Vector<T>&& other):
+template<typename T, typename A>
+Vector<T, A>::Vector(Vector<T, A>&& other):
   mData(other.mData), mSize(other.mSize), mCapacity(other.mCapacity) {
   other.mData = nullptr;
   other.mSize = 0;
   other.mCapacity = 0;
 }
 
-template<typename T>
-Vector<T>::Vector(const std::initializer_list<T>& list): Vector() {
+template<typename T, typename A>
+Vector<T, A>::Vector(const std::initializer_list<T>& list): Vector() {
   *this = list;
 }
 
-template<typename T>
-Vector<T>::~Vector() {
+template<typename T, typename A>
+Vector<T, A>::~Vector() {
   Clear();
   if (mData != nullptr) {
     DeleteAllocation(mData);
   }
 }
 
-template<typename T>
-void Vector<T>::Push(const T& value) {
+template<typename T, typename A>
+void Vector<T, A>::Push(const T& value) {
   if (mSize >= mCapacity) {
     Grow();
   }
@@ -56,8 +56,8 @@ void Vector<T>::Push(const T& value) {
   ++mSize;
 }
 
-template<typename T>
-void Vector<T>::Push(T&& value) {
+template<typename T, typename A>
+void Vector<T, A>::Push(T&& value) {
   if (mSize >= mCapacity) {
     Grow();
   }
@@ -65,8 +65,8 @@ void Vector<T>::Push(T&& value) {
   ++mSize;
 }
 
-template<typename T>
-void Vector<T>::Push(const T& value, size_t count) {
+template<typename T, typename A>
+void Vector<T, A>::Push(const T& value, size_t count) {
   size_t newSize = mSize + count;
   size_t newCapacity = mCapacity;
   if (newCapacity == 0) {
@@ -82,9 +82,9 @@ void Vector<T>::Push(const T& value, size_t count) {
   mSize = newSize;
 }
 
-template<typename T>
+template<typename T, typename A>
 template<typename... Args>
-void Vector<T>::Emplace(Args&&... args) {
+void Vector<T, A>::Emplace(Args&&... args) {
   if (mSize >= mCapacity) {
     Grow();
   }
@@ -92,8 +92,8 @@ void Vector<T>::Emplace(Args&&... args) {
   ++mSize;
 }
 
-template<typename T>
-void Vector<T>::Insert(size_t index, const T& value) {
+template<typename T, typename A>
+void Vector<T, A>::Insert(size_t index, const T& value) {
   if (index == mSize) {
     Push(value);
     return;
@@ -103,8 +103,8 @@ void Vector<T>::Insert(size_t index, const T& value) {
   ++mSize;
 }
 
-template<typename T>
-void Vector<T>::Insert(size_t index, T&& value) {
+template<typename T, typename A>
+void Vector<T, A>::Insert(size_t index, T&& value) {
   if (index == mSize) {
     Push(std::move(value));
     return;
@@ -114,78 +114,54 @@ void Vector<T>::Insert(size_t index, T&& value) {
   ++mSize;
 }
 
-template<typename T>
-void Vector<T>::Swap(size_t indexA, size_t indexB) {
+template<typename T, typename A>
+void Vector<T, A>::Swap(size_t indexA, size_t indexB) {
   T temp = std::move(mData[indexA]);
   mData[indexA] = std::move(mData[indexB]);
   mData[indexB] = std::move(temp);
 }
 
-template<typename T>
-void Vector<T>::Pop() {
+template<typename T, typename A>
+void Vector<T, A>::Pop() {
   if (mSize != 0) {
     mData[mSize - 1].~T();
     --mSize;
   }
 }
 
-template<typename T>
-void Vector<T>::Sort() {
+template<typename T, typename A>
+void Vector<T, A>::Sort() {
   auto greaterThan = [](const T& a, const T& b) -> bool {
     return a > b;
   };
-  Quicksort(0, mSize - 1, greaterThan);
+  Introsort(mData, mSize, greaterThan);
 }
 
-template<typename T>
-void Vector<T>::Sort(bool (*greaterThan)(const T&, const T&)) {
-  Quicksort(0, (int)mSize - 1, greaterThan);
+template<typename T, typename A>
+template<typename GreaterThan>
+void Vector<T, A>::Sort(GreaterThan greaterThan) {
+  Introsort(mData, mSize, greaterThan);
 }
 
-template<typename T>
-void Vector<T>::Quicksort(
-  int start, int end, bool (*greaterThan)(const T&, const T&)) {
-  if (end <= start) {
-    return;
-  }
-  int pivot = Partition(start, end, greaterThan);
-  Quicksort(start, pivot - 1, greaterThan);
-  Quicksort(pivot + 1, end, greaterThan);
-}
-
-template<typename T>
-int Vector<T>::Partition(
-  int start, int end, bool (*greaterThan)(const T&, const T&)) {
-  // A Hoare partition that uses the center element as the pivot.
-  Swap(start, start + (end - start) / 2);
-  const T& pivot = mData[start];
-  int i = start + 1;
-  int j = end;
-  while (true) {
-    while (greaterThan(mData[j], pivot)) {
-      --j;
-    }
-    while (i <= end && greaterThan(pivot, mData[i])) {
-      ++i;
-    }
-    if (j < i) {
-      Swap(start, j);
-      return j;
-    }
-    Swap(i, j);
-    --j;
-    ++i;
-  }
+template<typename T, typename A>
+void Vector<T, A>::RadixSort() {
+  Ds::RadixSort(mData, mSize);
+}
+
+template<typename T, typename A>
+template<typename GetKey>
+void Vector<T, A>::RadixSort(GetKey getKey) {
+  Ds::RadixSort(mData, mSize, getKey);
 }
 
-template<typename T>
-void Vector<T>::Clear() {
+template<typename T, typename A>
+void Vector<T, A>::Clear() {
   Util::DestructRange<T>(mData, mSize);
   mSize = 0;
 }
 
-template<typename T>
-void Vector<T>::Remove(size_t index) {
+template<typename T, typename A>
+void Vector<T, A>::Remove(size_t index) {
   VerifyIndex(index);
   for (size_t i = index + 1; i < mSize; ++i) {
     mData[i - 1] = std::move(mData[i]);
@@ -194,8 +170,8 @@ void Vector<T>::Remove(size_t index) {
   --mSize;
 }
 
-template<typename T>
-void Vector<T>::LazyRemove(size_t index) {
+template<typename T, typename A>
+void Vector<T, A>::LazyRemove(size_t index) {
   VerifyIndex(index);
   if (mSize == 1) {
     Pop();
@@ -206,9 +182,9 @@ void Vector<T>::LazyRemove(size_t index) {
   mData[mSize].~T();
 }
 
-template<typename T>
+template<typename T, typename A>
 template<typename... Args>
-void Vector<T>::Resize(size_t newSize, Args&&... args) {
+void Vector<T, A>::Resize(size_t newSize, Args&&... args) {
   for (size_t i = newSize; i < mSize; ++i) {
     mData[i].~T();
   }
@@ -221,16 +197,16 @@ void Vector<T>::Resize(size_t newSize, Args&&... args) {
   mSize = newSize;
 }
 
-template<typename T>
-void Vector<T>::Reserve(size_t newCapacity) {
+template<typename T, typename A>
+void Vector<T, A>::Reserve(size_t newCapacity) {
   if (mCapacity >= newCapacity) {
     return;
   }
   Grow(newCapacity);
 }
 
-template<typename T>
-void Vector<T>::Shrink() {
+template<typename T, typename A>
+void Vector<T, A>::Shrink() {
   if (mSize == mCapacity) {
     return;
   }
@@ -243,9 +219,9 @@ void Vector<T>::Shrink() {
   mCapacity = mSize;
 }
 
-template<typename T>
+template<typename T, typename A>
 template<typename CT>
-VResult<size_t> Vector<T>::Find(const CT& value) const {
+VResult<size_t> Vector<T, A>::Find(const CT& value) const {
   for (size_t i = 0; i < mSize; ++i) {
     if (mData[i] == value) {
       return i;
@@ -254,57 +230,57 @@ VResult<size_t> Vector<T>::Find(const CT& value) const {
   return Result("Value not found");
 }
 
-template<typename T>
+template<typename T, typename A>
 template<typename CT>
-bool Vector<T>::Contains(const CT& value) const {
+bool Vector<T, A>::Contains(const CT& value) const {
   return Find(value).Success();
 }
 
-template<typename T>
-size_t Vector<T>::Size() const {
+template<typename T, typename A>
+size_t Vector<T, A>::Size() const {
   return mSize;
 }
 
-template<typename T>
-bool Vector<T>::Empty() const {
+template<typename T, typename A>
+bool Vector<T, A>::Empty() const {
   return mSize == 0;
 }
 
-template<typename T>
-size_t Vector<T>::Capacity() const {
+template<typename T, typename A>
+size_t Vector<T, A>::Capacity() const {
   return mCapacity;
 }
 
-template<typename T>
-const T* Vector<T>::CData() const {
+template<typename T, typename A>
+const T* Vector<T, A>::CData() const {
   return mData;
 }
 
-template<typename T>
-T* Vector<T>::Data() {
+template<typename T, typename A>
+T* Vector<T, A>::Data() {
   return mData;
 }
 
-template<typename T>
-T& Vector<T>::Top() const {
+template<typename T, typename A>
+T& Vector<T, A>::Top() const {
   LogAbortIf(mSize == 0, "The Vector is empty.");
   return mData[mSize - 1];
 }
 
-template<typename T>
-const T& Vector<T>::operator[](size_t index) const {
+template<typename T, typename A>
+const T& Vector<T, A>::operator[](size_t index) const {
   VerifyIndex(index);
   return mData[index];
 }
 
-template<typename T>
-T& Vector<T>::operator[](size_t index) {
+template<typename T, typename A>
+T& Vector<T, A>::operator[](size_t index) {
   VerifyIndex(index);
   return mData[index];
 }
 
-template<typename T>
-Vector<T>& Vector<T>::operator=(const Vector<T>& other) {
+template<typename T, typename A>
+Vector<T, A>& Vector<T, A>::operator=(const Vector<T, A>& other) {
   // Handle cases where this vector's size is larger than or equal to the
   // other's.
   if (mSize == other.mSize) {
@@ -343,8 +319,8 @@ Vector<T>& Vector<T>::operator=(const Vector<T>& other) {
   return *this;
 }
 
-template<typename T>
-Vector<T>& Vector<T>::operator=(Vector<T>&& other) {
+template<typename T, typename A>
+Vector<T, A>& Vector<T, A>::operator=(Vector<T, A>&& other) {
   Clear();
   if (mData != nullptr) {
     DeleteAllocation(mData);
@@ -359,8 +335,8 @@ Vector<T>& Vector<T>::operator=(Vector<T>&& other) {
   return *this;
 }
 
-template<typename T>
-Vector<T>& Vector<T>::operator=(const std::initializer_list<T>& list) {
+template<typename T, typename A>
+Vector<T, A>& Vector<T, A>::operator=(const std::initializer_list<T>& list) {
   Clear();
   for (const T& element: list) {
     Push(element);
@@ -368,28 +344,28 @@ Vector<T>& Vector<T>::operator=(const std::initializer_list<T>& list) {
   return *this;
 }
 
-template<typename T>
-T* Vector<T>::begin() {
+template<typename T, typename A>
+T* Vector<T, A>::begin() {
   return mData;
 }
 
-template<typename T>
-T* Vector<T>::end() {
+template<typename T, typename A>
+T* Vector<T, A>::end() {
   return mData + mSize;
 }
 
-template<typename T>
-const T* Vector<T>::begin() const {
+template<typename T, typename A>
+const T* Vector<T, A>::begin() const {
   return mData;
 }
 
-template<typename T>
-const T* Vector<T>::end() const {
+template<typename T, typename A>
+const T* Vector<T, A>::end() const {
   return mData + mSize;
 }
 
-template<typename T>
-void Vector<T>::VerifyIndex(size_t index) const {
+template<typename T, typename A>
+void Vector<T, A>::VerifyIndex(size_t index) const {
   if (index < 0 || index >= mSize) {
     std::stringstream error;
     error << index << " is not a valid index.";
@@ -397,8 +373,8 @@ void Vector<T>::VerifyIndex(size_t index) const {
   }
 }
 
-template<typename T>
-void Vector<T>::CreateGap(size_t index) {
+template<typename T, typename A>
+void Vector<T, A>::CreateGap(size_t index) {
   VerifyIndex(index);
   if (mSize >= mCapacity) {
     Grow();
@@ -409,8 +385,8 @@ void Vector<T>::CreateGap(size_t index) {
   }
 }
 
-template<typename T>
-void Vector<T>::Grow() {
+template<typename T, typename A>
+void Vector<T, A>::Grow() {
   if (mData == nullptr) {
     mCapacity = smStartCapacity;
     mData = CreateAllocation(mCapacity);
@@ -421,8 +397,8 @@ void Vector<T>::Grow() {
   }
 }
 
-template<typename T>
-void Vector<T>::Grow(size_t newCapacity) {
+template<typename T, typename A>
+void Vector<T, A>::Grow(size_t newCapacity) {
   LogAbortIf(
     newCapacity <= mCapacity,
     "The new capacity must be greater than the current capacity.");
@@ -435,17 +411,14 @@ void Vector<T>::Grow(size_t newCapacity) {
   mCapacity = newCapacity;
 }
 
-template<typename T>
-T* Vector<T>::CreateAllocation(size_t capacity) {
-  size_t byteCount = sizeof(T) * capacity;
-  char* byteAllocation = alloc char[byteCount];
-  return (T*)byteAllocation;
+template<typename T, typename A>
+T* Vector<T, A>::CreateAllocation(size_t capacity) {
+  return (T*)A::Allocate(sizeof(T) * capacity);
 }
 
-template<typename T>
-void Vector<T>::DeleteAllocation(T* allocation) {
-  char* byteAllocation = (char*)allocation;
-  delete[] byteAllocation;
+template<typename T, typename A>
+void Vector<T, A>::DeleteAllocation(T* allocation) {
+  A::Deallocate(allocation);
 }
 
 } // namespace Ds
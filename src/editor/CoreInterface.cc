@@ -10,6 +10,7 @@
 #include "editor/LayerInterface.h"
 #include "editor/LibraryInterface.h"
 #include "editor/LogInterface.h"
+#include "editor/MemoryInterface.h"
 #include "editor/TempInterface.h"
 #include "editor/Utility.h"
 #include "rsl/Library.h"
@@ -141,6 +142,7 @@ void CoreInterface::ViewMenu() {
   if (ImGui::BeginMenu("View")) {
     InterfaceMenuItem<LogInterface>("Log");
     InterfaceMenuItem<FramerInterface>("Framer");
+    InterfaceMenuItem<MemoryInterface>("Memory");
     InterfaceMenuItem<LibraryInterface>("Library");
     InterfaceMenuItem<CameraInterface>("Camera");
     InterfaceMenuItem<TempInterface>("Temp");
@@ -5,6 +5,7 @@
 #include "Input.h"
 #include "Options.h"
 #include "Viewport.h"
+#include "debug/MemTrack.h"
 #include "editor/Camera.h"
 #include "editor/CoreInterface.h"
 #include "editor/LayerInterface.h"
@@ -153,6 +154,7 @@ void Purge() {
 }
 
 void StartFrame() {
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::Editor);
   Gizmos::Update();
   nCamera.Update();
   StartImGuiFrame();
@@ -188,6 +190,7 @@ void TrySaveLayer() {
 }
 
 void EndFrame() {
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::Editor);
   if (Options::nConfig.mEditorLevel == Options::EditorLevel::Complete) {
     TrySaveLayer();
     nCoreInterface.HandleStaging();
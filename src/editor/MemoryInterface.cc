@@ -0,0 +1,87 @@
+#include <imgui/imgui.h>
+
+#include "debug/MemTrack.h"
+#include "editor/MemoryInterface.h"
+#include "rsl/Library.h"
+
+namespace Editor {
+
+void ShowStats(const char* name, const Debug::MemTrack::Stats& stats) {
+  auto kilobytes = [](size_t bytes) -> float {
+    return (float)bytes / 1024.0f;
+  };
+  ImGui::TableNextRow();
+  ImGui::TableNextColumn();
+  ImGui::Text("%s", name);
+  ImGui::TableNextColumn();
+  ImGui::Text("%.1f", kilobytes(stats.mLiveBytes));
+  ImGui::TableNextColumn();
+  ImGui::Text("%.1f", kilobytes(stats.mPeakBytes));
+  ImGui::TableNextColumn();
+  ImGui::Text("%zu", stats.mLiveAllocations);
+  ImGui::TableNextColumn();
+  ImGui::Text("%.0f", stats.mAllocationsPerSecond);
+  ImGui::TableNextColumn();
+  ImGui::Text("%.1f", stats.mBytesPerSecond / 1024.0f);
+}
+
+void MemoryInterface::Show() {
+  ImGui::Begin("Memory", &mOpen, ImGuiWindowFlags_AlwaysAutoResize);
+
+  // Display the statistics for every tag and the totals.
+  ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+  if (ImGui::BeginTable("Tags", 6, flags)) {
+    ImGui::TableSetupColumn("Tag");
+    ImGui::TableSetupColumn("Live KiB");
+    ImGui::TableSetupColumn("Peak KiB");
+    ImGui::TableSetupColumn("Allocations");
+    ImGui::TableSetupColumn("Allocations/s");
+    ImGui::TableSetupColumn("KiB/s");
+    ImGui::TableHeadersRow();
+    for (int i = 0; i < (int)Debug::MemTrack::Tag::Count; ++i) {
+      auto tag = (Debug::MemTrack::Tag)i;
+      const char* name = Debug::MemTrack::GetTagName(tag);
+      ShowStats(name, Debug::MemTrack::GetStats(tag));
+    }
+    ShowStats("Total", Debug::MemTrack::GetTotalStats());
+    ImGui::EndTable();
+  }
+  ImGui::SliderFloat("Rate Period", &Debug::MemTrack::nRatePeriod, 0.1f, 5.0f);
+
+  // Display the asset budgets and the assets that were evicted to meet them.
+  if (ImGui::CollapsingHeader("Asset Evictions")) {
+    ImGui::Text(
+      "CPU Budget: %.1f MiB, GPU Budget: %.1f MiB",
+      (float)Rsl::nCpuByteBudget / (float)(1 << 20),
+      (float)Rsl::nGpuByteBudget / (float)(1 << 20));
+    const Ds::Vector<Rsl::Eviction>& evictions = Rsl::GetEvictions();
+    if (evictions.Empty()) {
+      ImGui::TextDisabled("No evictions");
+    }
+    else if (ImGui::BeginTable("Evictions", 5, flags)) {
+      ImGui::TableSetupColumn("Asset");
+      ImGui::TableSetupColumn("CPU KiB");
+      ImGui::TableSetupColumn("GPU KiB");
+      ImGui::TableSetupColumn("Idle Frames");
+      ImGui::TableSetupColumn("Reason");
+      ImGui::TableHeadersRow();
+      for (const Rsl::Eviction& eviction: evictions) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Text("%s", eviction.mAssetName.c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", (float)eviction.mCpuBytes / 1024.0f);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", (float)eviction.mGpuBytes / 1024.0f);
+        ImGui::TableNextColumn();
+        ImGui::Text("%u", eviction.mIdleFrames);
+        ImGui::TableNextColumn();
+        ImGui::Text("%s", eviction.mReason.c_str());
+      }
+      ImGui::EndTable();
+    }
+  }
+  ImGui::End();
+}
+
+} // namespace Editor
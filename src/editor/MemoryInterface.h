@@ -0,0 +1,14 @@
+#ifndef editor_MemoryInterface_h
+#define editor_MemoryInterface_h
+
+#include "editor/Interface.h"
+
+namespace Editor {
+
+struct MemoryInterface: public Interface {
+  void Show();
+};
+
+} // namespace Editor
+
+#endif
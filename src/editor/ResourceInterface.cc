@@ -92,6 +92,7 @@ void ResourceInterface::Show() {
   case ResTypeId::Shader: Gfx::Shader::EditConfig(&configVal); break;
   default: break;
   }
+  ShowLoadStats();
   ImGui::End();
 
   // Write the asset if the Value changed.
@@ -100,4 +101,56 @@ void ResourceInterface::Show() {
   }
 }
 
+void ResourceInterface::ShowLoadStats() {
+  if (!ImGui::CollapsingHeader("Load Stats")) {
+    return;
+  }
+  // Stats are only shown once the asset is no longer being initialized.
+  const Rsl::Asset* asset = Rsl::TryGetAsset(mResId.GetAssetName());
+  if (asset == nullptr || asset->GetStatus() == Rsl::Asset::Status::Queued ||
+      asset->GetStatus() == Rsl::Asset::Status::Initializing) {
+    ImGui::TextDisabled("No stats");
+    return;
+  }
+  const Rsl::LoadStats& loadStats = asset->GetLoadStats();
+  const Rsl::LoadStats::Timings* resTimings = nullptr;
+  for (const Rsl::LoadStats::ResStats& resStats: loadStats.mResStats) {
+    if (resStats.mName == mResId.GetResourceName()) {
+      resTimings = &resStats.mTimings;
+      break;
+    }
+  }
+
+  ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+  if (!ImGui::BeginTable("LoadStats", 3, flags)) {
+    return;
+  }
+  ImGui::TableSetupColumn("Stage");
+  ImGui::TableSetupColumn("Resource ms");
+  ImGui::TableSetupColumn("Asset ms");
+  ImGui::TableHeadersRow();
+  for (int i = 0; i < (int)Rsl::LoadStats::Stage::Count; ++i) {
+    auto stage = (Rsl::LoadStats::Stage)i;
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::Text("%s", Rsl::LoadStats::StageName(stage));
+    ImGui::TableNextColumn();
+    if (resTimings != nullptr) {
+      ImGui::Text("%.3f", resTimings->mSeconds[i] * 1000.0);
+    }
+    ImGui::TableNextColumn();
+    ImGui::Text("%.3f", loadStats.mTotal.mSeconds[i] * 1000.0);
+  }
+  ImGui::TableNextRow();
+  ImGui::TableNextColumn();
+  ImGui::Text("KiB Read");
+  ImGui::TableNextColumn();
+  if (resTimings != nullptr) {
+    ImGui::Text("%.1f", (float)resTimings->mBytesRead / 1024.0f);
+  }
+  ImGui::TableNextColumn();
+  ImGui::Text("%.1f", (float)loadStats.mTotal.mBytesRead / 1024.0f);
+  ImGui::EndTable();
+}
+
 } // namespace Editor
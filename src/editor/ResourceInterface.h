@@ -12,6 +12,7 @@ struct ResourceInterface: public Interface {
   ResourceInterface(const ResId& id);
   ~ResourceInterface();
   void Show();
+  void ShowLoadStats();
 
   ResId mResId;
 };
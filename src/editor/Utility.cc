@@ -53,9 +53,9 @@ void DragResourceId(Rsl::ResourceTypeId resTypeId, const ResId& resId) {
   }
   payloadName += "ResId";
   if (ImGui::BeginDragDropSource()) {
-    ImGui::SetDragDropPayload(
-      payloadName.c_str(), (void*)resId.mId.c_str(), resId.mId.size());
-    ImGui::TextUnformatted(resId.mId.c_str());
+    const std::string& id = resId.GetId();
+    ImGui::SetDragDropPayload(payloadName.c_str(), (void*)id.c_str(), id.size());
+    ImGui::TextUnformatted(id.c_str());
     ImGui::EndDragDropSource();
   }
 }
@@ -74,7 +74,10 @@ void DropResourceIdWidget(
     bufferWidth = CalcBufferWidth(label.c_str());
   }
   ImGui::PushID((void*)resId);
-  InputText(label.c_str(), &resId->mId, -bufferWidth);
+  std::string id = resId->GetId();
+  if (InputText(label.c_str(), &id, -bufferWidth)) {
+    *resId = id;
+  }
   ImGui::PopID();
 
   // Make the text box a target for dropping ResourceIds.
@@ -1,7 +1,9 @@
+#include <cstring>
 #include <imgui/imgui.h>
 #include <stb_image.h>
 #include <utility>
 
+#include "Viewport.h"
 #include "editor/Utility.h"
 #include "gfx/Cubemap.h"
 #include "rsl/Library.h"
@@ -28,7 +30,7 @@ Cubemap::Specification Cubemap::GetSpecification(
   return Specification::Invalid;
 }
 
-Cubemap::Cubemap(): mId(0) {}
+Cubemap::Cubemap(): mId(0), mStaging(nullptr) {}
 
 Cubemap::Cubemap(Cubemap&& other) {
   *this = std::forward<Cubemap>(other);
@@ -36,18 +38,25 @@ Cubemap::Cubemap(Cubemap&& other) {
 
 Cubemap& Cubemap::operator=(Cubemap&& other) {
   mId = other.mId;
+  mStaging = other.mStaging;
   other.mId = 0;
+  other.mStaging = nullptr;
   return *this;
 }
 
 Cubemap::~Cubemap() {
-  glDeleteTextures(1, &mId);
-  mId = 0;
+  if (mStaging != nullptr) {
+    delete mStaging;
+    mStaging = nullptr;
+  }
+  if (mId != 0) {
+    Viewport::SharedContext sharedContext;
+    glDeleteTextures(1, &mId);
+    mId = 0;
+  }
 }
 
-Result Cubemap::Init(const Vlk::Explorer& configEx) {
-  Config config;
-
+Result Cubemap::ReadConfig(const Vlk::Explorer& configEx, Config* config) {
   // Get the filter type.
   Vlk::Explorer filterEx = configEx("Filter");
   if (!filterEx.Valid(Vlk::Value::Type::TrueValue)) {
@@ -59,7 +68,7 @@ Result Cubemap::Init(const Vlk::Explorer& configEx) {
     std::string error = "Filter \"" + filterTypeString + "\" is invalid.";
     return Result(error);
   }
-  config.mGlFilter = smFilterTypeGlValues[(int)filterType];
+  config->mGlFilter = smFilterTypeGlValues[(int)filterType];
 
   // Get the specification type.
   Vlk::Explorer specificationEx = configEx("Specification");
@@ -67,15 +76,15 @@ Result Cubemap::Init(const Vlk::Explorer& configEx) {
     return Result("Missing :Specification: TrueValue");
   }
   std::string specificationString = specificationEx.As<std::string>();
-  if (config.mSpecification == Specification::Invalid) {
+  config->mSpecification = GetSpecification(specificationString);
+  if (config->mSpecification == Specification::Invalid) {
     std::string error =
       "Specification \"" + specificationString + "\" is invalid.";
     return Result(error);
   }
-  config.mSpecification = GetSpecification(specificationString);
 
   // Get the face files depending on specification type.
-  if (config.mSpecification == Specification::Split) {
+  if (config->mSpecification == Specification::Split) {
     for (int i = 0; i < smFileDescriptorCount; ++i) {
       Vlk::Explorer fileEx = configEx(smFileDescriptorStrings[i]);
       if (!fileEx.Valid(Vlk::Value::Type::TrueValue)) {
@@ -84,26 +93,138 @@ Result Cubemap::Init(const Vlk::Explorer& configEx) {
         error += ": TrueValue.";
         return Result(error);
       }
-      config.mFaceFiles[i] = fileEx.As<std::string>();
+      config->mFaceFiles[i] = fileEx.As<std::string>();
     }
   }
-  else if (config.mSpecification == Specification::Single) {
+  else if (config->mSpecification == Specification::Single) {
     Vlk::Explorer fileEx = configEx("File");
     if (!fileEx.Valid(Vlk::Value::Type::TrueValue)) {
       return Result("Missing :File: TrueValue");
     }
-    config.mFaceFiles[0] = fileEx.As<std::string>();
+    config->mFaceFiles[0] = fileEx.As<std::string>();
   }
+  return Result();
+}
 
-  // We have a valid configuration if we reach this point.
-  Init(config);
+int Cubemap::FaceCount(Specification specification) {
+  switch (specification) {
+  case Specification::Split: return smFileDescriptorCount;
+  case Specification::Single: return 1;
+  default: return 0;
+  }
+}
+
+Result Cubemap::Cook(const Vlk::Explorer& configEx, Rsl::CookedRes* cookedRes) {
+  Config config;
+  Result result = ReadConfig(configEx, &config);
+  if (!result.Success()) {
+    return result;
+  }
+  Cubemap cubemap;
+  result = cubemap.Init(config);
+  if (!result.Success()) {
+    return result;
+  }
+  for (int i = 0; i < FaceCount(config.mSpecification); ++i) {
+    VResult<std::string> resolutionResult =
+      Rsl::ResolveResPath(config.mFaceFiles[i]);
+    if (!resolutionResult.Success()) {
+      return Result(resolutionResult.mError);
+    }
+    cookedRes->mSourceFiles.Push(std::move(resolutionResult.mValue));
+  }
+
+  // The faces are written in the order that Init(Rsl::Blob*) reads them.
+  Rsl::Blob& blob = cookedRes->mBlob;
+  const Staging& staging = *cubemap.mStaging;
+  blob.Write(staging.mGlFilter);
+  blob.Write(staging.mFaces.Size());
+  for (const Face& face: staging.mFaces) {
+    blob.Write(face.mWidth);
+    blob.Write(face.mHeight);
+    blob.Write(face.mChannels);
+    blob.Write(face.mData);
+  }
   return Result();
 }
 
+Result Cubemap::Init(const Vlk::Explorer& configEx) {
+  Config config;
+  Result result = ReadConfig(configEx, &config);
+  if (!result.Success()) {
+    return result;
+  }
+  return Init(config);
+}
+
 Result Cubemap::Init(const Config& config) {
-  auto uploadFace = [](GLenum target, GLenum format, const Face& face) {
+  Staging staging;
+  staging.mGlFilter = config.mGlFilter;
+  for (int i = 0; i < FaceCount(config.mSpecification); ++i) {
+    VResult<Face> result = Face::Init(config.mFaceFiles[i]);
+    if (!result.Success()) {
+      return std::move(result);
+    }
+    staging.mFaces.Push(std::move(result.mValue));
+  }
+
+  if (mStaging == nullptr) {
+    mStaging = alloc Staging;
+  }
+  *mStaging = std::move(staging);
+  return Result();
+}
+
+Result Cubemap::Init(Rsl::Blob* blob) {
+  Staging staging;
+  size_t faceCount;
+  bool success = blob->Read(&staging.mGlFilter) && blob->Read(&faceCount) &&
+    (faceCount == 1 || faceCount == smFileDescriptorCount);
+  for (size_t i = 0; success && i < faceCount; ++i) {
+    Face face;
+    success = blob->Read(&face.mWidth) && blob->Read(&face.mHeight) &&
+      blob->Read(&face.mChannels) && blob->Read(&face.mData) &&
+      face.mData.Size() == face.ByteCount();
+    staging.mFaces.Push(std::move(face));
+  }
+  if (!success) {
+    return Result("Cooked cubemap data is malformed.");
+  }
+
+  if (mStaging == nullptr) {
+    mStaging = alloc Staging;
+  }
+  *mStaging = std::move(staging);
+  return Result();
+}
+
+size_t Cubemap::StagedBytes() const {
+  if (mStaging == nullptr) {
+    return 0;
+  }
+  size_t byteCount = 0;
+  for (const Face& face: mStaging->mFaces) {
+    byteCount += face.ByteCount();
+  }
+  if (mStaging->mFaces.Size() == 1) {
+    byteCount *= smFileDescriptorCount;
+  }
+  return byteCount;
+}
+
+void Cubemap::Upload() {
+  if (mStaging == nullptr) {
+    return;
+  }
+  Viewport::SharedContext sharedContext;
+  glGenTextures(1, &mId);
+  glBindTexture(GL_TEXTURE_CUBE_MAP, mId);
+  const Ds::Vector<Face>& faces = mStaging->mFaces;
+  for (int i = 0; i < smFileDescriptorCount && !faces.Empty(); ++i) {
+    const Face& face = faces.Size() == 1 ? faces[0] : faces[i];
+    GLenum format = face.mChannels == 4 ? GL_RGBA : GL_RGB;
     glTexImage2D(
-      target,
+      GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
       0,
       format,
       face.mWidth,
@@ -111,41 +232,16 @@ Result Cubemap::Init(const Config& config) {
       0,
       format,
       GL_UNSIGNED_BYTE,
-      face.mData);
-  };
-
-  glGenTextures(1, &mId);
-  glBindTexture(GL_TEXTURE_CUBE_MAP, mId);
-  if (config.mSpecification == Specification::Split) {
-    for (int i = 0; i < smFileDescriptorCount; ++i) {
-      VResult<Face> result = Face::Init(config.mFaceFiles[i]);
-      if (!result.Success()) {
-        return std::move(result);
-      }
-      const Face& face = result.mValue;
-      GLenum target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + i;
-      GLenum format = face.mChannels == 4 ? GL_RGBA : GL_RGB;
-      uploadFace(target, format, face);
-    }
-  }
-  else if (config.mSpecification == Specification::Single) {
-    VResult<Face> result = Face::Init(config.mFaceFiles[0]);
-    if (!result.Success()) {
-      return std::move(result);
-    }
-    const Face& face = result.mValue;
-    GLenum format = face.mChannels == 4 ? GL_RGBA : GL_RGB;
-    for (int i = 0; i < smFileDescriptorCount; ++i) {
-      GLenum target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + i;
-      uploadFace(target, format, face);
-    }
+      face.mData.CData());
   }
-  glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, config.mGlFilter);
-  glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, config.mGlFilter);
+  GLint glFilter = mStaging->mGlFilter;
+  glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, glFilter);
+  glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, glFilter);
   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-  return Result();
+  delete mStaging;
+  mStaging = nullptr;
 }
 
 void Cubemap::EditConfig(Vlk::Value* configValP) {
@@ -214,30 +310,22 @@ VResult<Cubemap::Face> Cubemap::Face::Init(const std::string& file) {
   // Get the face data.
   Face face;
   stbi_set_flip_vertically_on_load(false);
-  face.mData = stbi_load(
+  unsigned char* data = stbi_load(
     resolvedFile.c_str(), &face.mWidth, &face.mHeight, &face.mChannels, 0);
-  if (face.mData == nullptr) {
+  if (data == nullptr) {
+    Rsl::InvalidateResPath(file);
     std::string error =
       "Loading \"" + file + "\" failed.\n" + stbi_failure_reason();
     return Result(error);
   }
+  face.mData.Resize(face.ByteCount());
+  memcpy((void*)face.mData.Data(), (const void*)data, face.ByteCount());
+  stbi_image_free(data);
   return VResult<Face>(std::move(face));
 }
 
-Cubemap::Face::Face(): mData(nullptr) {}
-
-Cubemap::Face::Face(Face&& other):
-  mData(other.mData),
-  mWidth(other.mWidth),
-  mHeight(other.mHeight),
-  mChannels(other.mChannels) {
-  other.mData = nullptr;
-}
-
-Cubemap::Face::~Face() {
-  if (mData != nullptr) {
-    stbi_image_free(mData);
-  }
+size_t Cubemap::Face::ByteCount() const {
+  return (size_t)mWidth * (size_t)mHeight * (size_t)mChannels;
 }
 
 } // namespace Gfx
@@ -3,6 +3,8 @@
 
 #include <glad/glad.h>
 
+#include "ds/Vector.h"
+#include "rsl/Cook.h"
 #include "vlk/Valkor.h"
 
 namespace Gfx {
@@ -43,29 +45,40 @@ public:
   Cubemap& operator=(Cubemap&& other);
   ~Cubemap();
 
+  // The Inits only stage the decoded faces. Upload must be called before the
+  // texture exists.
+  static Result Cook(const Vlk::Explorer& configEx, Rsl::CookedRes* cookedRes);
   Result Init(const Vlk::Explorer& configEx);
   Result Init(const Config& config);
+  Result Init(Rsl::Blob* blob);
   static void EditConfig(Vlk::Value* configValP);
+  size_t StagedBytes() const;
+  void Upload();
 
   GLuint Id() const;
 
 private:
+  static Result ReadConfig(const Vlk::Explorer& configEx, Config* config);
+  static int FaceCount(Specification specification);
+
   struct Face {
-  public:
     static VResult<Face> Init(const std::string& file);
-    unsigned char* mData;
+    size_t ByteCount() const;
+    Ds::Vector<unsigned char> mData;
     int mWidth;
     int mHeight;
     int mChannels;
+  };
 
-  private:
-    Face();
-    Face(Face&& other);
-    ~Face();
-    friend VResult<Face>;
+  // The decoded faces of a cubemap that hasn't been uploaded. A single
+  // specification only has one face and it is used for every side.
+  struct Staging {
+    Ds::Vector<Face> mFaces;
+    GLint mGlFilter;
   };
 
   GLuint mId;
+  Staging* mStaging;
 };
 
 } // namespace Gfx
@@ -55,6 +55,51 @@ Result Font::Init(const Vlk::Explorer& configEx) {
   return Init(fileEx.As<std::string>());
 }
 
+Result Font::Cook(const Vlk::Explorer& configEx, Rsl::CookedRes* cookedRes) {
+  Vlk::Explorer fileEx = configEx("File");
+  if (!fileEx.Valid(Vlk::Value::Type::TrueValue)) {
+    return Result("Missing :File: TrueValue.");
+  }
+  VResult<std::string> resolutionResult =
+    Rsl::ResolveResPath(fileEx.As<std::string>());
+  if (!resolutionResult.Success()) {
+    return Result(resolutionResult.mError);
+  }
+  Font font;
+  Result result = font.Init(resolutionResult.mValue);
+  if (!result.Success()) {
+    return result;
+  }
+  cookedRes->mSourceFiles.Push(resolutionResult.mValue);
+
+  // The glyph metrics and staged glyph images are all that rendering needs.
+  Rsl::Blob& blob = cookedRes->mBlob;
+  blob.Write(font.mNewlineOffset);
+  for (const GlyphData& glyphData: font.mGlyphData) {
+    blob.Write(glyphData.mBlOffset);
+    blob.Write(glyphData.mTrOffset);
+    blob.Write(glyphData.mAdvance);
+    glyphData.mImage.WriteStaging(&blob);
+  }
+  return Result();
+}
+
+Result Font::Init(Rsl::Blob* blob) {
+  bool success = blob->Read(&mNewlineOffset);
+  for (size_t i = 0; success && i < smGlyphCount; ++i) {
+    GlyphData& glyphData = mGlyphData[i];
+    success = blob->Read(&glyphData.mBlOffset) &&
+      blob->Read(&glyphData.mTrOffset) && blob->Read(&glyphData.mAdvance);
+    if (success) {
+      success = glyphData.mImage.Init(blob).Success();
+    }
+  }
+  if (!success) {
+    return Result("Cooked font data is malformed.");
+  }
+  return Result();
+}
+
 Result Font::Init(const std::string& file) {
   // Resolve the resource path.
   VResult<std::string> resolutionResult = Rsl::ResolveResPath(file);
@@ -67,6 +112,7 @@ Result Font::Init(const std::string& file) {
   std::ifstream stream;
   stream.open(absoluteFile, std::ifstream::binary);
   if (!stream.is_open()) {
+    Rsl::InvalidateResPath(file);
     return Result("Failed to open\"" + absoluteFile + "\".");
   }
   std::filebuf* fileBuffer = stream.rdbuf();
@@ -123,8 +169,8 @@ void Font::InitGlyphs() {
       GLenum internalFormat = GL_R8;
       GLenum format = GL_RED;
       GLint pixelAlignment = 1;
-      glyphData.mImage.Init(
-        imageData, width, height, internalFormat, format, pixelAlignment);
+      glyphData.mImage.Stage(Image::Staging::Init(
+        imageData, width, height, internalFormat, format, pixelAlignment));
       stbtt_FreeBitmap((unsigned char*)imageData, nullptr);
     }
 
@@ -152,6 +198,20 @@ void Font::InitGlyphs() {
   }
 }
 
+size_t Font::StagedBytes() const {
+  size_t byteCount = 0;
+  for (const GlyphData& glyphData: mGlyphData) {
+    byteCount += glyphData.mImage.StagedBytes();
+  }
+  return byteCount;
+}
+
+void Font::Upload() {
+  for (GlyphData& glyphData: mGlyphData) {
+    glyphData.mImage.Upload();
+  }
+}
+
 GLuint Font::GetTextureId(int codepoint) {
   return mGlyphData[codepoint].mImage.Id();
 }
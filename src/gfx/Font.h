@@ -7,6 +7,7 @@
 #include "Result.h"
 #include "gfx/Image.h"
 #include "math/Vector.h"
+#include "rsl/Cook.h"
 #include "vlk/Valkor.h"
 
 namespace Gfx {
@@ -18,9 +19,15 @@ public:
   Font& operator=(Font&& other);
   ~Font();
 
+  // Init only stages the glyph images. Upload must be called before the glyphs
+  // can be rendered.
   static void EditConfig(Vlk::Value* configValP);
+  static Result Cook(const Vlk::Explorer& configEx, Rsl::CookedRes* cookedRes);
   Result Init(const Vlk::Explorer& configEx);
+  Result Init(Rsl::Blob* blob);
   Result Init(const std::string& file);
+  size_t StagedBytes() const;
+  void Upload();
 
   struct GlyphData {
     // The bottom left and top right offsets from the center of the glyph.
@@ -1,3 +1,4 @@
+#include <cstring>
 #include <imgui/imgui.h>
 #include <utility>
 
@@ -8,13 +9,184 @@
 #include <stb_image.h>
 #undef STB_IMAGE_IMPLEMENTATION
 
+#include "Viewport.h"
 #include "editor/Utility.h"
 #include "gfx/Image.h"
 #include "rsl/Library.h"
+#include "rsl/Pack.h"
 
 namespace Gfx {
 
-Image::Image(): mId(0) {}
+VResult<Image::Staging> Image::Staging::Init(const std::string& file) {
+  // Read the entire file from the mounted pack or the filesystem.
+  VResult<Rsl::FileData> readResult = Rsl::ReadResFile(file);
+  if (!readResult.Success()) {
+    return Result(readResult.mError);
+  }
+  Rsl::FileData& fileData = readResult.mValue;
+
+  // Handle DDS loading. The staging data holds the entire file, so content in
+  // the mapped pack is copied.
+  if (fileData.mSize >= 4 && memcmp(fileData.mData, "DDS ", 4) == 0) {
+    Ds::Vector<char> ddsData;
+    if (fileData.mOwnedData.Empty()) {
+      ddsData.Resize(fileData.mSize);
+      memcpy((void*)ddsData.Data(), fileData.mData, fileData.mSize);
+    }
+    else {
+      ddsData = std::move(fileData.mOwnedData);
+      ddsData.Resize(fileData.mSize);
+    }
+    return InitDDS(std::move(ddsData));
+  }
+
+  // Handle all other image formats.
+  VResult<Staging> result = Init(fileData.mData, fileData.mSize);
+  if (!result.Success()) {
+    return Result("File \"" + file + "\" failed load.\n" + result.mError);
+  }
+  return result;
+}
+
+VResult<Image::Staging> Image::Staging::Init(
+  const void* fileData, size_t size) {
+  // Images are always staged with three or four channels.
+  int width, height, channels;
+  int infoResult = stbi_info_from_memory(
+    (stbi_uc*)fileData, (int)size, &width, &height, &channels);
+  if (infoResult == 0) {
+    return Result(stbi_failure_reason());
+  }
+  channels = channels == 2 || channels == 4 ? 4 : 3;
+  void* imageData = stbi_load_from_memory(
+    (stbi_uc*)fileData, (int)size, &width, &height, nullptr, channels);
+  if (imageData == nullptr) {
+    return Result(stbi_failure_reason());
+  }
+  GLenum format = channels == 4 ? GL_RGBA : GL_RGB;
+  GLint pixelAlignment = channels == 4 ? 4 : 1;
+  Staging staging =
+    Init(imageData, width, height, format, format, pixelAlignment);
+  stbi_image_free(imageData);
+  return staging;
+}
+
+Image::Staging Image::Staging::Init(
+  const void* imageData,
+  int width,
+  int height,
+  GLenum internalFormat,
+  GLenum format,
+  GLint pixelAlignment) {
+  size_t pixelSize;
+  switch (format) {
+  case GL_RED: pixelSize = 1; break;
+  case GL_RG: pixelSize = 2; break;
+  case GL_RGB: pixelSize = 3; break;
+  default: pixelSize = 4; break;
+  }
+  Level level;
+  level.mByteIndex = 0;
+  level.mByteCount = pixelSize * (size_t)width * (size_t)height;
+  level.mWidth = width;
+  level.mHeight = height;
+
+  Staging staging;
+  staging.mData.Resize(level.mByteCount);
+  if (imageData != nullptr) {
+    memcpy((void*)staging.mData.Data(), imageData, level.mByteCount);
+  }
+  staging.mLevels.Push(level);
+  staging.mInternalFormat = internalFormat;
+  staging.mFormat = format;
+  staging.mPixelAlignment = pixelAlignment;
+  staging.mCompressed = false;
+  return staging;
+}
+
+VResult<Image::Staging> Image::Staging::InitDDS(Ds::Vector<char>&& fileData) {
+  // Parse the file data.
+  int byteCount = (int)fileData.Size();
+  ddsktx_texture_info textureInfo = {0};
+  bool success =
+    ddsktx_parse(&textureInfo, (void*)fileData.Data(), byteCount, nullptr);
+  if (!success) {
+    return Result("Parsing DDS data failed.");
+  }
+
+  // Find the file's pixel format.
+  Staging staging;
+  switch (textureInfo.format) {
+  case DDSKTX_FORMAT_BC1:
+    staging.mInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    break;
+  case DDSKTX_FORMAT_BC3:
+    staging.mInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    break;
+  case DDSKTX_FORMAT_BC5:
+    staging.mInternalFormat = GL_COMPRESSED_RG_RGTC2;
+    break;
+  default: return Result("DDS texture format not implemented.");
+  }
+  staging.mFormat = staging.mInternalFormat;
+  staging.mPixelAlignment = 4;
+  staging.mCompressed = true;
+
+  // Find the location of every mipmap within the file data.
+  for (int i = 0; i < textureInfo.num_mips; ++i) {
+    ddsktx_sub_data subInfo;
+    ddsktx_get_sub(&textureInfo, &subInfo, fileData.Data(), byteCount, 0, 0, i);
+    Level level;
+    level.mByteIndex = (const char*)subInfo.buff - fileData.CData();
+    level.mByteCount = (size_t)subInfo.size_bytes;
+    level.mWidth = subInfo.width;
+    level.mHeight = subInfo.height;
+    staging.mLevels.Push(level);
+  }
+  staging.mData = std::move(fileData);
+  return staging;
+}
+
+VResult<Image::Staging> Image::Staging::Init(Rsl::Blob* blob) {
+  Staging staging;
+  bool success = blob->Read(&staging.mData) && blob->Read(&staging.mLevels) &&
+    blob->Read(&staging.mInternalFormat) && blob->Read(&staging.mFormat) &&
+    blob->Read(&staging.mPixelAlignment) && blob->Read(&staging.mCompressed);
+  if (!success) {
+    return Result("Cooked image data is malformed.");
+  }
+  return staging;
+}
+
+void Image::Staging::Write(Rsl::Blob* blob) const {
+  blob->Write(mData);
+  blob->Write(mLevels);
+  blob->Write(mInternalFormat);
+  blob->Write(mFormat);
+  blob->Write(mPixelAlignment);
+  blob->Write(mCompressed);
+}
+
+size_t Image::Staging::ByteCount() const {
+  size_t byteCount = 0;
+  for (const Level& level: mLevels) {
+    byteCount += level.mByteCount;
+  }
+  return byteCount;
+}
+
+struct Image::Shared {
+  size_t mShareKey;
+  GLuint mId;
+  int mWidth;
+  int mHeight;
+  int mRefCount;
+};
+
+std::mutex Image::smSharedMutex;
+Ds::HashMap<size_t, Image::Shared*> Image::smShared;
+
+Image::Image(): mId(0), mStaging(nullptr), mShareKey(0), mShared(nullptr) {}
 
 Image::Image(Image&& other) {
   *this = std::move(other);
@@ -24,17 +196,24 @@ Image& Image::operator=(Image&& other) {
   mWidth = other.mWidth;
   mHeight = other.mHeight;
   mId = other.mId;
+  mStaging = other.mStaging;
+  mShareKey = other.mShareKey;
+  mShared = other.mShared;
 
   other.mId = 0;
+  other.mStaging = nullptr;
+  other.mShareKey = 0;
+  other.mShared = nullptr;
 
   return *this;
 }
 
 Image::~Image() {
-  if (mId != 0) {
-    glDeleteTextures(1, &mId);
-    mId = 0;
+  if (mStaging != nullptr) {
+    delete mStaging;
+    mStaging = nullptr;
   }
+  ReleaseTexture();
 }
 
 void Image::EditConfig(Vlk::Value* configValP) {
@@ -45,110 +224,68 @@ void Image::EditConfig(Vlk::Value* configValP) {
   fileVal = file;
 }
 
-Result Image::Init(const Vlk::Explorer& configEx) {
+Result Image::Cook(const Vlk::Explorer& configEx, Rsl::CookedRes* cookedRes) {
   Vlk::Explorer fileEx = configEx("File");
   if (!fileEx.Valid(Vlk::Value::Type::TrueValue)) {
     return Result("Missing :File: TrueValue");
   }
-  std::string file = fileEx.As<std::string>();
-  return Init(file);
-}
-
-Result Image::Init(const std::string& file) {
-  // Resolve the file path.
-  VResult<std::string> resolutionResult = Rsl::ResolveResPath(file);
+  VResult<std::string> resolutionResult =
+    Rsl::ResolveResPath(fileEx.As<std::string>());
   if (!resolutionResult.Success()) {
     return Result(resolutionResult.mError);
   }
-  std::string absoluteFile = resolutionResult.mValue;
-
-  // Open the file and discover its type.
-  FILE* fileStream = stbi__fopen(absoluteFile.c_str(), "rb");
-  if (fileStream == nullptr) {
-    return Result("File \"" + absoluteFile + "\" could not be opened.");
-  }
-  char typeIdentifier[5];
-  fgets(typeIdentifier, 5, fileStream);
-  fseek(fileStream, 0, SEEK_SET);
-
-  // Handle DDS loading.
-  if (strcmp(typeIdentifier, "DDS ") == 0) {
-    Result result = InitDDS(fileStream);
-    fclose(fileStream);
-    return result;
+  VResult<Staging> result = Staging::Init(resolutionResult.mValue);
+  if (!result.Success()) {
+    Rsl::InvalidateResPath(fileEx.As<std::string>());
+    return std::move(result);
   }
-
-  // Handle all other image formats.
-  int width, height, channels;
-  void* imageData =
-    stbi_load_from_file(fileStream, &width, &height, &channels, 0);
-  fclose(fileStream);
-  if (imageData == nullptr) {
-    return Result(
-      "File \"" + absoluteFile + "\" failed load.\n" + stbi_failure_reason());
-  }
-  Init(imageData, width, height, channels);
-  stbi_image_free(imageData);
+  cookedRes->mSourceFiles.Push(resolutionResult.mValue);
+  // The flag matches the one written by WriteStaging.
+  cookedRes->mBlob.Write(true);
+  result.mValue.Write(&cookedRes->mBlob);
   return Result();
 }
 
-Result Image::InitDDS(FILE* stream) {
-  // Read the entire dds file stream.
-  fseek(stream, 0, SEEK_END);
-  long byteCount = ftell(stream);
-  fseek(stream, 0, SEEK_SET);
-  Ds::Vector<char> fileData;
-  fileData.Reserve(byteCount);
-  fread((void*)fileData.Data(), 1, byteCount, stream);
-
-  // Parse the file data.
-  ddsktx_texture_info textureInfo = {0};
-  bool success =
-    ddsktx_parse(&textureInfo, (void*)fileData.Data(), byteCount, nullptr);
-  if (!success) {
-    return Result("Parsing DDS data failed.");
+Result Image::Init(const Vlk::Explorer& configEx) {
+  Vlk::Explorer fileEx = configEx("File");
+  if (!fileEx.Valid(Vlk::Value::Type::TrueValue)) {
+    return Result("Missing :File: TrueValue");
   }
+  std::string file = fileEx.As<std::string>();
+  return Init(file);
+}
 
-  // Find the file's pixel format.
-  GLenum internalFormat;
-  switch (textureInfo.format) {
-  case DDSKTX_FORMAT_BC1:
-    internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
-    break;
-  case DDSKTX_FORMAT_BC3:
-    internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-    break;
-  case DDSKTX_FORMAT_BC5: internalFormat = GL_COMPRESSED_RG_RGTC2; break;
-  default: return Result("DDS texture format not implemented.");
+Result Image::Init(Rsl::Blob* blob) {
+  bool staged;
+  if (!blob->Read(&staged)) {
+    return Result("Cooked image data is malformed.");
+  }
+  if (!staged) {
+    return Result();
   }
+  VResult<Staging> result = Staging::Init(blob);
+  if (!result.Success()) {
+    return std::move(result);
+  }
+  Stage(std::move(result.mValue));
+  return Result();
+}
 
-  // Upload the texture and mipmaps.
-  CreateTexutre();
-  for (int i = 0; i < textureInfo.num_mips; ++i) {
-    ddsktx_sub_data subInfo;
-    ddsktx_get_sub(&textureInfo, &subInfo, fileData.Data(), byteCount, 0, 0, i);
-    glCompressedTexImage2D(
-      GL_TEXTURE_2D,
-      i,
-      internalFormat,
-      subInfo.width,
-      subInfo.height,
-      0,
-      subInfo.size_bytes,
-      subInfo.buff);
+Result Image::Init(const std::string& file) {
+  VResult<Staging> result = Staging::Init(file);
+  if (!result.Success()) {
+    return std::move(result);
   }
+  Stage(std::move(result.mValue));
   return Result();
 }
 
 Result Image::Init(const void* fileData, int size) {
-  int width, height, channels;
-  void* imageData = stbi_load_from_memory(
-    (stbi_uc*)fileData, size, &width, &height, &channels, 0);
-  if (imageData == nullptr) {
-    return Result(stbi_failure_reason());
+  VResult<Staging> result = Staging::Init(fileData, (size_t)size);
+  if (!result.Success()) {
+    return std::move(result);
   }
-  Init(imageData, width, height, channels);
-  stbi_image_free(imageData);
+  Stage(std::move(result.mValue));
   return Result();
 }
 
@@ -168,24 +305,94 @@ Result Image::Init(
   GLenum internalFormat,
   GLenum format,
   GLint pixelAlignment) {
-  mWidth = width;
-  mHeight = height;
-  CreateTexutre();
-  glPixelStorei(GL_UNPACK_ALIGNMENT, pixelAlignment);
-  glTexImage2D(
-    GL_TEXTURE_2D,
-    0,
-    internalFormat,
-    mWidth,
-    mHeight,
-    0,
-    format,
-    GL_UNSIGNED_BYTE,
-    imageData);
-  glGenerateMipmap(GL_TEXTURE_2D);
+  Stage(Staging::Init(
+    imageData, width, height, internalFormat, format, pixelAlignment));
+  Upload();
   return Result();
 }
 
+void Image::Stage(Staging&& staging) {
+  if (mStaging == nullptr) {
+    mStaging = alloc Staging;
+  }
+  *mStaging = std::move(staging);
+  mWidth = mStaging->mLevels.Empty() ? 0 : mStaging->mLevels[0].mWidth;
+  mHeight = mStaging->mLevels.Empty() ? 0 : mStaging->mLevels[0].mHeight;
+}
+
+void Image::WriteStaging(Rsl::Blob* blob) const {
+  blob->Write(mStaging != nullptr);
+  if (mStaging != nullptr) {
+    mStaging->Write(blob);
+  }
+}
+
+size_t Image::StagedBytes() const {
+  if (mStaging == nullptr) {
+    return 0;
+  }
+  return mStaging->ByteCount();
+}
+
+bool Image::Upload() {
+  if (mStaging == nullptr) {
+    return false;
+  }
+  // Another image may have uploaded the same content since this one was
+  // staged.
+  if (mShareKey != 0 && TryUseShared()) {
+    delete mStaging;
+    mStaging = nullptr;
+    return false;
+  }
+  Viewport::SharedContext sharedContext;
+  CreateTexutre();
+  const Staging& staging = *mStaging;
+  if (staging.mCompressed) {
+    for (int i = 0; i < staging.mLevels.Size(); ++i) {
+      const Staging::Level& level = staging.mLevels[i];
+      glCompressedTexImage2D(
+        GL_TEXTURE_2D,
+        i,
+        staging.mInternalFormat,
+        level.mWidth,
+        level.mHeight,
+        0,
+        (GLsizei)level.mByteCount,
+        staging.mData.CData() + level.mByteIndex);
+    }
+  }
+  else {
+    const Staging::Level& level = staging.mLevels[0];
+    glPixelStorei(GL_UNPACK_ALIGNMENT, staging.mPixelAlignment);
+    glTexImage2D(
+      GL_TEXTURE_2D,
+      0,
+      staging.mInternalFormat,
+      level.mWidth,
+      level.mHeight,
+      0,
+      staging.mFormat,
+      GL_UNSIGNED_BYTE,
+      staging.mData.CData() + level.mByteIndex);
+    glGenerateMipmap(GL_TEXTURE_2D);
+  }
+  delete mStaging;
+  mStaging = nullptr;
+
+  if (mShareKey != 0) {
+    std::scoped_lock lock(smSharedMutex);
+    mShared = alloc Shared;
+    mShared->mShareKey = mShareKey;
+    mShared->mId = mId;
+    mShared->mWidth = mWidth;
+    mShared->mHeight = mHeight;
+    mShared->mRefCount = 1;
+    smShared.Insert(mShareKey, mShared);
+  }
+  return true;
+}
+
 void Image::CreateTexutre() {
   glGenTextures(1, &mId);
   glBindTexture(GL_TEXTURE_2D, mId);
@@ -196,6 +403,62 @@ void Image::CreateTexutre() {
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 }
 
+bool Image::TryShare(size_t shareKey) {
+  mShareKey = shareKey;
+  if (TryUseShared()) {
+    return true;
+  }
+  mShareKey = 0;
+  return false;
+}
+
+void Image::SetShareKey(size_t shareKey) {
+  mShareKey = shareKey;
+}
+
+void Image::Unshare(size_t shareKey) {
+  std::scoped_lock lock(smSharedMutex);
+  smShared.TryRemove(shareKey);
+}
+
+bool Image::TryUseShared() {
+  std::scoped_lock lock(smSharedMutex);
+  auto it = smShared.Find(mShareKey);
+  if (it == smShared.end()) {
+    return false;
+  }
+  mShared = it->mValue;
+  ++mShared->mRefCount;
+  mId = mShared->mId;
+  mWidth = mShared->mWidth;
+  mHeight = mShared->mHeight;
+  return true;
+}
+
+void Image::ReleaseTexture() {
+  if (mShared != nullptr) {
+    std::scoped_lock lock(smSharedMutex);
+    --mShared->mRefCount;
+    if (mShared->mRefCount > 0) {
+      mShared = nullptr;
+      mId = 0;
+      return;
+    }
+    // The texture may have been unshared and replaced under the same key.
+    auto it = smShared.Find(mShared->mShareKey);
+    if (it != smShared.end() && it->mValue == mShared) {
+      smShared.Remove(it);
+    }
+    delete mShared;
+    mShared = nullptr;
+  }
+  if (mId != 0) {
+    Viewport::SharedContext sharedContext;
+    glDeleteTextures(1, &mId);
+    mId = 0;
+  }
+}
+
 GLuint Image::Id() const {
   return mId;
 }
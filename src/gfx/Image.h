@@ -2,7 +2,11 @@
 #define gfx_Image_h
 
 #include <glad/glad.h>
+#include <mutex>
 
+#include "ds/HashMap.h"
+#include "ds/Vector.h"
+#include "rsl/Cook.h"
 #include "vlk/Valkor.h"
 
 namespace Gfx {
@@ -14,10 +18,48 @@ public:
   Image& operator=(Image&& other);
   ~Image();
 
+  // Decoded image data that hasn't been uploaded. Creating it doesn't require a
+  // gl context.
+  struct Staging {
+    static VResult<Staging> Init(const std::string& file);
+    static VResult<Staging> Init(const void* fileData, size_t size);
+    static Staging Init(
+      const void* imageData,
+      int width,
+      int height,
+      GLenum internalFormat,
+      GLenum format,
+      GLint pixelAlignment);
+    static VResult<Staging> Init(Rsl::Blob* blob);
+    void Write(Rsl::Blob* blob) const;
+    size_t ByteCount() const;
+
+    // Compressed images have a level for every mipmap. Uncompressed images
+    // have a single level and their mipmaps are generated during the upload.
+    struct Level {
+      size_t mByteIndex;
+      size_t mByteCount;
+      int mWidth;
+      int mHeight;
+    };
+    Ds::Vector<char> mData;
+    Ds::Vector<Level> mLevels;
+    GLenum mInternalFormat;
+    GLenum mFormat;
+    GLint mPixelAlignment;
+    bool mCompressed;
+
+  private:
+    static VResult<Staging> InitDDS(Ds::Vector<char>&& fileData);
+  };
+
+  // The config, file, and file data Inits only stage the image. Upload must be
+  // called before the texture exists. The remaining Inits upload immediately.
   static void EditConfig(Vlk::Value* configValP);
+  static Result Cook(const Vlk::Explorer& configEx, Rsl::CookedRes* cookedRes);
   Result Init(const Vlk::Explorer& configEx);
+  Result Init(Rsl::Blob* blob);
   Result Init(const std::string& file);
-  Result InitDDS(FILE* fileStream);
   Result Init(const void* fileData, int size);
   Result Init(const void* imageData, int width, int height, int channels);
   Result Init(
@@ -27,8 +69,24 @@ public:
     GLenum internalFormat,
     GLenum format,
     GLint pixelAlignment);
+  void Stage(Staging&& staging);
+  void WriteStaging(Rsl::Blob* blob) const;
+  size_t StagedBytes() const;
+  // Returns false when nothing was uploaded because the image used a texture
+  // shared by another image instead.
+  bool Upload();
   void CreateTexutre();
 
+  // Images with the same share key use the texture of the first one that was
+  // uploaded and the texture is deleted once none of them use it. TryShare
+  // fails when no texture is shared under the key yet. SetShareKey makes Upload
+  // either use the texture shared under the key or share its own texture.
+  bool TryShare(size_t shareKey);
+  void SetShareKey(size_t shareKey);
+  // Images using the texture shared under the key keep it, but images that are
+  // shared later will use a new texture.
+  static void Unshare(size_t shareKey);
+
   GLuint Id() const;
   float Aspect() const;
 
@@ -36,6 +94,17 @@ private:
   int mWidth;
   int mHeight;
   GLuint mId;
+  Staging* mStaging;
+
+  struct Shared;
+  // A share key of 0 means the image owns its texture.
+  size_t mShareKey;
+  Shared* mShared;
+  bool TryUseShared();
+  void ReleaseTexture();
+
+  static std::mutex smSharedMutex;
+  static Ds::HashMap<size_t, Shared*> smShared;
 };
 
 } // namespace Gfx
@@ -9,6 +9,10 @@
 
 namespace Gfx {
 
+// The texture types that are loaded from an aiMaterial.
+constexpr aiTextureType nTextureTypes[3] = {
+  aiTextureType_DIFFUSE, aiTextureType_SPECULAR, aiTextureType_NORMALS};
+
 Material::Material() {}
 
 Material::Material(Material&& other) {
@@ -164,6 +168,29 @@ void Material::EditConfig(Vlk::Value* configValP) {
   ImGui::Text("Uniforms");
 }
 
+void Material::CollectDependencies(
+  const Vlk::Explorer& configEx, Ds::Vector<ResId>* dependencies) {
+  Vlk::Explorer shaderResIdEx = configEx("ShaderId");
+  if (shaderResIdEx.Valid(Vlk::Value::Type::TrueValue)) {
+    dependencies->Push(shaderResIdEx.As<ResId>());
+  }
+  Vlk::Explorer uniformsEx = configEx("Uniforms");
+  if (!uniformsEx.Valid(Vlk::Value::Type::ValueArray)) {
+    return;
+  }
+  for (size_t i = 0; i < uniformsEx.Size(); ++i) {
+    Vlk::Explorer uniformEx = uniformsEx[i];
+    std::string typeName = uniformEx("Type").As<std::string>("");
+    UniformTypeId typeId = GetUniformTypeId(typeName);
+    bool resourceUniform = typeId == UniformTypeId::Texture2dRes ||
+      typeId == UniformTypeId::TextureCubemapRes;
+    Vlk::Explorer valueEx = uniformEx("Value");
+    if (resourceUniform && valueEx.Valid(Vlk::Value::Type::TrueValue)) {
+      dependencies->Push(valueEx.As<ResId>());
+    }
+  }
+}
+
 Result Material::Init(const Vlk::Explorer& configEx) {
   // Get the material shader from an id or a new shader config.
   Vlk::Explorer shaderResIdEx = configEx("ShaderId");
@@ -227,10 +254,7 @@ Result Material::Init(
 
   // Load textures and create their respective uniforms.
   Rsl::Asset& initAsset = Rsl::Asset::GetInitAsset();
-  aiTextureType textureTypes[3] = {
-    aiTextureType_DIFFUSE, aiTextureType_SPECULAR, aiTextureType_NORMALS};
-  for (int i = 0; i < 3; ++i) {
-    aiTextureType aiType = textureTypes[i];
+  for (aiTextureType aiType: nTextureTypes) {
     const char* preUniformName = GetUniformName(aiType);
     unsigned int textureCount = assimpMat.GetTextureCount(aiType);
     for (unsigned int i = 0; i < textureCount; ++i) {
@@ -341,6 +365,23 @@ Result Material::InitUniform(const Vlk::Explorer& uniformEx) {
   return Result();
 }
 
+void Material::CollectTextureFiles(
+  const aiMaterial& assimpMat,
+  const std::string& directory,
+  Ds::Vector<std::string>* textureFiles) {
+  for (aiTextureType aiType: nTextureTypes) {
+    unsigned int textureCount = assimpMat.GetTextureCount(aiType);
+    for (unsigned int i = 0; i < textureCount; ++i) {
+      // Embedded textures are named with an asterisk and their index.
+      aiString filename;
+      aiReturn aiResult = assimpMat.Get(AI_MATKEY_TEXTURE(aiType, i), filename);
+      if (aiResult == AI_SUCCESS && filename.C_Str()[0] != '*') {
+        textureFiles->Push(directory + filename.C_Str());
+      }
+    }
+  }
+}
+
 const char* Material::GetUniformName(aiTextureType aiType) {
   switch (aiType) {
   case aiTextureType_DIFFUSE: return "uDiffuse";
@@ -17,6 +17,8 @@ struct Material: public UniformVector {
   Material& operator=(Material&& other);
 
   static void EditConfig(Vlk::Value* configValP);
+  static void CollectDependencies(
+    const Vlk::Explorer& configEx, Ds::Vector<ResId>* dependencies);
   Result Init(const Vlk::Explorer& configEx);
   Result Init(const ResId& shaderResId);
   Result Init(Material&& other);
@@ -27,6 +29,11 @@ struct Material: public UniformVector {
     const std::string& directory,
     const Ds::Vector<std::string>& embeddedImageNames);
   Result InitUniform(const Vlk::Explorer& uniformEx);
+  // Adds the files of the textures that initializing with an aiMaterial loads.
+  static void CollectTextureFiles(
+    const aiMaterial& assimpMat,
+    const std::string& directory,
+    Ds::Vector<std::string>* textureFiles);
 
   ResId mShaderId;
 
@@ -3,10 +3,12 @@
 #include <imgui/imgui.h>
 #include <utility>
 
+#include "Viewport.h"
 #include "editor/Utility.h"
 #include "gfx/Mesh.h"
 #include "gfx/Model.h"
 #include "math/Vector.h"
+#include "rsl/Library.h"
 
 namespace Gfx {
 
@@ -30,7 +32,26 @@ unsigned int Mesh::AttributesSize(unsigned int attributes) {
   return size;
 }
 
-Mesh::Mesh(): mVao(0), mVbo(0), mEbo(0), mIndexCount(0), mAttributes(0) {}
+struct Mesh::Shared {
+  size_t mShareKey;
+  GLuint mVao, mVbo, mEbo;
+  size_t mIndexCount;
+  unsigned int mAttributes;
+  int mRefCount;
+};
+
+std::mutex Mesh::smSharedMutex;
+Ds::HashMap<size_t, Mesh::Shared*> Mesh::smShared;
+
+Mesh::Mesh():
+  mVao(0),
+  mVbo(0),
+  mEbo(0),
+  mIndexCount(0),
+  mAttributes(0),
+  mStaging(nullptr),
+  mShareKey(0),
+  mShared(nullptr) {}
 
 Mesh::Mesh(Mesh&& other) {
   *this = std::move(other);
@@ -42,16 +63,26 @@ Mesh& Mesh::operator=(Mesh&& other) {
   mEbo = other.mEbo;
   mIndexCount = other.mIndexCount;
   mAttributes = other.mAttributes;
+  mStaging = other.mStaging;
+  mShareKey = other.mShareKey;
+  mShared = other.mShared;
 
   other.mVao = 0;
   other.mVbo = 0;
   other.mEbo = 0;
   other.mIndexCount = 0;
+  other.mStaging = nullptr;
+  other.mShareKey = 0;
+  other.mShared = nullptr;
 
   return *this;
 }
 
 Mesh::~Mesh() {
+  if (mStaging != nullptr) {
+    delete mStaging;
+    mStaging = nullptr;
+  }
   Purge();
 }
 
@@ -75,6 +106,32 @@ void Mesh::EditConfig(Vlk::Value* configValP) {
   scaleVal = scale;
 }
 
+Result Mesh::Cook(const Vlk::Explorer& configEx, Rsl::CookedRes* cookedRes) {
+  Vlk::Explorer fileEx = configEx("File");
+  if (!fileEx.Valid(Vlk::Value::Type::TrueValue)) {
+    return Result("Missing :File: TrueValue.");
+  }
+  VResult<std::string> resolutionResult =
+    Rsl::ResolveResPath(fileEx.As<std::string>());
+  if (!resolutionResult.Success()) {
+    return Result(resolutionResult.mError);
+  }
+  const bool flipUvs = configEx("FlipUvs").As<bool>(false);
+  float scale = configEx("Scale").As<float>(1.0f);
+  VResult<Local> result =
+    Local::Init(resolutionResult.mValue, Attribute::All, flipUvs, scale);
+  if (!result.Success()) {
+    Rsl::InvalidateResPath(fileEx.As<std::string>());
+    return result;
+  }
+  cookedRes->mSourceFiles.Push(resolutionResult.mValue);
+  const Local& local = result.mValue;
+  cookedRes->mBlob.Write(local.mAttributes);
+  cookedRes->mBlob.Write(local.mVertexBuffer);
+  cookedRes->mBlob.Write(local.mElementBuffer);
+  return Result();
+}
+
 Result Mesh::Init() {
   return Result();
 }
@@ -90,12 +147,24 @@ Result Mesh::Init(const Vlk::Explorer& configEx) {
   return Init(file, flipUvs, scale);
 }
 
+Result Mesh::Init(Rsl::Blob* blob) {
+  Local local;
+  bool success = blob->Read(&local.mAttributes) &&
+    blob->Read(&local.mVertexBuffer) && blob->Read(&local.mElementBuffer);
+  if (!success) {
+    return Result("Cooked mesh data is malformed.");
+  }
+  Stage(std::move(local));
+  return Result();
+}
+
 Result Mesh::Init(const std::string& file, bool flipUvs, float scale) {
   VResult<Local> result = Local::Init(file, Attribute::All, flipUvs, scale);
   if (!result.Success()) {
     return result;
   }
-  return Init(result.mValue);
+  Stage(std::move(result.mValue));
+  return Result();
 }
 
 Result Mesh::Init(const aiMesh& assimpMesh, float scale) {
@@ -103,7 +172,8 @@ Result Mesh::Init(const aiMesh& assimpMesh, float scale) {
   if (!result.Success()) {
     return result;
   }
-  return Init(result.mValue);
+  Stage(std::move(result.mValue));
+  return Result();
 }
 
 VResult<Mesh::Local> Mesh::Local::Init(
@@ -113,7 +183,7 @@ VResult<Mesh::Local> Mesh::Local::Init(
   float scale) {
   Assimp::Importer importer;
   VResult<const aiScene*> importResult =
-    Gfx::Model::Import(file, &importer, flipUvs);
+    Gfx::Model::Import(file, &importer, flipUvs, nullptr);
   if (!importResult.Success()) {
     return std::move(importResult);
   }
@@ -271,6 +341,7 @@ Result Mesh::Init(
   size_t elementBufferSize,
   size_t elementCount) {
   mAttributes = attributes;
+  Viewport::SharedContext sharedContext;
 
   // Upload the vertex buffer.
   glGenBuffers(1, &mVbo);
@@ -296,6 +367,53 @@ Result Mesh::Init(
   return Result();
 }
 
+void Mesh::Stage(Local&& local) {
+  if (mStaging == nullptr) {
+    mStaging = alloc Local;
+  }
+  *mStaging = std::move(local);
+  mAttributes = mStaging->mAttributes;
+  mIndexCount = mStaging->mElementBuffer.Size();
+}
+
+size_t Mesh::StagedBytes() const {
+  if (mStaging == nullptr) {
+    return 0;
+  }
+  return mStaging->mVertexBuffer.Size() +
+    mStaging->mElementBuffer.Size() * sizeof(unsigned int);
+}
+
+bool Mesh::Upload() {
+  // Another mesh may have uploaded the same content since this one was staged.
+  if (mStaging != nullptr && mShareKey != 0 && TryUseShared()) {
+    delete mStaging;
+    mStaging = nullptr;
+    return false;
+  }
+  if (mStaging != nullptr) {
+    Init(*mStaging);
+    delete mStaging;
+    mStaging = nullptr;
+  }
+  if (mVao == 0) {
+    Finalize();
+  }
+  if (mShareKey != 0 && mShared == nullptr) {
+    std::scoped_lock lock(smSharedMutex);
+    mShared = alloc Shared;
+    mShared->mShareKey = mShareKey;
+    mShared->mVao = mVao;
+    mShared->mVbo = mVbo;
+    mShared->mEbo = mEbo;
+    mShared->mIndexCount = mIndexCount;
+    mShared->mAttributes = mAttributes;
+    mShared->mRefCount = 1;
+    smShared.Insert(mShareKey, mShared);
+  }
+  return true;
+}
+
 void Mesh::Finalize() {
   // Specify the vertex buffer's attribute layout.
   glGenVertexArrays(1, &mVao);
@@ -347,11 +465,67 @@ void Mesh::UpdateVbo(
 }
 
 void Mesh::Purge() {
+  if (mShared != nullptr) {
+    std::scoped_lock lock(smSharedMutex);
+    --mShared->mRefCount;
+    if (mShared->mRefCount > 0) {
+      mShared = nullptr;
+      mVao = 0;
+      mVbo = 0;
+      mEbo = 0;
+      return;
+    }
+    // The buffers may have been unshared and replaced under the same key.
+    auto it = smShared.Find(mShared->mShareKey);
+    if (it != smShared.end() && it->mValue == mShared) {
+      smShared.Remove(it);
+    }
+    delete mShared;
+    mShared = nullptr;
+  }
+  if (mVao == 0 && mVbo == 0 && mEbo == 0) {
+    return;
+  }
+  Viewport::SharedContext sharedContext;
   glDeleteVertexArrays(1, &mVao);
   glDeleteBuffers(1, &mVbo);
   glDeleteBuffers(1, &mEbo);
 }
 
+bool Mesh::TryShare(size_t shareKey) {
+  mShareKey = shareKey;
+  if (TryUseShared()) {
+    return true;
+  }
+  mShareKey = 0;
+  return false;
+}
+
+void Mesh::SetShareKey(size_t shareKey) {
+  mShareKey = shareKey;
+}
+
+void Mesh::Unshare(size_t shareKey) {
+  std::scoped_lock lock(smSharedMutex);
+  smShared.TryRemove(shareKey);
+}
+
+bool Mesh::TryUseShared() {
+  std::scoped_lock lock(smSharedMutex);
+  auto it = smShared.Find(mShareKey);
+  if (it == smShared.end()) {
+    return false;
+  }
+  mShared = it->mValue;
+  ++mShared->mRefCount;
+  mVao = mShared->mVao;
+  mVbo = mShared->mVbo;
+  mEbo = mShared->mEbo;
+  mIndexCount = mShared->mIndexCount;
+  mAttributes = mShared->mAttributes;
+  return true;
+}
+
 void Mesh::Render() const {
   glBindVertexArray(mVao);
   glDrawElements(GL_TRIANGLES, (GLsizei)mIndexCount, GL_UNSIGNED_INT, 0);
@@ -3,10 +3,13 @@
 
 #include <assimp/mesh.h>
 #include <glad/glad.h>
+#include <mutex>
 
 #include "Result.h"
+#include "ds/HashMap.h"
 #include "ds/Vector.h"
 #include "math/Vector.h"
+#include "rsl/Cook.h"
 #include "vlk/Valkor.h"
 
 namespace Gfx {
@@ -42,9 +45,14 @@ struct Mesh {
     Ds::Vector<unsigned int> mElementBuffer;
   };
 
+  // The config, file, and assimp mesh Inits only stage the mesh. Upload must be
+  // called before it can be rendered. The remaining Inits upload immediately
+  // and require a call to Finalize.
   static void EditConfig(Vlk::Value* configValP);
+  static Result Cook(const Vlk::Explorer& configEx, Rsl::CookedRes* cookedRes);
   Result Init();
   Result Init(const Vlk::Explorer& configEx);
+  Result Init(Rsl::Blob* blob);
   Result Init(const std::string& file, bool flipUvs, float scale);
   Result Init(const aiMesh& assimpMesh, float scale);
   Result Init(const Local& localMesh);
@@ -64,10 +72,23 @@ struct Mesh {
     size_t elementBufferSize,
     size_t elementCount);
 
+  void Stage(Local&& local);
+  size_t StagedBytes() const;
+  // Returns false when the mesh used buffers shared by another mesh instead of
+  // uploading its own.
+  bool Upload();
+
   void Finalize();
   void UpdateVbo(size_t byteOffset, size_t byteCount, const void* data) const;
   void Purge();
 
+  // Meshes with the same share key use the buffers of the first one that was
+  // uploaded and the buffers are deleted once none of them use them. These
+  // work like the Image functions with the same names.
+  bool TryShare(size_t shareKey);
+  void SetShareKey(size_t shareKey);
+  static void Unshare(size_t shareKey);
+
   void Render() const;
   GLuint Vao() const;
   GLuint Ebo() const;
@@ -78,6 +99,16 @@ struct Mesh {
 private:
   unsigned int mAttributes;
   GLuint mVao, mVbo, mEbo;
+  Local* mStaging;
+
+  struct Shared;
+  // A share key of 0 means the mesh owns its buffers.
+  size_t mShareKey;
+  Shared* mShared;
+  bool TryUseShared();
+
+  static std::mutex smSharedMutex;
+  static Ds::HashMap<size_t, Shared*> smShared;
 };
 
 } // namespace Gfx
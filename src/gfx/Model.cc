@@ -1,4 +1,6 @@
-#include <filesystem>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <cstring>
 #include <imgui/imgui.h>
 
 #include "editor/Utility.h"
@@ -8,6 +10,8 @@
 #include "gfx/Model.h"
 #include "math/Matrix4.h"
 #include "rsl/Library.h"
+#include "rsl/LoadStats.h"
+#include "rsl/Pack.h"
 #include "util/Memory.h"
 
 namespace Gfx {
@@ -25,26 +29,114 @@ Model& Model::operator=(Model&& other) {
   return *this;
 }
 
-VResult<const aiScene*> Model::Import(
-  const std::string& file, Assimp::Importer* importer, bool flipUvs) {
-  // Resolve the file to an absolute path.
-  VResult<std::string> resolutionResult = Rsl::ResolveResPath(file);
-  if (!resolutionResult.Success()) {
-    return Result(resolutionResult.mError);
+// Gives the importer the content of a file read through ReadResFile.
+struct ResIOStream: public Assimp::IOStream {
+  ResIOStream(Rsl::FileData&& fileData):
+    mFileData(std::move(fileData)), mPosition(0) {}
+
+  size_t Read(void* buffer, size_t size, size_t count) override {
+    if (size == 0) {
+      return 0;
+    }
+    size_t availableCount = (mFileData.mSize - mPosition) / size;
+    count = count < availableCount ? count : availableCount;
+    memcpy(buffer, (const void*)(mFileData.mData + mPosition), size * count);
+    mPosition += size * count;
+    return count;
+  }
+
+  size_t Write(const void* buffer, size_t size, size_t count) override {
+    return 0;
+  }
+
+  aiReturn Seek(size_t offset, aiOrigin origin) override {
+    size_t position;
+    switch (origin) {
+    case aiOrigin_SET: position = offset; break;
+    case aiOrigin_CUR: position = mPosition + offset; break;
+    case aiOrigin_END: position = mFileData.mSize - offset; break;
+    default: return aiReturn_FAILURE;
+    }
+    if (offset > mFileData.mSize || position > mFileData.mSize) {
+      return aiReturn_FAILURE;
+    }
+    mPosition = position;
+    return aiReturn_SUCCESS;
+  }
+
+  size_t Tell() const override {
+    return mPosition;
   }
-  const std::string& resolvedFile = resolutionResult.mValue;
-  // The importer will crash if the path does not reference a regular file.
-  if (!std::filesystem::is_regular_file(resolvedFile)) {
-    return Result("\"" + file + "\" is not a regular file.");
+
+  size_t FileSize() const override {
+    return mFileData.mSize;
+  }
+
+  void Flush() override {}
+
+private:
+  Rsl::FileData mFileData;
+  size_t mPosition;
+};
+
+// Opens the files that the importer requests with ReadResFile and records the
+// paths of the files that were opened.
+struct ResIOSystem: public Assimp::IOSystem {
+  ResIOSystem(Ds::Vector<std::string>* openedFiles):
+    mOpenedFiles(openedFiles) {}
+
+  bool Exists(const char* file) const override {
+    if (Rsl::nPack.IsOpen() && Rsl::nPack.TryGetEntry(file) != nullptr) {
+      return true;
+    }
+    return Rsl::ResolveResPath(file).Success();
+  }
+
+  char getOsSeparator() const override {
+    return '/';
+  }
+
+  Assimp::IOStream* Open(const char* file, const char* mode) override {
+    // Resource files are never written.
+    if (strchr(mode, 'w') != nullptr || strchr(mode, 'a') != nullptr) {
+      return nullptr;
+    }
+    VResult<Rsl::FileData> readResult = Rsl::ReadResFile(file);
+    if (!readResult.Success()) {
+      return nullptr;
+    }
+    if (mOpenedFiles != nullptr) {
+      mOpenedFiles->Push(file);
+    }
+    return alloc ResIOStream(std::move(readResult.mValue));
+  }
+
+  void Close(Assimp::IOStream* stream) override {
+    delete stream;
   }
 
+private:
+  Ds::Vector<std::string>* mOpenedFiles;
+};
+
+VResult<const aiScene*> Model::Import(
+  const std::string& file,
+  Assimp::Importer* importer,
+  bool flipUvs,
+  Ds::Vector<std::string>* sourceFiles) {
   // Import the model.
   unsigned int flags =
     aiProcess_GenNormals | aiProcess_Triangulate | aiProcess_SortByPType;
   if (flipUvs) {
     flags |= aiProcess_FlipUVs;
   }
-  const aiScene* scene = importer->ReadFile(resolvedFile, flags);
+  Rsl::StageTimer importTimer(Rsl::LoadStats::Stage::Import);
+  // The importer only takes ownership of a non-null IO handler, so resetting
+  // the handler leaves this one to be destroyed here.
+  ResIOSystem ioSystem(sourceFiles);
+  importer->SetIOHandler(&ioSystem);
+  const aiScene* scene = importer->ReadFile(file, flags);
+  importer->SetIOHandler(nullptr);
   bool sceneCreated = scene != nullptr && scene->mRootNode != nullptr;
   if (!sceneCreated || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) {
     return Result(
@@ -62,6 +154,14 @@ void Model::EditConfig(Vlk::Value* configValP) {
   shaderIdVal = shaderId;
 }
 
+void Model::CollectDependencies(
+  const Vlk::Explorer& configEx, Ds::Vector<ResId>* dependencies) {
+  Vlk::Explorer shaderIdEx = configEx("ShaderId");
+  if (shaderIdEx.Valid(Vlk::Value::Type::TrueValue)) {
+    dependencies->Push(shaderIdEx.As<ResId>());
+  }
+}
+
 Result Model::Init(const Vlk::Explorer& configEx) {
   // Get the file to import.
   Vlk::Explorer fileEx = configEx("File");
@@ -73,7 +173,8 @@ Result Model::Init(const Vlk::Explorer& configEx) {
   // Import the model.
   bool flipUvs = configEx("FlipUvs").As<bool>(false);
   Assimp::Importer importer;
-  VResult<const aiScene*> result = Import(file, &importer, flipUvs);
+  VResult<const aiScene*> result =
+    Import(file, &importer, flipUvs, nullptr);
   if (!result.Success()) {
     return std::move(result);
   }
@@ -87,8 +188,15 @@ Result Model::Init(const Vlk::Explorer& configEx) {
   ResId shaderId = shaderIdEx.As<ResId>();
   std::string directory = file.substr(0, file.find_last_of('/') + 1);
 
-  // Create all of the image resources that are embedded in the model.
+  // Reserve space for every resource the model creates so they're allocated
+  // together.
   Rsl::Asset& initAsset = Rsl::Asset::GetInitAsset();
+  initAsset.ReserveRes(
+    Rsl::Asset::ResBytes(Rsl::ResTypeId::Image, scene->mNumTextures) +
+    Rsl::Asset::ResBytes(Rsl::ResTypeId::Material, scene->mNumMaterials) +
+    Rsl::Asset::ResBytes(Rsl::ResTypeId::Mesh, scene->mNumMeshes));
+
+  // Create all of the image resources that are embedded in the model.
   Ds::Vector<std::string> embeddedImageNames;
   for (int i = 0; i < (int)scene->mNumTextures; ++i) {
     aiTexture* texture = scene->mTextures[i];
@@ -154,6 +262,29 @@ Result Model::Init(const Vlk::Explorer& configEx) {
   return Result();
 }
 
+Result Model::CollectSourceFiles(
+  const Vlk::Explorer& configEx, Ds::Vector<std::string>* sourceFiles) {
+  Vlk::Explorer fileEx = configEx("File");
+  if (!fileEx.Valid(Vlk::Value::Type::TrueValue)) {
+    return Result("Missing :File: TrueValue.");
+  }
+  std::string file = fileEx.As<std::string>();
+  bool flipUvs = configEx("FlipUvs").As<bool>(false);
+  Assimp::Importer importer;
+  VResult<const aiScene*> result =
+    Import(file, &importer, flipUvs, sourceFiles);
+  if (!result.Success()) {
+    return std::move(result);
+  }
+  const aiScene* scene = result.mValue;
+  std::string directory = file.substr(0, file.find_last_of('/') + 1);
+  for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+    Material::CollectTextureFiles(
+      *scene->mMaterials[i], directory, sourceFiles);
+  }
+  return Result();
+}
+
 size_t Model::RenderableCount() const {
   return mRenderableDescs.Size();
 }
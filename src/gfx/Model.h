@@ -20,9 +20,21 @@ struct Model {
   Model(Model&& other);
   Model& operator=(Model&& other);
 
+  // Files are read through ReadResFile, so models can be imported from the
+  // mounted pack. The paths of the files read while importing are added to
+  // sourceFiles when it isn't null.
   static VResult<const aiScene*> Import(
-    const std::string& file, Assimp::Importer* importer, bool flipUvs);
+    const std::string& file,
+    Assimp::Importer* importer,
+    bool flipUvs,
+    Ds::Vector<std::string>* sourceFiles);
   static void EditConfig(Vlk::Value* configValP);
+  static void CollectDependencies(
+    const Vlk::Explorer& configEx, Ds::Vector<ResId>* dependencies);
+  // Finds the paths of every file that initializing the model reads. These are
+  // the files that need to be packed with the model.
+  static Result CollectSourceFiles(
+    const Vlk::Explorer& configEx, Ds::Vector<std::string>* sourceFiles);
   Result Init(const Vlk::Explorer& configEx);
 
   size_t RenderableCount() const;
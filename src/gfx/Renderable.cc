@@ -1,6 +1,7 @@
 #include "gfx/Renderable.h"
 #include "Error.h"
 #include "comp/Camera.h"
+#include "debug/MemTrack.h"
 #include "ext/Tracy.h"
 #include "gfx/Material.h"
 #include "gfx/Mesh.h"
@@ -9,24 +10,30 @@
 
 namespace Gfx {
 
+constexpr float nBehindCameraInitPriority = 1.0e30f;
+
 Collection* Collection::smActiveCollection = nullptr;
+const World::Object* Collection::smActiveCameraObject = nullptr;
 
 Collection::Collection() {
   mSkybox.mOwner = World::nInvalidMemberId;
 }
 
-void Collection::Collect(const World::Space& space) {
+void Collection::Collect(
+  const World::Space& space, const World::Object* cameraObject) {
   ZoneScoped;
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::Gfx);
 
   // Collect all renderables from every component in the given space.
   smActiveCollection = this;
+  smActiveCameraObject = cameraObject;
   for (Comp::TypeId typeId = 0; typeId < Comp::TypeDataCount(); ++typeId) {
     const Comp::TypeData& typeData = Comp::GetTypeData(typeId);
     if (!typeData.mVRenderable.Open()) {
       continue;
     }
     // todo: Add CObjects (const Object).
-    Ds::Vector<World::MemberId> slice = space.Slice(typeId);
+    auto slice = space.FrameSlice(typeId);
     for (World::MemberId memberId: slice) {
       void* component = space.GetComponent(typeId, memberId);
       World::Object owner(const_cast<World::Space*>(&space), memberId);
@@ -34,9 +41,11 @@ void Collection::Collect(const World::Space& space) {
     }
   }
   smActiveCollection = nullptr;
+  smActiveCameraObject = nullptr;
 }
 
 void Collection::Collect(const World::Object& object) {
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::Gfx);
   // Collect all of the renderables on a specific object.
   smActiveCollection = this;
   for (Comp::TypeId typeId = 0; typeId < Comp::TypeDataCount(); ++typeId) {
@@ -69,6 +78,24 @@ void Collection::Add(Renderable::Icon&& icon) {
   smActiveCollection->mIcons.Push(std::move(icon));
 }
 
+float Collection::InitPriority(const Vec3& worldTranslation) {
+  if (smActiveCameraObject == nullptr) {
+    return Rsl::nLowestInitPriority;
+  }
+  const World::Object& cameraObject = *smActiveCameraObject;
+  const auto& cameraComp = cameraObject.Get<Comp::Camera>();
+  float distance =
+    cameraComp.ProjectedDistance(cameraObject, worldTranslation);
+  Vec3 toTranslation =
+    worldTranslation - cameraComp.WorldTranslation(cameraObject);
+  if (Math::Dot(toTranslation, cameraComp.WorldForward(cameraObject)) < 0.0f) {
+    // Something behind the camera can't be more urgent than something in
+    // front of it at any distance.
+    return nBehindCameraInitPriority + distance;
+  }
+  return distance;
+}
+
 void Collection::RenderFloaters() {
   ResId currentMaterialId;
   int currentTextureIndex;
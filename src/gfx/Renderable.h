@@ -39,19 +39,28 @@ struct Icon {
 } // namespace Renderable
 
 struct Collection {
-  Ds::Vector<Renderable::Floater> mFloaters;
+  // Collections only live for a frame, so their renderables are stored in the
+  // frame arena.
+  Ds::Vector<Renderable::Floater, Ds::FrameAllocator> mFloaters;
   Renderable::Skybox mSkybox;
-  Ds::Vector<Renderable::Icon> mIcons;
+  Ds::Vector<Renderable::Icon, Ds::FrameAllocator> mIcons;
   UniformVector mUniforms;
 
   Collection();
 
-  void Collect(const World::Space& space);
+  // When a camera is given, renderables can use InitPriority while they're
+  // being collected.
+  void Collect(
+    const World::Space& space, const World::Object* cameraObject = nullptr);
   void Collect(const World::Object& object);
 
   static void Add(Renderable::Floater&& floater);
   static void Use(Renderable::Skybox&& skybox);
   static void Add(Renderable::Icon&& icon);
+  // The priority of the assets needed to render something at the given
+  // translation. Assets for things closer to the camera are more urgent and
+  // things behind the camera are only more urgent than unprioritized assets.
+  static float InitPriority(const Vec3& worldTranslation);
 
   void RenderFloaters();
   bool HasSkybox() const;
@@ -61,6 +70,7 @@ struct Collection {
 private:
   static void VerifyActiveCollection();
   static Collection* smActiveCollection;
+  static const World::Object* smActiveCameraObject;
 };
 
 } // namespace Gfx
@@ -303,7 +303,7 @@ void InitializeLightsUniformBuffer(const World::Space& space) {
   const unsigned int maxDirectionalLights = 1;
   unsigned int directionalLightCount = 0;
   GLintptr offset = 16;
-  Ds::Vector<World::MemberId> slice = space.Slice<Comp::DirectionalLight>();
+  auto slice = space.FrameSlice<Comp::DirectionalLight>();
   for (int i = 0; i < slice.Size() && i < maxDirectionalLights; ++i) {
     World::Object owner(const_cast<World::Space*>(&space), slice[i]);
     auto& transform = space.Get<Comp::Transform>(slice[i]);
@@ -324,7 +324,7 @@ void InitializeLightsUniformBuffer(const World::Space& space) {
   const unsigned int maxPointLights = 100;
   unsigned int pointLightCount = 0;
   offset = 16 + maxDirectionalLights * 64;
-  slice = std::move(space.Slice<Comp::PointLight>());
+  slice = space.FrameSlice<Comp::PointLight>();
   for (int i = 0; i < slice.Size() && i < maxPointLights; ++i) {
     World::Object owner(const_cast<World::Space*>(&space), slice[i]);
     auto& transform = space.Get<Comp::Transform>(slice[i]);
@@ -347,7 +347,7 @@ void InitializeLightsUniformBuffer(const World::Space& space) {
   const unsigned int maxSpotLights = 100;
   unsigned int spotLightCount = 0;
   offset = 16 + maxDirectionalLights * 64 + maxPointLights * 80;
-  slice = std::move(space.Slice<Comp::SpotLight>());
+  slice = space.FrameSlice<Comp::SpotLight>();
   for (int i = 0; i < slice.Size() && i < maxSpotLights; ++i) {
     World::Object owner(const_cast<World::Space*>(&space), slice[i]);
     auto& transform = space.Get<Comp::Transform>(slice[i]);
@@ -383,7 +383,7 @@ void InitializeShadowUniformBuffer(
   // Determine whether the shadow exists.
   GLenum buffer = GL_UNIFORM_BUFFER;
   glBindBuffer(buffer, nShadowUniformBufferVbo);
-  Ds::Vector<World::MemberId> slice = space.Slice<Comp::ShadowMap>();
+  auto slice = space.FrameSlice<Comp::ShadowMap>();
   bool shadowExists = slice.Size() == 0 ? false : true;
   glBufferSubData(buffer, 0, sizeof(GLuint), &shadowExists);
   if (!shadowExists) {
@@ -521,7 +521,7 @@ World::MemberId HoveredMemberId(
   const World::Space& space, const World::Object& cameraObject) {
   // Render all of the MemberIds to a framebuffer.
   Collection collection;
-  collection.Collect(space);
+  collection.Collect(space, &cameraObject);
   EnsureMemberIdFbo();
   glBindFramebuffer(GL_FRAMEBUFFER, nMemberIdFbo);
   glClearBufferiv(GL_COLOR, 0, &World::nInvalidMemberId);
@@ -545,7 +545,7 @@ World::MemberId HoveredMemberId(
 
 void RenderLayer(const World::Space& space, const World::Object& cameraObject) {
   Collection collection;
-  collection.Collect(space);
+  collection.Collect(space, &cameraObject);
 
   InitializeUniversalUniformBuffer(cameraObject);
   InitializeLightsUniformBuffer(space);
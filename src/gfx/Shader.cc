@@ -9,6 +9,7 @@
 
 #include "Error.h"
 #include "Shader.h"
+#include "Viewport.h"
 #include "editor/Utility.h"
 #include "rsl/Library.h"
 #include "util/Utility.h"
@@ -28,8 +29,11 @@ Shader& Shader::operator=(Shader&& other) {
 }
 
 Shader::~Shader() {
-  glDeleteProgram(mId);
-  mId = 0;
+  if (mId != 0) {
+    Viewport::SharedContext sharedContext;
+    glDeleteProgram(mId);
+    mId = 0;
+  }
 }
 
 Shader::SubType Shader::GetSubType(const std::string& subTypeString) {
@@ -102,50 +106,84 @@ void Shader::EditConfig(Vlk::Value* configValP) {
   ImGui::EndTable();
 }
 
-Result Shader::Init(const Vlk::Explorer& configEx) {
-  // Get the names of the files containing shader source.
-  Vlk::Explorer filesEx = configEx("Files");
-  if (!filesEx.Valid(Vlk::Value::Type::ValueArray)) {
-    return Result("Missing :Files: ValueArray.");
+Result Shader::Cook(const Vlk::Explorer& configEx, Rsl::CookedRes* cookedRes) {
+  VResult<Ds::Vector<std::string>> filesResult = CollectFiles(configEx);
+  if (!filesResult.Success()) {
+    return Result(filesResult.mError);
   }
-  if (filesEx.Size() == 0) {
-    return Result("No Values in :Files:.");
+  VResult<Ds::Vector<CompileInfo>> collectResult =
+    CollectAllCompileInfo(filesResult.mValue);
+  if (!collectResult.Success()) {
+    return Result(collectResult.mError);
   }
-  Ds::Vector<std::string> files;
-  for (int i = 0; i < filesEx.Size(); ++i) {
-    Vlk::Explorer fileEx = filesEx[i];
-    if (!fileEx.Valid(Vlk::Value::Type::TrueValue)) {
-      return Result(fileEx.Path() + " must be a TrueValue.");
+
+  // Every file that contributed a chunk, including the included files, is a
+  // source file of the cooked shader.
+  Rsl::Blob& blob = cookedRes->mBlob;
+  const Ds::Vector<CompileInfo>& allCompileInfo = collectResult.mValue;
+  blob.Write(allCompileInfo.Size());
+  for (const CompileInfo& compileInfo: allCompileInfo) {
+    blob.Write(compileInfo.mSource);
+    blob.Write(compileInfo.mSubType);
+    blob.Write(compileInfo.mChunks.Size());
+    for (const SourceChunk& chunk: compileInfo.mChunks) {
+      blob.Write(chunk.mFile);
+      blob.Write(chunk.mStartLine);
+      blob.Write(chunk.mEndLine);
+      blob.Write(chunk.mExcludedLines);
+
+      VResult<std::string> resolutionResult = Rsl::ResolveResPath(chunk.mFile);
+      if (resolutionResult.Success() &&
+          !cookedRes->mSourceFiles.Contains(resolutionResult.mValue)) {
+        cookedRes->mSourceFiles.Push(std::move(resolutionResult.mValue));
+      }
     }
-    files.Push(filesEx[i].As<std::string>());
   }
-  return Init(files);
+  return Result();
 }
 
-Result Shader::Init(const Ds::Vector<std::string>& files) {
-  // Get the CompileInfo contained in each of the files.
-  Result result;
+Result Shader::Init(const Vlk::Explorer& configEx) {
+  VResult<Ds::Vector<std::string>> filesResult = CollectFiles(configEx);
+  if (!filesResult.Success()) {
+    return Result(filesResult.mError);
+  }
+  return Init(filesResult.mValue);
+}
+
+Result Shader::Init(Rsl::Blob* blob) {
   Ds::Vector<CompileInfo> allCompileInfo;
-  for (const std::string& file: files) {
-    VResult<Ds::Vector<CompileInfo>> collectResult = CollectCompileInfo(file);
-    if (!collectResult.Success()) {
-      if (!result.mError.empty()) {
-        result.mError += '\n';
-      }
-      result.mError += collectResult.mError;
-    }
-    auto& collection = collectResult.mValue;
-    for (int i = 0; i < collection.Size(); ++i) {
-      allCompileInfo.Push(std::move(collection[i]));
+  size_t compileInfoCount;
+  bool success = blob->Read(&compileInfoCount);
+  for (size_t i = 0; success && i < compileInfoCount; ++i) {
+    CompileInfo compileInfo;
+    size_t chunkCount;
+    success = blob->Read(&compileInfo.mSource) &&
+      blob->Read(&compileInfo.mSubType) && blob->Read(&chunkCount);
+    for (size_t j = 0; success && j < chunkCount; ++j) {
+      SourceChunk chunk;
+      success = blob->Read(&chunk.mFile) && blob->Read(&chunk.mStartLine) &&
+        blob->Read(&chunk.mEndLine) && blob->Read(&chunk.mExcludedLines);
+      compileInfo.mChunks.Push(std::move(chunk));
     }
+    allCompileInfo.Push(std::move(compileInfo));
   }
-  if (!result.Success()) {
-    return result;
+  if (!success) {
+    return Result("Cooked shader data is malformed.");
   }
   return Init(allCompileInfo);
 }
 
+Result Shader::Init(const Ds::Vector<std::string>& files) {
+  VResult<Ds::Vector<CompileInfo>> collectResult =
+    CollectAllCompileInfo(files);
+  if (!collectResult.Success()) {
+    return Result(collectResult.mError);
+  }
+  return Init(collectResult.mValue);
+}
+
 Result Shader::Init(const Ds::Vector<CompileInfo>& allCompileInfo) {
+  Viewport::SharedContext sharedContext;
   this->~Shader();
   Result result = CreateProgram(allCompileInfo);
   if (!result.Success()) {
@@ -354,6 +392,7 @@ VResult<std::string> Shader::GetFileContent(const std::string& file) {
   std::ifstream fileStream;
   fileStream.open(resolutionResult.mValue);
   if (!fileStream.is_open()) {
+    Rsl::InvalidateResPath(file);
     return Result("Failed to open \"" + file + "\".");
   }
   std::stringstream fileContentStream;
@@ -528,4 +567,49 @@ VResult<Ds::Vector<Shader::CompileInfo>> Shader::CollectCompileInfo(
   return VResult<Ds::Vector<CompileInfo>>(std::move(collection));
 }
 
+VResult<Ds::Vector<std::string>> Shader::CollectFiles(
+  const Vlk::Explorer& configEx) {
+  // Get the names of the files containing shader source.
+  Vlk::Explorer filesEx = configEx("Files");
+  if (!filesEx.Valid(Vlk::Value::Type::ValueArray)) {
+    return Result("Missing :Files: ValueArray.");
+  }
+  if (filesEx.Size() == 0) {
+    return Result("No Values in :Files:.");
+  }
+  Ds::Vector<std::string> files;
+  for (int i = 0; i < filesEx.Size(); ++i) {
+    Vlk::Explorer fileEx = filesEx[i];
+    if (!fileEx.Valid(Vlk::Value::Type::TrueValue)) {
+      return Result(fileEx.Path() + " must be a TrueValue.");
+    }
+    files.Push(filesEx[i].As<std::string>());
+  }
+  return files;
+}
+
+VResult<Ds::Vector<Shader::CompileInfo>> Shader::CollectAllCompileInfo(
+  const Ds::Vector<std::string>& files) {
+  // Get the CompileInfo contained in each of the files.
+  Result result;
+  Ds::Vector<CompileInfo> allCompileInfo;
+  for (const std::string& file: files) {
+    VResult<Ds::Vector<CompileInfo>> collectResult = CollectCompileInfo(file);
+    if (!collectResult.Success()) {
+      if (!result.mError.empty()) {
+        result.mError += '\n';
+      }
+      result.mError += collectResult.mError;
+    }
+    auto& collection = collectResult.mValue;
+    for (int i = 0; i < collection.Size(); ++i) {
+      allCompileInfo.Push(std::move(collection[i]));
+    }
+  }
+  if (!result.Success()) {
+    return std::move(result);
+  }
+  return allCompileInfo;
+}
+
 } // namespace Gfx
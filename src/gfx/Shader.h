@@ -8,6 +8,7 @@
 #include "ds/Vector.h"
 #include "math/Matrix4.h"
 #include "math/Vector.h"
+#include "rsl/Cook.h"
 #include "vlk/Valkor.h"
 
 namespace Gfx {
@@ -54,7 +55,9 @@ struct Shader {
   };
 
   static void EditConfig(Vlk::Value* configValP);
+  static Result Cook(const Vlk::Explorer& configEx, Rsl::CookedRes* cookedRes);
   Result Init(const Vlk::Explorer& configEx);
+  Result Init(Rsl::Blob* blob);
   Result Init(const Ds::Vector<std::string>& files);
   Result Init(const Ds::Vector<CompileInfo>& allCompileInfo);
 
@@ -78,11 +81,15 @@ private:
   void InitializeUniforms();
   Result CompileSubShader(const CompileInfo& compileInfo, GLuint subShaderId);
   Result CreateProgram(const Ds::Vector<CompileInfo>& allCompileInfo);
-  int GetLineNumber(size_t until, const std::string& string);
-  VResult<std::string> GetFileContent(const std::string& filename);
-  Result HandleIncludes(Gfx::Shader::CompileInfo* compileInfo);
-  VResult<Ds::Vector<Gfx::Shader::CompileInfo>> CollectCompileInfo(
+  static int GetLineNumber(size_t until, const std::string& string);
+  static VResult<std::string> GetFileContent(const std::string& filename);
+  static Result HandleIncludes(Gfx::Shader::CompileInfo* compileInfo);
+  static VResult<Ds::Vector<Gfx::Shader::CompileInfo>> CollectCompileInfo(
     const std::string& file);
+  static VResult<Ds::Vector<Gfx::Shader::CompileInfo>> CollectAllCompileInfo(
+    const Ds::Vector<std::string>& files);
+  static VResult<Ds::Vector<std::string>> CollectFiles(
+    const Vlk::Explorer& configEx);
 };
 
 } // namespace Gfx
@@ -3,7 +3,7 @@
 
 #include <string>
 
-#include "ds/Vector.h"
+#include "ds/SmallVector.h"
 #include "gfx/Shader.h"
 
 namespace Gfx {
@@ -52,7 +52,7 @@ struct UniformVector {
     UniformTypeId mTypeId;
     size_t mByteIndex;
   };
-  Ds::Vector<UniformDescriptor> mUniformDescs;
+  Ds::SmallVector<UniformDescriptor, 4> mUniformDescs;
   char* mData;
   size_t mSize;
 
@@ -1,5 +1,9 @@
+#include <cstddef>
 #include <filesystem>
+#include <mutex>
 
+#include "debug/MemTrack.h"
+#include "ds/HashMap.h"
 #include "ext/Tracy.h"
 #include "gfx/Cubemap.h"
 #include "gfx/Font.h"
@@ -9,23 +13,63 @@
 #include "gfx/Model.h"
 #include "gfx/Shader.h"
 #include "rsl/Asset.h"
+#include "rsl/HotReload.h"
 #include "rsl/Library.h"
 
 #include "Error.h"
+#include "Viewport.h"
 
 namespace Rsl {
 
-Asset* Asset::smInitAsset = nullptr;
-std::string Asset::smInitResName = "";
+// Every resource in a bin starts on an address that's suitably aligned for any
+// resource type. Bins are allocated with new, which provides that alignment.
+constexpr size_t nResAlignment = alignof(std::max_align_t);
+constexpr size_t nMinResBinCapacity = 1024;
+
+// Maps the share keys of resources that share uploaded content to the source
+// files of their cooked data.
+std::mutex nSharedSourceFilesMutex;
+Ds::HashMap<size_t, Ds::Vector<std::string>> nSharedSourceFiles;
+
+size_t AlignResBytes(size_t byteCount) {
+  return (byteCount + nResAlignment - 1) & ~(nResAlignment - 1);
+}
+
+thread_local Asset* Asset::smInitAsset = nullptr;
+thread_local std::string Asset::smInitResName = "";
+
+Asset::UploadBudget::UploadBudget(size_t byteCount, float seconds):
+  mRemainingBytes(byteCount), mSpent(false) {
+  std::chrono::duration<float> duration(seconds);
+  mEndTime = std::chrono::steady_clock::now() +
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration);
+}
+
+bool Asset::UploadBudget::Allows(size_t byteCount) const {
+  if (!mSpent) {
+    return true;
+  }
+  return byteCount <= mRemainingBytes &&
+    std::chrono::steady_clock::now() < mEndTime;
+}
+
+void Asset::UploadBudget::Spend(size_t byteCount) {
+  mRemainingBytes -= byteCount < mRemainingBytes ? byteCount : mRemainingBytes;
+  mSpent = true;
+}
 
 Asset::Asset(const std::string& name):
   mName(name),
   mStatus(Status::Dormant),
-  mResBin(nullptr),
   mResBinSize(0),
-  mResBinCapacity(0) {}
-
-Asset::Asset(Asset&& other) {
+  mResBinCapacity(0),
+  mResByteCount(0),
+  mResGeneration(0),
+  mFinalizeIndex(0),
+  mRefCount(0),
+  mLastUseFrame(nFrame.load(std::memory_order_relaxed)) {}
+
+Asset::Asset(Asset&& other): mResGeneration(0) {
   *this = std::move(other);
 }
 
@@ -34,18 +78,29 @@ Asset& Asset::operator=(Asset&& rhs) {
   mName = std::move(rhs.mName);
   mStatus = rhs.mStatus;
   mResDescs = std::move(rhs.mResDescs);
-  mResBin = rhs.mResBin;
+  mDependencies = std::move(rhs.mDependencies);
+  mLoadStats = std::move(rhs.mLoadStats);
+  mResBins = std::move(rhs.mResBins);
   mResBinSize = rhs.mResBinSize;
   mResBinCapacity = rhs.mResBinCapacity;
+  mResByteCount = rhs.mResByteCount;
+  mFinalizeIndex = rhs.mFinalizeIndex;
+  mRefCount = rhs.mRefCount;
+  mLastUseFrame.store(rhs.mLastUseFrame.load(std::memory_order_relaxed));
 
-  rhs.mResBin = nullptr;
+  rhs.mResBins.Clear();
+  rhs.mRefCount = 0;
   rhs.mResBinSize = 0;
   rhs.mResBinCapacity = 0;
+  rhs.mResByteCount = 0;
+  // Both assets moved, so pointers to either of them can't be used.
+  ++nResGeneration;
   return *this;
 }
 
 Asset::~Asset() {
   Purge();
+  ++nResGeneration;
 }
 
 const std::string& Asset::GetName() const {
@@ -65,11 +120,43 @@ Asset::Status Asset::GetStatus() const {
   return mStatus;
 }
 
+int Asset::GetRefCount() const {
+  return mRefCount;
+}
+
+unsigned int Asset::GetLastUseFrame() const {
+  return mLastUseFrame.load(std::memory_order_relaxed);
+}
+
+unsigned int Asset::GetResGeneration() const {
+  return mResGeneration.load(std::memory_order_relaxed);
+}
+
+size_t Asset::GetCpuBytes() const {
+  return mResByteCount;
+}
+
+size_t Asset::GetGpuBytes() const {
+  size_t gpuBytes = 0;
+  for (const ResDesc& resDesc: mResDescs) {
+    gpuBytes += resDesc.mUploadedBytes;
+  }
+  return gpuBytes;
+}
+
 const Ds::Vector<Asset::ResDesc>& Asset::GetResDescs() const {
   return mResDescs;
 }
 
-void Asset::QueueInit() {
+const Ds::Vector<std::string>& Asset::GetDependencies() const {
+  return mDependencies;
+}
+
+const LoadStats& Asset::GetLoadStats() const {
+  return mLoadStats;
+}
+
+void Asset::QueueInit(float priority) {
   if (mStatus != Status::Dormant && mStatus != Status::Failed) {
     std::string error = "Asset \"" + mName + "\" already ";
     switch (mStatus) {
@@ -81,7 +168,7 @@ void Asset::QueueInit() {
     LogAbort(error.c_str());
   }
   mStatus = Status::Queued;
-  AddToInitQueue(*this);
+  AddToInitQueue(*this, priority);
 }
 
 void Asset::Init() {
@@ -94,29 +181,56 @@ void Asset::Init() {
   }
 }
 
-Result Asset::TryInit() {
+Result Asset::TryInit(float priority) {
   ZoneScoped;
   ZoneText(mName.c_str(), (size_t)mName.size());
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::Rsl);
 
   smInitAsset = this;
   mStatus = Status::Initializing;
+  mLoadStats.Clear();
+  LoadStats::Scope loadStatsScope(&mLoadStats);
+  unsigned int sharedContextUses = Viewport::SharedContextUses();
 
   VResult<Vlk::Value*> addConfigResult = AddConfig(mName);
   if (!addConfigResult.Success()) {
     mStatus = Status::Failed;
     return std::move(addConfigResult);
   }
-  Vlk::Explorer rootEx(*addConfigResult.mValue);
+  Vlk::Value& rootVal = *addConfigResult.mValue;
+  Vlk::Explorer rootEx(rootVal);
   if (!rootEx.Valid(Vlk::Value::Type::ValueArray)) {
+    RemConfig(mName);
+    smInitAsset = nullptr;
+    mStatus = Status::Failed;
     return Result("Root Value is not a ValueArray.");
   }
 
+  // Dependencies are queued before any resources are initialized so other
+  // workers can initialize them at the same time.
+  mDependencies.Clear();
+  CollectDependencies(rootEx, mName, &mDependencies);
+  QueueDependencies(mDependencies, priority);
+
+  // Size the bin for all of the resources defined in the config. Resources that
+  // create other resources, like models, reserve their own space.
+  size_t resByteCount = 0;
+  for (int i = 0; i < rootEx.Size(); ++i) {
+    std::string typeName = rootEx[i]("Type").As<std::string>("");
+    ResTypeId resTypeId = GetResTypeId(typeName);
+    if (resTypeId != ResTypeId::Invalid) {
+      resByteCount += ResBytes(resTypeId);
+    }
+  }
+  ReserveRes(resByteCount);
+
   // Initialize all of the resources in the value.
   Result initResResult;
   for (int i = 0; i < rootEx.Size(); ++i) {
-    initResResult = TryInitRes(rootEx[i]);
+    initResResult = TryInitRes(rootEx[i], rootVal[i]);
     if (!initResResult.Success()) {
       Purge();
+      RemResDependencies(mName);
       mStatus = Status::Failed;
       break;
     }
@@ -124,19 +238,50 @@ Result Asset::TryInit() {
 
   RemConfig(mName);
   smInitAsset = nullptr;
+  if (initResResult.Success()) {
+    // Most resources only stage their data, but those created with the shared
+    // context, like shaders, must complete before the main thread uses them.
+    if (Viewport::SharedContextUses() != sharedContextUses) {
+      Viewport::SharedContext sharedContext;
+      glFinish();
+    }
+    mLoadStats.EndInit();
+  }
   return initResResult;
 }
 
 void Asset::Finalize() {
-  ZoneScoped;
+  Finalize(nullptr);
+}
 
-  for (ResDesc& resDesc: mResDescs) {
-    if (resDesc.mResTypeId == ResTypeId::Mesh) {
-      Gfx::Mesh& mesh = *(Gfx::Mesh*)GetResDescData(resDesc);
-      mesh.Finalize();
+bool Asset::Finalize(UploadBudget* budget) {
+  ZoneScoped;
+  mLoadStats.BeginFinalize();
+  LoadStats::Scope loadStatsScope(&mLoadStats);
+
+  // Upload the staged data of every resource the budget allows.
+  while (mFinalizeIndex < mResDescs.Size()) {
+    ResDesc& resDesc = mResDescs[mFinalizeIndex];
+    void* res = GetResDescData(resDesc);
+    size_t stagedBytes = StagedBytes(resDesc.mResTypeId, res);
+    if (budget != nullptr) {
+      if (!budget->Allows(stagedBytes)) {
+        return false;
+      }
+      budget->Spend(stagedBytes);
     }
+    if (resDesc.mLoadStatsIndex < mLoadStats.mResStats.Size()) {
+      LoadStats::SelectRes(resDesc.mLoadStatsIndex);
+    }
+    else {
+      LoadStats::SelectRes(LoadStats::smNoRes);
+    }
+    StageTimer uploadTimer(LoadStats::Stage::Upload);
+    resDesc.mUploadedBytes = Upload(resDesc.mResTypeId, res);
+    ++mFinalizeIndex;
   }
   mStatus = Status::Live;
+  return true;
 }
 
 void Asset::InitFinalize() {
@@ -144,6 +289,85 @@ void Asset::InitFinalize() {
   Finalize();
 }
 
+void Asset::Evict() {
+  LogAbortIf(mStatus != Status::Live, "Only live assets can be evicted.");
+  Purge();
+  RemResDependencies(mName);
+  mStatus = Status::Dormant;
+}
+
+void Asset::ReserveRes(size_t byteCount) {
+  if (byteCount == 0) {
+    return;
+  }
+  size_t alignedSize = AlignResBytes(mResBinSize);
+  if (mResBins.Empty() || alignedSize + byteCount > mResBinCapacity) {
+    AddResBin(byteCount);
+  }
+}
+
+size_t Asset::ResBytes(ResTypeId resTypeId, size_t count) {
+  const ResTypeData& resTypeData = GetResTypeData(resTypeId);
+  return AlignResBytes(resTypeData.mSize) * count;
+}
+
+void Asset::AddRef() {
+  ++mRefCount;
+}
+
+void Asset::RemRef() {
+  LogAbortIf(mRefCount == 0, "Asset reference count is already zero.");
+  --mRefCount;
+}
+
+void Asset::Touch() {
+  mLastUseFrame.store(
+    nFrame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+bool Asset::ReplaceRes(
+  ResTypeId resTypeId, const std::string& name, void* newRes) {
+  if (mStatus != Status::Live) {
+    return false;
+  }
+  for (ResDesc& resDesc: mResDescs) {
+    if (resDesc.mResTypeId != resTypeId || resDesc.mName != name) {
+      continue;
+    }
+    // The resource's address doesn't change, so the generation stays the same.
+    void* res = GetResDescData(resDesc);
+    const ResTypeData& resTypeData = GetResTypeData(resTypeId);
+    resTypeData.mDestruct(res);
+    resTypeData.mMoveConstruct(newRes, res);
+    resDesc.mUploadedBytes = Upload(resTypeId, res);
+    return true;
+  }
+  return false;
+}
+
+size_t Asset::StagedBytes(ResTypeId resTypeId, void* res) {
+  switch (resTypeId) {
+  case ResTypeId::Cubemap: return ((Gfx::Cubemap*)res)->StagedBytes();
+  case ResTypeId::Font: return ((Gfx::Font*)res)->StagedBytes();
+  case ResTypeId::Image: return ((Gfx::Image*)res)->StagedBytes();
+  case ResTypeId::Mesh: return ((Gfx::Mesh*)res)->StagedBytes();
+  default: return 0;
+  }
+}
+
+size_t Asset::Upload(ResTypeId resTypeId, void* res) {
+  size_t stagedBytes = StagedBytes(resTypeId, res);
+  bool uploaded = true;
+  switch (resTypeId) {
+  case ResTypeId::Cubemap: ((Gfx::Cubemap*)res)->Upload(); break;
+  case ResTypeId::Font: ((Gfx::Font*)res)->Upload(); break;
+  case ResTypeId::Image: uploaded = ((Gfx::Image*)res)->Upload(); break;
+  case ResTypeId::Mesh: uploaded = ((Gfx::Mesh*)res)->Upload(); break;
+  default: break;
+  }
+  return uploaded ? stagedBytes : 0;
+}
+
 Vlk::Value* Asset::TryGetResVal(
   Vlk::Value& assetVal, const std::string& resName) {
   for (int i = 0; i < assetVal.Size(); ++i) {
@@ -192,6 +416,35 @@ VResult<Ds::Vector<Asset::DefResInfo>> Asset::GetAllDefResInfo(
   return allDefResInfo;
 }
 
+void Asset::CollectDependencies(
+  const Vlk::Explorer& assetEx,
+  const std::string& assetName,
+  Ds::Vector<std::string>* dependencies) {
+  for (int i = 0; i < assetEx.Size(); ++i) {
+    Vlk::Explorer resEx = assetEx[i];
+    ResTypeId resTypeId = GetResTypeId(resEx("Type").As<std::string>(""));
+    Vlk::Explorer configEx = resEx("Config");
+    Ds::Vector<ResId> resIds;
+    switch (resTypeId) {
+    case ResTypeId::Material:
+      Gfx::Material::CollectDependencies(configEx, &resIds);
+      break;
+    case ResTypeId::Model:
+      Gfx::Model::CollectDependencies(configEx, &resIds);
+      break;
+    default: break;
+    }
+    for (const ResId& resId: resIds) {
+      const std::string& dependency = resId.GetAssetName();
+      if (dependency.empty() || dependency == assetName ||
+          dependencies->Contains(dependency)) {
+        continue;
+      }
+      dependencies->Push(dependency);
+    }
+  }
+}
+
 Asset& Asset::GetInitAsset() {
   LogAbortIf(smInitAsset == nullptr, "An asset is not being initialized.");
   return *smInitAsset;
@@ -201,7 +454,8 @@ const std::string& Asset::GetInitResName() {
   return smInitResName;
 }
 
-Result Asset::TryInitRes(const Vlk::Explorer& resEx) {
+Result Asset::TryInitRes(
+  const Vlk::Explorer& resEx, const Vlk::Value& resVal) {
   ZoneScoped;
 
   // Get the resource's name.
@@ -235,29 +489,31 @@ Result Asset::TryInitRes(const Vlk::Explorer& resEx) {
       "Resource \"" + name + "\" at \"" + resEx.Path() +
       "\" missing :Config: PairArray.");
   }
+  const Vlk::Value& configVal = *resVal.TryGetConstPair("Config");
 
   // Initialize the resource.
+  LoadStats::BeginRes(name, resTypeId);
+  StageTimer decodeTimer(LoadStats::Stage::Decode);
   Result result;
   // clang-format off
   switch (resTypeId) {
   case ResTypeId::Cubemap:
-    result = TryInitRes<Gfx::Cubemap>(name, configEx); break;
+    result = TryInitCookedRes<Gfx::Cubemap>(name, configEx, configVal); break;
   case ResTypeId::Font:
-    result = TryInitRes<Gfx::Font>(name, configEx); break;
+    result = TryInitCookedRes<Gfx::Font>(name, configEx, configVal); break;
   case ResTypeId::Image:
-    result = TryInitRes<Gfx::Image>(name, configEx); break;
+    result = TryInitSharedRes<Gfx::Image>(name, configEx, configVal); break;
   case ResTypeId::Material:
     result = TryInitRes<Gfx::Material>(name, configEx); break;
   case ResTypeId::Mesh:
-    result = TryInitRes<Gfx::Mesh>(name, configEx); break;
+    result = TryInitSharedRes<Gfx::Mesh>(name, configEx, configVal); break;
   case ResTypeId::Model:
     result = TryInitRes<Gfx::Model>(name, configEx); break;
   case ResTypeId::Shader:
-    result = TryInitRes<Gfx::Shader>(name, configEx); break;
+    result = TryInitCookedRes<Gfx::Shader>(name, configEx, configVal); break;
   default: break;
   }
   // clang-format on
-  glFinish();
   if (!result.Success()) {
     const ResTypeData& resTypeData = Rsl::GetResTypeData(resTypeId);
     return Result(
@@ -267,19 +523,52 @@ Result Asset::TryInitRes(const Vlk::Explorer& resEx) {
   return result;
 }
 
+bool Asset::TryGetSharedSourceFiles(
+  size_t shareKey, Ds::Vector<std::string>* sourceFiles) {
+  std::scoped_lock lock(nSharedSourceFilesMutex);
+  auto it = nSharedSourceFiles.Find(shareKey);
+  if (it == nSharedSourceFiles.end()) {
+    return false;
+  }
+  *sourceFiles = it->mValue;
+  return true;
+}
+
+void Asset::SetSharedSourceFiles(
+  size_t shareKey, const Ds::Vector<std::string>& sourceFiles) {
+  std::scoped_lock lock(nSharedSourceFilesMutex);
+  auto it = nSharedSourceFiles.Find(shareKey);
+  if (it == nSharedSourceFiles.end()) {
+    nSharedSourceFiles.Insert(shareKey, sourceFiles);
+  }
+  else {
+    it->mValue = sourceFiles;
+  }
+}
+
+void Asset::WatchSourceFiles(
+  const std::string& resName,
+  ResTypeId resTypeId,
+  const Ds::Vector<std::string>& sourceFiles) {
+  AddResDependencies(mName, resName, resTypeId, sourceFiles);
+}
+
 void Asset::Purge() {
+  ++mResGeneration;
   DestructResources();
-  if (mResBin != nullptr) {
-    delete[] mResBin;
-    mResBin = nullptr;
-    mResBinSize = 0;
-    mResBinCapacity = 0;
+  for (char* resBin: mResBins) {
+    delete[] resBin;
   }
+  mResBins.Clear();
+  mResBinSize = 0;
+  mResBinCapacity = 0;
+  mResByteCount = 0;
   mResDescs.Clear();
+  mFinalizeIndex = 0;
 }
 
 void* Asset::GetResDescData(const ResDesc& resDesc) {
-  return (void*)&mResBin[resDesc.mByteIndex];
+  return (void*)&mResBins[resDesc.mBinIndex][resDesc.mByteIndex];
 }
 
 VResult<Asset::ResDesc> Asset::AllocateRes(
@@ -293,51 +582,36 @@ VResult<Asset::ResDesc> Asset::AllocateRes(
     }
   }
 
-  // Create space for the new resource.
-  const ResTypeData& resTypeData = GetResTypeData(resTypeId);
-  size_t oldSize = mResBinSize;
-  size_t newSize = mResBinSize + resTypeData.mSize;
-  if (mResBinCapacity < newSize) {
-    GrowResBin(newSize);
-  }
-  mResBinSize = newSize;
-
+  // Create space for the new resource. Existing resources are never moved, so
+  // a new bin doesn't change the resource generation.
+  size_t resBytes = ResBytes(resTypeId);
+  ReserveRes(resBytes);
   ResDesc newResDesc;
   newResDesc.mResTypeId = resTypeId;
   newResDesc.mName = name;
-  if (mResDescs.Empty()) {
-    newResDesc.mByteIndex = 0;
-  }
-  else {
-    newResDesc.mByteIndex = oldSize;
-  }
+  newResDesc.mBinIndex = mResBins.Size() - 1;
+  newResDesc.mByteIndex = AlignResBytes(mResBinSize);
+  newResDesc.mUploadedBytes = 0;
+  newResDesc.mLoadStatsIndex =
+    smInitAsset == this ? LoadStats::SelectedRes() : LoadStats::smNoRes;
+  mResBinSize = newResDesc.mByteIndex + resBytes;
   mResDescs.Push(std::move(newResDesc));
   return mResDescs.Top();
 }
 
-void Asset::GrowResBin(size_t newCapacity) {
-  char* newResBin = alloc char[newCapacity];
-  if (mResBin != nullptr) {
-    MoveResources(mResBin, newResBin);
-    DestructResources();
-    delete[] mResBin;
-  }
-  mResBin = newResBin;
-  mResBinCapacity = newCapacity;
-}
-
-void Asset::MoveResources(char* fromBin, char* toBin) {
-  for (const ResDesc& resDesc: mResDescs) {
-    void* fromRes = (void*)&fromBin[resDesc.mByteIndex];
-    void* toRes = (void*)&toBin[resDesc.mByteIndex];
-    const ResTypeData& resTypeData = GetResTypeData(resDesc.mResTypeId);
-    resTypeData.mMoveConstruct(fromRes, toRes);
-  }
+void Asset::AddResBin(size_t neededCapacity) {
+  size_t capacity = mResBinCapacity * 2;
+  capacity = capacity > nMinResBinCapacity ? capacity : nMinResBinCapacity;
+  capacity = capacity > neededCapacity ? capacity : neededCapacity;
+  mResBins.Push(alloc char[capacity]);
+  mResBinSize = 0;
+  mResBinCapacity = capacity;
+  mResByteCount += capacity;
 }
 
 void Asset::DestructResources() {
   for (const ResDesc& resDesc: mResDescs) {
-    void* atRes = (void*)&mResBin[resDesc.mByteIndex];
+    void* atRes = GetResDescData(resDesc);
     const ResTypeData& resTypeData = GetResTypeData(resDesc.mResTypeId);
     resTypeData.mDestruct(atRes);
   }
@@ -1,15 +1,24 @@
 #ifndef rsl_Asset_h
 #define rsl_Asset_h
 
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <string>
 
 #include "Result.h"
 #include "ds/Vector.h"
+#include "rsl/Cook.h"
+#include "rsl/LoadStats.h"
 #include "rsl/ResourceType.h"
 #include "vlk/Valkor.h"
 
 namespace Rsl {
 
+// Queued assets with lower priority values are initialized first. Assets
+// queued without a priority are initialized after all prioritized assets.
+constexpr float nLowestInitPriority = std::numeric_limits<float>::max();
+
 struct Asset {
   // A status to indicate whether an asset or resource has been loaded or not.
   enum class Status {
@@ -24,21 +33,55 @@ struct Asset {
   struct ResourceDescriptor {
     ResTypeId mResTypeId;
     std::string mName;
+    size_t mBinIndex;
     size_t mByteIndex;
+    // The amount of data that finalizing the resource uploaded. It's 0 when the
+    // resource uses content uploaded for another resource.
+    size_t mUploadedBytes;
+    // The load stats entry of the config resource that created the resource.
+    size_t mLoadStatsIndex;
   };
   typedef ResourceDescriptor ResDesc;
 
+  // Limits the amount of staged resource data that Finalize uploads. The first
+  // upload made with a budget always happens so progress is guaranteed.
+  struct UploadBudget {
+    UploadBudget(size_t byteCount, float seconds);
+    bool Allows(size_t byteCount) const;
+    void Spend(size_t byteCount);
+
+    size_t mRemainingBytes;
+    std::chrono::steady_clock::time_point mEndTime;
+    bool mSpent;
+  };
+
 private:
   std::string mName;
   Status mStatus;
-  char* mResBin;
+  // Resources are stored in bins that are never reallocated, so a resource
+  // keeps its address until the asset is purged. The size and capacity are
+  // those of the last bin and every new bin at least doubles the capacity.
+  Ds::Vector<char*> mResBins;
   size_t mResBinSize;
   size_t mResBinCapacity;
+  size_t mResByteCount;
+  // Incremented whenever the asset's resources are destroyed.
+  std::atomic<unsigned int> mResGeneration;
   Ds::Vector<ResDesc> mResDescs;
-
-  // The asset and resource currently undergoing initialization.
-  static Asset* smInitAsset;
-  static std::string smInitResName;
+  // The index of the first resource that Finalize hasn't handled.
+  size_t mFinalizeIndex;
+  // Referenced assets are never evicted. Unreferenced assets are evicted in
+  // order of the frame they were last used on.
+  int mRefCount;
+  std::atomic<unsigned int> mLastUseFrame;
+  // The names of the assets that this asset's resources reference.
+  Ds::Vector<std::string> mDependencies;
+  // Only valid while the asset isn't being initialized.
+  LoadStats mLoadStats;
+
+  // The asset and resource currently undergoing initialization on this thread.
+  static thread_local Asset* smInitAsset;
+  static thread_local std::string smInitResName;
 
 public:
   explicit Asset(const std::string& name);
@@ -51,7 +94,14 @@ public:
   std::string GetFile() const;
   bool HasFile() const;
   Status GetStatus() const;
+  int GetRefCount() const;
+  unsigned int GetLastUseFrame() const;
+  unsigned int GetResGeneration() const;
+  size_t GetCpuBytes() const;
+  size_t GetGpuBytes() const;
   const Ds::Vector<ResDesc>& GetResDescs() const;
+  const Ds::Vector<std::string>& GetDependencies() const;
+  const LoadStats& GetLoadStats() const;
   template<typename T>
   T& GetRes(const std::string& name);
   template<typename T>
@@ -60,15 +110,36 @@ public:
   bool HasRes(const std::string& name);
 
   // For initializing or deinitializing an asset and individual resources.
-  void QueueInit();
+  void QueueInit(float priority = nLowestInitPriority);
   void Init();
-  Result TryInit();
+  // The assets this asset depends on are queued with the given priority.
+  Result TryInit(float priority = nLowestInitPriority);
   template<typename T, typename... Args>
   T& InitRes(const std::string& name, Args&&... args);
   template<typename T, typename... Args>
   VResult<T*> TryInitRes(const std::string& name, Args&&... args);
   void Finalize();
+  bool Finalize(UploadBudget* budget);
   void InitFinalize();
+  void Evict();
+  // Makes room for resources that are about to be initialized so they're
+  // stored in a single bin.
+  void ReserveRes(size_t byteCount);
+  static size_t ResBytes(ResTypeId resTypeId, size_t count = 1);
+
+  // For keeping an asset from being evicted and tracking when it's used.
+  void AddRef();
+  void RemRef();
+  void Touch();
+
+  // Replaces a live resource with a reinitialized resource of the same type.
+  // The resource keeps its place in the asset, so ResIds and pointers to it
+  // remain valid. The new resource is left in a moved-from state.
+  bool ReplaceRes(ResTypeId resTypeId, const std::string& name, void* newRes);
+  static size_t StagedBytes(ResTypeId resTypeId, void* res);
+  // Returns the number of bytes uploaded, which is 0 when the resource used
+  // content that was uploaded for another resource.
+  static size_t Upload(ResTypeId resTypeId, void* res);
 
   // A way to store basic information about an asset's defined resource.
   struct DefinedResourceInfo {
@@ -82,18 +153,45 @@ public:
     Vlk::Value& assetVal, const std::string& resName);
   static VResult<Ds::Vector<DefResInfo>> GetAllDefResInfo(
     const Vlk::Explorer& assetEx);
+  static void CollectDependencies(
+    const Vlk::Explorer& assetEx,
+    const std::string& assetName,
+    Ds::Vector<std::string>* dependencies);
 
   static Asset& GetInitAsset();
   static const std::string& GetInitResName();
 
 private:
-  Result TryInitRes(const Vlk::Explorer& configEx);
+  Result TryInitRes(const Vlk::Explorer& resEx, const Vlk::Value& resVal);
+  template<typename T>
+  VResult<T*> AddRes(const std::string& name, T&& newRes);
+  template<typename T>
+  Result TryInitCookedRes(
+    const std::string& name,
+    const Vlk::Explorer& configEx,
+    const Vlk::Value& configVal);
+  // Used for the cookable types that can share their uploaded content. A
+  // resource sharing content never reads its cooked data, so the source files
+  // it depends on are remembered for each share key.
+  template<typename T>
+  Result TryInitSharedRes(
+    const std::string& name,
+    const Vlk::Explorer& configEx,
+    const Vlk::Value& configVal);
+  static bool TryGetSharedSourceFiles(
+    size_t shareKey, Ds::Vector<std::string>* sourceFiles);
+  static void SetSharedSourceFiles(
+    size_t shareKey, const Ds::Vector<std::string>& sourceFiles);
+
+  void WatchSourceFiles(
+    const std::string& resName,
+    ResTypeId resTypeId,
+    const Ds::Vector<std::string>& sourceFiles);
 
   void Purge();
   void* GetResDescData(const ResDesc& resDesc);
   VResult<ResDesc> AllocateRes(ResTypeId resTypeId, const std::string& name);
-  void GrowResBin(size_t neededCapacity);
-  void MoveResources(char* fromBin, char* toBin);
+  void AddResBin(size_t neededCapacity);
   void DestructResources();
 };
 
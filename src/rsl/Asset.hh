@@ -19,6 +19,11 @@ VResult<T*> Asset::TryInitRes(const std::string& name, Args&&... args) {
   if (!initResult.Success()) {
     return initResult;
   }
+  return AddRes<T>(name, std::move(newRes));
+}
+
+template<typename T>
+VResult<T*> Asset::AddRes(const std::string& name, T&& newRes) {
   VResult<ResDesc> allocResult = AllocateRes(Rsl::GetResTypeId<T>(), name);
   if (!allocResult.Success()) {
     return std::move(allocResult);
@@ -30,6 +35,55 @@ VResult<T*> Asset::TryInitRes(const std::string& name, Args&&... args) {
   return newResData;
 }
 
+template<typename T>
+Result Asset::TryInitCookedRes(
+  const std::string& name,
+  const Vlk::Explorer& configEx,
+  const Vlk::Value& configVal) {
+  VResult<CookedRes> cookResult = ReadOrCookRes<T>(configEx, configVal);
+  if (!cookResult.Success()) {
+    return std::move(cookResult);
+  }
+  WatchSourceFiles(name, GetResTypeId<T>(), cookResult.mValue.mSourceFiles);
+  return TryInitRes<T>(name, &cookResult.mValue.mBlob);
+}
+
+template<typename T>
+Result Asset::TryInitSharedRes(
+  const std::string& name,
+  const Vlk::Explorer& configEx,
+  const Vlk::Value& configVal) {
+  // Resources with the same share key are made from the same file with the same
+  // options, so the content uploaded for one of them is used by all of them.
+  ResTypeId resTypeId = GetResTypeId<T>();
+  size_t shareKey = ShareKey(resTypeId, configVal);
+  Ds::Vector<std::string> sourceFiles;
+  T sharedRes;
+  if (TryGetSharedSourceFiles(shareKey, &sourceFiles) &&
+      sharedRes.TryShare(shareKey)) {
+    smInitResName = name;
+    WatchSourceFiles(name, resTypeId, sourceFiles);
+    return AddRes<T>(name, std::move(sharedRes));
+  }
+
+  VResult<CookedRes> cookResult = ReadOrCookRes<T>(configEx, configVal);
+  if (!cookResult.Success()) {
+    return std::move(cookResult);
+  }
+  const Ds::Vector<std::string>& cookedSourceFiles =
+    cookResult.mValue.mSourceFiles;
+  SetSharedSourceFiles(shareKey, cookedSourceFiles);
+  WatchSourceFiles(name, resTypeId, cookedSourceFiles);
+  smInitResName = name;
+  T newRes;
+  Result initResult = newRes.Init(&cookResult.mValue.mBlob);
+  if (!initResult.Success()) {
+    return initResult;
+  }
+  newRes.SetShareKey(shareKey);
+  return AddRes<T>(name, std::move(newRes));
+}
+
 template<typename T>
 T& Asset::GetRes(const std::string& name) {
   T* res = TryGetRes<T>(name);
@@ -0,0 +1,104 @@
+#include "Error.h"
+#include "ds/Map.h"
+#include "ds/Vector.h"
+#include "ext/Tracy.h"
+#include "rsl/Async.h"
+#include "rsl/Library.h"
+
+namespace Rsl {
+
+// Coroutines waiting on an asset are grouped by the asset, so each frame only
+// checks the status of every awaited asset once.
+Ds::Map<std::string, Ds::Vector<std::coroutine_handle<>>> nAssetAwaiters;
+Ds::Vector<std::coroutine_handle<>> nFrameAwaiters;
+
+Task Task::promise_type::get_return_object() {
+  return Task();
+}
+
+std::suspend_never Task::promise_type::initial_suspend() {
+  return std::suspend_never();
+}
+
+std::suspend_never Task::promise_type::final_suspend() noexcept {
+  return std::suspend_never();
+}
+
+void Task::promise_type::return_void() {}
+
+void Task::promise_type::unhandled_exception() {
+  LogAbort("Task coroutine threw an exception.");
+}
+
+bool FrameAwaiter::await_ready() {
+  return false;
+}
+
+void FrameAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  AwaitFrame(handle);
+}
+
+void FrameAwaiter::await_resume() {}
+
+FrameAwaiter NextFrame() {
+  return FrameAwaiter();
+}
+
+void AwaitAsset(const std::string& assetName, std::coroutine_handle<> handle) {
+  Ds::Vector<std::coroutine_handle<>>* awaiters =
+    nAssetAwaiters.TryGet(assetName);
+  if (awaiters == nullptr) {
+    awaiters = &nAssetAwaiters.Emplace(assetName);
+  }
+  awaiters->Push(handle);
+}
+
+void AwaitFrame(std::coroutine_handle<> handle) {
+  nFrameAwaiters.Push(handle);
+}
+
+void ResumeTasks() {
+  ZoneScoped;
+
+  // Coroutines that are resumed can await again, so the handles that are ready
+  // are taken out of the awaiter containers before any of them are resumed.
+  Ds::Vector<std::coroutine_handle<>> readyHandles =
+    std::move(nFrameAwaiters);
+  nFrameAwaiters.Clear();
+  Ds::Vector<std::string> readyAssetNames;
+  for (const auto& kvPair: nAssetAwaiters) {
+    const std::string& assetName = kvPair.Key();
+    switch (GetAssetStatus(assetName)) {
+    case Asset::Status::Live:
+    case Asset::Status::Failed: readyAssetNames.Push(assetName); break;
+    // The asset was evicted before the coroutines were resumed.
+    case Asset::Status::Dormant: QueueAsset(assetName); break;
+    default: break;
+    }
+  }
+  for (const std::string& assetName: readyAssetNames) {
+    for (std::coroutine_handle<> handle: nAssetAwaiters.Get(assetName)) {
+      readyHandles.Push(handle);
+    }
+    nAssetAwaiters.Remove(assetName);
+  }
+
+  for (std::coroutine_handle<> handle: readyHandles) {
+    handle.resume();
+  }
+}
+
+void PurgeTasks() {
+  for (const auto& kvPair: nAssetAwaiters) {
+    for (std::coroutine_handle<> handle: kvPair.mValue) {
+      handle.destroy();
+    }
+  }
+  nAssetAwaiters.Clear();
+  for (std::coroutine_handle<> handle: nFrameAwaiters) {
+    handle.destroy();
+  }
+  nFrameAwaiters.Clear();
+}
+
+} // namespace Rsl
@@ -0,0 +1,78 @@
+// Coroutines can wait for resources instead of calling TryGetRes every frame.
+// A coroutine that returns a Task starts running immediately and it's resumed
+// on the main thread by ResumeTasks once whatever it's waiting on is ready.
+//
+//   Rsl::Task LoadLevel() {
+//     Gfx::Model* model = co_await Rsl::LoadAsync<Gfx::Model>(modelId);
+//     co_await Rsl::NextFrame();
+//     ...
+//   }
+//
+// A suspended coroutine keeps its arguments and locals alive, so it shouldn't
+// capture references to anything that may be destroyed before it's resumed.
+
+#ifndef rsl_Async_h
+#define rsl_Async_h
+
+#include <coroutine>
+#include <string>
+
+#include "rsl/Asset.h"
+#include "rsl/Library.h"
+#include "rsl/ResourceId.h"
+
+namespace Rsl {
+
+// The return type of a coroutine that the scheduler resumes. The coroutine's
+// frame is destroyed when it completes.
+struct Task {
+  struct promise_type {
+    Task get_return_object();
+    std::suspend_never initial_suspend();
+    std::suspend_never final_suspend() noexcept;
+    void return_void();
+    void unhandled_exception();
+  };
+};
+
+// Resumes the coroutine once the resource's asset is live or failed. The result
+// is the same as TryGetRes's result would be at that point.
+template<typename T>
+struct ResAwaiter {
+  ResAwaiter(const ResId& resId, const ResId& defaultResId, float priority);
+  bool await_ready();
+  void await_suspend(std::coroutine_handle<> handle);
+  T* await_resume();
+
+  ResId mResId;
+  ResId mDefaultResId;
+  float mPriority;
+  T* mRes;
+};
+
+template<typename T>
+ResAwaiter<T> LoadAsync(
+  const ResId& resId,
+  const ResId& defaultResId = ResId(),
+  float priority = nLowestInitPriority);
+
+// Resumes the coroutine during the next call to ResumeTasks.
+struct FrameAwaiter {
+  bool await_ready();
+  void await_suspend(std::coroutine_handle<> handle);
+  void await_resume();
+};
+FrameAwaiter NextFrame();
+
+void AwaitAsset(const std::string& assetName, std::coroutine_handle<> handle);
+void AwaitFrame(std::coroutine_handle<> handle);
+// Called once per frame after HandleInitialization.
+void ResumeTasks();
+// Destroys all suspended coroutines without resuming them.
+void PurgeTasks();
+
+} // namespace Rsl
+
+#include "rsl/Async.hh"
+
+#endif
@@ -0,0 +1,37 @@
+namespace Rsl {
+
+template<typename T>
+ResAwaiter<T>::ResAwaiter(
+  const ResId& resId, const ResId& defaultResId, float priority):
+  mResId(resId),
+  mDefaultResId(defaultResId),
+  mPriority(priority),
+  mRes(nullptr) {}
+
+template<typename T>
+bool ResAwaiter<T>::await_ready() {
+  // This queues the asset when it's dormant.
+  mRes = TryGetRes<T>(mResId, mDefaultResId, mPriority);
+  return mRes != nullptr;
+}
+
+template<typename T>
+void ResAwaiter<T>::await_suspend(std::coroutine_handle<> handle) {
+  AwaitAsset(mResId.GetAssetName(), handle);
+}
+
+template<typename T>
+T* ResAwaiter<T>::await_resume() {
+  if (mRes == nullptr) {
+    mRes = TryGetRes<T>(mResId, mDefaultResId, mPriority);
+  }
+  return mRes;
+}
+
+template<typename T>
+ResAwaiter<T> LoadAsync(
+  const ResId& resId, const ResId& defaultResId, float priority) {
+  return ResAwaiter<T>(resId, defaultResId, priority);
+}
+
+} // namespace Rsl
@@ -0,0 +1,420 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "Options.h"
+#include "gfx/Cubemap.h"
+#include "gfx/Font.h"
+#include "gfx/Image.h"
+#include "gfx/Mesh.h"
+#include "gfx/Shader.h"
+#include "rsl/Cook.h"
+#include "rsl/Library.h"
+#include "rsl/LoadStats.h"
+#include "rsl/Pack.h"
+
+namespace Rsl {
+
+// The version must be incremented whenever the format of any cooked resource
+// changes so blobs written by older versions are cooked again.
+constexpr unsigned int nCookMagic = 0x4b4f4f43;
+constexpr unsigned int nCookVersion = 2;
+constexpr const char* nCookExtension = ".ck";
+constexpr size_t nFnvOffset = 14695981039346656037ull;
+constexpr size_t nFnvPrime = 1099511628211ull;
+
+bool nUseCookedRes = true;
+
+Blob::Blob(): mReadIndex(0), mViewData(nullptr), mViewSize(0) {}
+
+void Blob::View(const char* data, size_t byteCount) {
+  mData.Clear();
+  mReadIndex = 0;
+  mViewData = data;
+  mViewSize = byteCount;
+}
+
+const char* Blob::Data() const {
+  return mViewData != nullptr ? mViewData : mData.CData();
+}
+
+size_t Blob::Size() const {
+  return mViewData != nullptr ? mViewSize : mData.Size();
+}
+
+void Blob::Write(const void* data, size_t byteCount) {
+  if (mViewData != nullptr) {
+    mData.Resize(mViewSize);
+    memcpy((void*)mData.Data(), (const void*)mViewData, mViewSize);
+    mViewData = nullptr;
+    mViewSize = 0;
+  }
+  size_t writeIndex = mData.Size();
+  mData.Resize(writeIndex + byteCount);
+  memcpy((void*)(mData.Data() + writeIndex), data, byteCount);
+}
+
+void Blob::Write(const std::string& string) {
+  Write(string.size());
+  Write((const void*)string.data(), string.size());
+}
+
+bool Blob::Read(void* data, size_t byteCount) {
+  if (byteCount > Size() - mReadIndex) {
+    return false;
+  }
+  memcpy(data, (const void*)(Data() + mReadIndex), byteCount);
+  mReadIndex += byteCount;
+  return true;
+}
+
+bool Blob::Read(std::string* string) {
+  size_t size;
+  if (!Read(&size) || size > Size() - mReadIndex) {
+    return false;
+  }
+  string->assign(Data() + mReadIndex, size);
+  mReadIndex += size;
+  return true;
+}
+
+std::string CookDirectory() {
+  return Options::nConfig.mProjectDirectory + "cooked";
+}
+
+std::string CookFileName(size_t cookKey) {
+  std::stringstream fileName;
+  fileName << std::hex << std::setw(16) << std::setfill('0') << cookKey
+           << nCookExtension;
+  return fileName.str();
+}
+
+std::string CookFile(size_t cookKey) {
+  return CookDirectory() + '/' + CookFileName(cookKey);
+}
+
+std::string CookPackPath(size_t cookKey) {
+  return "cooked/" + CookFileName(cookKey);
+}
+
+size_t HashBytes(const void* data, size_t byteCount, size_t hash) {
+  // This is the 64 bit FNV-1a hash.
+  const unsigned char* bytes = (const unsigned char*)data;
+  for (size_t i = 0; i < byteCount; ++i) {
+    hash = (hash ^ bytes[i]) * nFnvPrime;
+  }
+  return hash;
+}
+
+VResult<Blob> ReadFile(const std::string& file) {
+  StageTimer readTimer(LoadStats::Stage::Read);
+  std::ifstream stream(file, std::ifstream::binary);
+  if (!stream.is_open()) {
+    return Result("Failed to open \"" + file + "\".");
+  }
+  stream.seekg(0, stream.end);
+  std::streamoff byteCount = stream.tellg();
+  stream.seekg(0, stream.beg);
+  Blob blob;
+  blob.mData.Resize((size_t)byteCount);
+  stream.read(blob.mData.Data(), byteCount);
+  if (!stream) {
+    return Result("Failed to read \"" + file + "\".");
+  }
+  AddBytesRead(blob.mData.Size());
+  return std::move(blob);
+}
+
+// A source file is only hashed again when its size or write time differs from
+// the stamp recorded when it was cooked.
+struct SourceStamp {
+  size_t mSize;
+  long long mWriteTime;
+};
+
+bool GetSourceStamp(const std::string& file, SourceStamp* stamp) {
+  std::error_code error;
+  stamp->mSize = (size_t)std::filesystem::file_size(file, error);
+  if (error) {
+    return false;
+  }
+  std::filesystem::file_time_type writeTime =
+    std::filesystem::last_write_time(file, error);
+  stamp->mWriteTime = (long long)writeTime.time_since_epoch().count();
+  return !error;
+}
+
+VResult<size_t> HashFile(const std::string& file) {
+  VResult<Blob> readResult = ReadFile(file);
+  if (!readResult.Success()) {
+    return Result(readResult.mError);
+  }
+  const Ds::Vector<char>& data = readResult.mValue.mData;
+  return HashBytes((const void*)data.CData(), data.Size(), nFnvOffset);
+}
+
+bool Cookable(ResTypeId resTypeId) {
+  switch (resTypeId) {
+  case ResTypeId::Cubemap:
+  case ResTypeId::Font:
+  case ResTypeId::Image:
+  case ResTypeId::Mesh:
+  case ResTypeId::Shader: return true;
+  default: return false;
+  }
+}
+
+size_t CookKey(ResTypeId resTypeId, const Vlk::Value& configVal) {
+  std::string typeName = GetResTypeData(resTypeId).mName;
+  std::stringstream configStream;
+  configStream << configVal;
+  std::string config = configStream.str();
+  size_t key =
+    HashBytes((const void*)typeName.data(), typeName.size(), nFnvOffset);
+  return HashBytes((const void*)config.data(), config.size(), key);
+}
+
+// The path a resource file resolves to without any relative components. The
+// path itself is used when it can't be resolved.
+std::string CanonicalResPath(const std::string& path) {
+  VResult<std::string> resolutionResult = ResolveResPath(path);
+  if (!resolutionResult.Success()) {
+    return path;
+  }
+  std::error_code error;
+  std::filesystem::path canonical =
+    std::filesystem::weakly_canonical(resolutionResult.mValue, error);
+  if (error) {
+    return resolutionResult.mValue;
+  }
+  return canonical.string();
+}
+
+size_t ShareKey(ResTypeId resTypeId, const Vlk::Value& configVal) {
+  if (configVal.GetType() != Vlk::Value::Type::PairArray) {
+    return CookKey(resTypeId, configVal);
+  }
+  Ds::Vector<const Vlk::Pair*> options;
+  for (size_t i = 0; i < configVal.Size(); ++i) {
+    options.Push(configVal.TryGetConstPair(i));
+  }
+  options.Sort([](const Vlk::Pair* a, const Vlk::Pair* b) -> bool {
+    return a->Key() > b->Key();
+  });
+
+  std::string typeName = GetResTypeData(resTypeId).mName;
+  size_t key =
+    HashBytes((const void*)typeName.data(), typeName.size(), nFnvOffset);
+  for (const Vlk::Pair* option: options) {
+    std::stringstream optionStream;
+    optionStream << option->Key() << ':';
+    if (option->Key() == "File" &&
+        option->GetType() == Vlk::Value::Type::TrueValue) {
+      optionStream << CanonicalResPath(option->As<std::string>());
+    }
+    else {
+      optionStream << (const Vlk::Value&)*option;
+    }
+    std::string optionString = optionStream.str();
+    key = HashBytes(
+      (const void*)optionString.data(), optionString.size(), key);
+  }
+  return key;
+}
+
+VResult<CookedRes> ParseCookedRes(Blob* fileP, bool validateSources) {
+  Blob& file = *fileP;
+  unsigned int magic, version;
+  if (!file.Read(&magic) || !file.Read(&version) || magic != nCookMagic) {
+    return Result("Cooked resource has an invalid header.");
+  }
+  if (version != nCookVersion) {
+    return Result("Cooked resource has an outdated version.");
+  }
+
+  // The cooked resource is stale when any of its source files changed.
+  CookedRes cookedRes;
+  size_t sourceFileCount;
+  if (!file.Read(&sourceFileCount)) {
+    return Result("Cooked resource has an invalid header.");
+  }
+  for (size_t i = 0; i < sourceFileCount; ++i) {
+    std::string sourceFile;
+    SourceStamp cookedStamp;
+    size_t cookedHash;
+    if (!file.Read(&sourceFile) || !file.Read(&cookedStamp) ||
+        !file.Read(&cookedHash)) {
+      return Result("Cooked resource has an invalid header.");
+    }
+    if (validateSources) {
+      SourceStamp stamp;
+      bool changed =
+        !GetSourceStamp(sourceFile, &stamp) || stamp.mSize != cookedStamp.mSize;
+      if (!changed && stamp.mWriteTime != cookedStamp.mWriteTime) {
+        VResult<size_t> hashResult = HashFile(sourceFile);
+        changed = !hashResult.Success() || hashResult.mValue != cookedHash;
+      }
+      if (changed) {
+        return Result("Source file \"" + sourceFile + "\" changed.");
+      }
+    }
+    cookedRes.mSourceFiles.Push(std::move(sourceFile));
+  }
+
+  // The resource's data is the rest of the file, so the file becomes the
+  // resource's blob rather than being copied into it.
+  size_t dataSize;
+  if (!file.Read(&dataSize) || dataSize != file.Size() - file.mReadIndex) {
+    return Result("Cooked resource is truncated.");
+  }
+  cookedRes.mBlob = std::move(file);
+  return std::move(cookedRes);
+}
+
+VResult<CookedRes> ReadCookedRes(size_t cookKey) {
+  if (nPack.IsOpen()) {
+    const Pack::Entry* entry = nPack.TryGetEntry(CookPackPath(cookKey));
+    if (entry != nullptr) {
+      StageTimer readTimer(LoadStats::Stage::Read);
+      AddBytesRead(entry->mStoredSize);
+      VResult<FileData> readResult = nPack.Read(*entry);
+      if (!readResult.Success()) {
+        return Result(readResult.mError);
+      }
+      // Uncompressed entries are viewed in the mapped pack and decompressed
+      // entries are moved into the blob.
+      FileData& fileData = readResult.mValue;
+      Blob file;
+      if (fileData.mOwnedData.Empty()) {
+        file.View(fileData.mData, fileData.mSize);
+      }
+      else {
+        fileData.mOwnedData.Resize(fileData.mSize);
+        file.mData = std::move(fileData.mOwnedData);
+      }
+      return ParseCookedRes(&file, false);
+    }
+  }
+  VResult<Blob> readResult = ReadFile(CookFile(cookKey));
+  if (!readResult.Success()) {
+    return Result(readResult.mError);
+  }
+  return ParseCookedRes(&readResult.mValue, true);
+}
+
+VResult<Blob> SerializeCookedRes(const CookedRes& cookedRes) {
+  Blob file;
+  file.Write(nCookMagic);
+  file.Write(nCookVersion);
+  file.Write(cookedRes.mSourceFiles.Size());
+  for (const std::string& sourceFile: cookedRes.mSourceFiles) {
+    // The stamp is taken first so a change made while hashing is noticed.
+    SourceStamp stamp;
+    if (!GetSourceStamp(sourceFile, &stamp)) {
+      return Result("Failed to stat \"" + sourceFile + "\".");
+    }
+    VResult<size_t> hashResult = HashFile(sourceFile);
+    if (!hashResult.Success()) {
+      return Result(hashResult.mError);
+    }
+    file.Write(sourceFile);
+    file.Write(stamp);
+    file.Write(hashResult.mValue);
+  }
+  const Blob& blob = cookedRes.mBlob;
+  size_t dataSize = blob.Size() - blob.mReadIndex;
+  file.Write(dataSize);
+  file.Write((const void*)(blob.Data() + blob.mReadIndex), dataSize);
+  return std::move(file);
+}
+
+Result WriteCookedRes(size_t cookKey, const CookedRes& cookedRes) {
+  VResult<Blob> serializeResult = SerializeCookedRes(cookedRes);
+  if (!serializeResult.Success()) {
+    return Result(serializeResult.mError);
+  }
+  const Blob& file = serializeResult.mValue;
+
+  // Init workers can cook the same resource at once, so every writer uses its
+  // own temporary file and the finished file is renamed into place.
+  std::error_code error;
+  std::filesystem::create_directories(CookDirectory(), error);
+  std::string cookFile = CookFile(cookKey);
+  std::stringstream tempFile;
+  tempFile << cookFile << '.'
+           << std::hash<std::thread::id>()(std::this_thread::get_id());
+  std::ofstream stream(tempFile.str(), std::ofstream::binary);
+  if (!stream.is_open()) {
+    return Result("Failed to open \"" + tempFile.str() + "\".");
+  }
+  stream.write(file.mData.CData(), file.mData.Size());
+  stream.close();
+  if (!stream) {
+    std::filesystem::remove(tempFile.str(), error);
+    return Result("Failed to write \"" + tempFile.str() + "\".");
+  }
+  std::filesystem::rename(tempFile.str(), cookFile, error);
+  if (error) {
+    std::filesystem::remove(tempFile.str(), error);
+    return Result("Failed to write \"" + cookFile + "\".");
+  }
+  return Result();
+}
+
+Result CookRes(
+  ResTypeId resTypeId, const Vlk::Explorer& configEx, CookedRes* cookedRes) {
+  switch (resTypeId) {
+  case ResTypeId::Cubemap: return Gfx::Cubemap::Cook(configEx, cookedRes);
+  case ResTypeId::Font: return Gfx::Font::Cook(configEx, cookedRes);
+  case ResTypeId::Image: return Gfx::Image::Cook(configEx, cookedRes);
+  case ResTypeId::Mesh: return Gfx::Mesh::Cook(configEx, cookedRes);
+  case ResTypeId::Shader: return Gfx::Shader::Cook(configEx, cookedRes);
+  default: break;
+  }
+  std::string typeName = GetResTypeData(resTypeId).mName;
+  return Result(typeName + " resources can't be cooked.");
+}
+
+Result CookAsset(const std::string& assetName) {
+  VResult<Vlk::Value*> addConfigResult = AddConfig(assetName);
+  if (!addConfigResult.Success()) {
+    return Result(addConfigResult.mError);
+  }
+  Vlk::Value& rootVal = *addConfigResult.mValue;
+  Vlk::Explorer rootEx(rootVal);
+  if (!rootEx.Valid(Vlk::Value::Type::ValueArray)) {
+    RemConfig(assetName);
+    return Result("Root Value is not a ValueArray.");
+  }
+
+  // Cook every cookable resource and collect the errors of those that fail.
+  Result result;
+  for (int i = 0; i < rootEx.Size(); ++i) {
+    Vlk::Explorer resEx = rootEx[i];
+    ResTypeId resTypeId = GetResTypeId(resEx("Type").As<std::string>(""));
+    const Vlk::Value* configVal = rootVal[i].TryGetConstPair("Config");
+    if (!Cookable(resTypeId) || configVal == nullptr) {
+      continue;
+    }
+    CookedRes cookedRes;
+    Result cookResult = CookRes(resTypeId, resEx("Config"), &cookedRes);
+    if (cookResult.Success()) {
+      cookResult = WriteCookedRes(CookKey(resTypeId, *configVal), cookedRes);
+    }
+    if (!cookResult.Success()) {
+      if (!result.mError.empty()) {
+        result.mError += '\n';
+      }
+      result.mError += "Resource at \"" + resEx.Path() +
+        "\" failed cooking.\n" + cookResult.mError;
+    }
+  }
+  RemConfig(assetName);
+  return result;
+}
+
+} // namespace Rsl
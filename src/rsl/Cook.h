@@ -0,0 +1,102 @@
+// Cooking moves the expensive processing of a resource's source files (image
+// decoding, include expansion, glyph rasterization) out of initialization. The
+// processed data is stored in the cook directory and keyed by the hash of the
+// resource's type and config. A cooked resource also records the size, write
+// time, and content hash of its source files. It is only used while all of
+// those hashes still match, and a source file is only hashed again when its
+// size or write time changed.
+//
+// Models aren't cookable yet. Importing a model creates the images, materials,
+// and meshes it contains as separate resources, so its cooked form would need
+// to hold all of them. Models are imported from their source files every time
+// they're initialized, so a pack holds the source files of its models.
+
+#ifndef rsl_Cook_h
+#define rsl_Cook_h
+
+#include <string>
+
+#include "Result.h"
+#include "ds/Vector.h"
+#include "rsl/ResourceType.h"
+#include "vlk/Valkor.h"
+
+namespace Rsl {
+
+// A byte buffer that cooked resource data is written to and read from. Reads
+// return false instead of running past the end of the data. A blob can also
+// view data that it doesn't own so it's read without a copy.
+struct Blob {
+  Blob();
+
+  // The viewed data must outlive the blob. Writing to a view copies the viewed
+  // data into the blob first.
+  void View(const char* data, size_t byteCount);
+  const char* Data() const;
+  size_t Size() const;
+
+  void Write(const void* data, size_t byteCount);
+  template<typename T>
+  void Write(const T& value);
+  void Write(const std::string& string);
+  template<typename T>
+  void Write(const Ds::Vector<T>& vector);
+
+  bool Read(void* data, size_t byteCount);
+  template<typename T>
+  bool Read(T* value);
+  bool Read(std::string* string);
+  template<typename T>
+  bool Read(Ds::Vector<T>* vector);
+
+  Ds::Vector<char> mData;
+  size_t mReadIndex;
+
+private:
+  const char* mViewData;
+  size_t mViewSize;
+};
+
+struct CookedResource {
+  // The resolved paths of the files that the resource was processed from.
+  Ds::Vector<std::string> mSourceFiles;
+  Blob mBlob;
+};
+typedef CookedResource CookedRes;
+
+// When false, cooked data is never read or written. Resources are still cooked
+// in memory, so they're processed from their source files every time and their
+// source files are still known to hot reloading.
+extern bool nUseCookedRes;
+std::string CookDirectory();
+// The path of a cooked resource within a pack.
+std::string CookPackPath(size_t cookKey);
+
+bool Cookable(ResTypeId resTypeId);
+size_t CookKey(ResTypeId resTypeId, const Vlk::Value& configVal);
+// Resources with the same share key can share their uploaded content. The key
+// uses the resolved path of the config's file and the config's other options
+// in key order, so configs that refer to the same file through different paths
+// have the same key.
+size_t ShareKey(ResTypeId resTypeId, const Vlk::Value& configVal);
+// A cooked resource in the mounted pack is always used because the pack doesn't
+// contain its source files. The blob of an uncompressed pack entry views the
+// mapped pack, so it's only valid while the pack is mounted.
+VResult<CookedRes> ReadCookedRes(size_t cookKey);
+// Only the unread part of the cooked resource's blob is serialized.
+VResult<Blob> SerializeCookedRes(const CookedRes& cookedRes);
+Result WriteCookedRes(size_t cookKey, const CookedRes& cookedRes);
+Result CookRes(
+  ResTypeId resTypeId, const Vlk::Explorer& configEx, CookedRes* cookedRes);
+Result CookAsset(const std::string& assetName);
+// Reads the resource's cooked data when it's valid and cooks it when it's not.
+// Only cooks when nUseCookedRes is false.
+template<typename T>
+VResult<CookedRes> ReadOrCookRes(
+  const Vlk::Explorer& configEx, const Vlk::Value& configVal);
+
+} // namespace Rsl
+
+#include "rsl/Cook.hh"
+
+#endif
@@ -0,0 +1,62 @@
+#include <type_traits>
+
+namespace Rsl {
+
+template<typename T>
+void Blob::Write(const T& value) {
+  static_assert(
+    std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+  Write((const void*)&value, sizeof(T));
+}
+
+template<typename T>
+void Blob::Write(const Ds::Vector<T>& vector) {
+  static_assert(
+    std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+  Write(vector.Size());
+  Write((const void*)vector.CData(), vector.Size() * sizeof(T));
+}
+
+template<typename T>
+bool Blob::Read(T* value) {
+  static_assert(
+    std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+  return Read((void*)value, sizeof(T));
+}
+
+template<typename T>
+bool Blob::Read(Ds::Vector<T>* vector) {
+  static_assert(
+    std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+  size_t size;
+  if (!Read(&size) || size > (Size() - mReadIndex) / sizeof(T)) {
+    return false;
+  }
+  vector->Clear();
+  vector->Resize(size);
+  return Read((void*)vector->Data(), size * sizeof(T));
+}
+
+template<typename T>
+VResult<CookedRes> ReadOrCookRes(
+  const Vlk::Explorer& configEx, const Vlk::Value& configVal) {
+  size_t cookKey = CookKey(GetResTypeId<T>(), configVal);
+  if (nUseCookedRes) {
+    VResult<CookedRes> readResult = ReadCookedRes(cookKey);
+    if (readResult.Success()) {
+      return readResult;
+    }
+  }
+  CookedRes cookedRes;
+  Result cookResult = T::Cook(configEx, &cookedRes);
+  if (!cookResult.Success()) {
+    return std::move(cookResult);
+  }
+  // Failing to write only means the resource is cooked again next time.
+  if (nUseCookedRes) {
+    WriteCookedRes(cookKey, cookedRes);
+  }
+  return std::move(cookedRes);
+}
+
+} // namespace Rsl
@@ -0,0 +1,493 @@
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Error.h"
+#include "ds/Map.h"
+#include "ext/Tracy.h"
+#include "gfx/Cubemap.h"
+#include "gfx/Font.h"
+#include "gfx/Image.h"
+#include "gfx/Mesh.h"
+#include "gfx/Shader.h"
+#include "rsl/Cook.h"
+#include "rsl/HotReload.h"
+#include "rsl/Library.h"
+
+namespace Rsl {
+
+struct ResDependent {
+  std::string mAssetName;
+  std::string mResName;
+  ResTypeId mResTypeId;
+
+  bool operator==(const ResDependent& other) const {
+    return mResTypeId == other.mResTypeId && mAssetName == other.mAssetName &&
+      mResName == other.mResName;
+  }
+};
+
+// The reload worker creates the reinitialized resource and the main thread
+// moves it into the dependent's asset.
+struct Reload {
+  ResDependent mDependent;
+  char* mRes;
+  // The share key of an image or mesh or 0.
+  size_t mShareKey;
+};
+
+bool nUseHotReload = true;
+
+struct SourceFile {
+  Ds::Vector<ResDependent> mDependents;
+  // The watch on the source file's directory or -1 when it isn't watched.
+  int mWatchDescriptor;
+};
+
+// Maps the canonical path of a source file to the resources that use it. The
+// mutex also guards the watched directories.
+std::mutex nDependentsMutex;
+Ds::Map<std::string, SourceFile> nDependents;
+
+std::mutex nReloadMutex;
+Ds::Vector<ResDependent> nPendingReloads;
+Ds::Vector<Reload> nFinishedReloads;
+std::thread nReloadWorker;
+std::atomic<bool> nReloadWorkerRunning = false;
+// The share keys unshared during the current round of reloads. The first
+// reloaded resource with one of these keys shares its new content and the
+// resources reloaded after it use that content. Only used by the main thread.
+Ds::Vector<size_t> nUnsharedKeys;
+
+#ifdef __linux__
+// A directory is watched because it's within a resource directory or because
+// it contains source files with dependents. The watch is removed once neither
+// is true.
+struct WatchDirectory {
+  std::string mPath;
+  bool mResDirectory;
+  int mSourceFileCount;
+};
+
+int nInotifyFd = -1;
+Ds::Map<int, WatchDirectory> nWatchDirectories;
+#endif
+
+std::string CanonicalPath(const std::string& path) {
+  std::error_code error;
+  std::filesystem::path canonical =
+    std::filesystem::weakly_canonical(path, error);
+  if (error) {
+    return path;
+  }
+  return canonical.string();
+}
+
+#ifdef __linux__
+// The functions that modify the watches expect nDependentsMutex to be locked.
+WatchDirectory* AddWatch(const std::string& directory, int* watchDescriptor) {
+  uint32_t mask =
+    IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE;
+  *watchDescriptor = inotify_add_watch(nInotifyFd, directory.c_str(), mask);
+  if (*watchDescriptor < 0) {
+    return nullptr;
+  }
+  // Adding a watch to a watched directory gives the existing descriptor.
+  WatchDirectory* watchDirectory = nWatchDirectories.TryGet(*watchDescriptor);
+  if (watchDirectory == nullptr) {
+    watchDirectory = &nWatchDirectories.Insert(
+      *watchDescriptor, {directory, false, 0});
+  }
+  return watchDirectory;
+}
+
+void WatchResDirectory(const std::string& directory) {
+  std::error_code error;
+  if (!std::filesystem::is_directory(directory, error)) {
+    return;
+  }
+  int watchDescriptor;
+  WatchDirectory* watchDirectory = AddWatch(directory, &watchDescriptor);
+  if (watchDirectory == nullptr || watchDirectory->mResDirectory) {
+    return;
+  }
+  // inotify doesn't watch subdirectories, so every directory gets a watch.
+  watchDirectory->mResDirectory = true;
+  std::filesystem::directory_iterator it(directory, error);
+  for (const std::filesystem::directory_entry& entry: it) {
+    if (entry.is_directory(error)) {
+      WatchResDirectory(entry.path().string());
+    }
+  }
+}
+
+void WatchSourceFile(const std::string& path, SourceFile* sourceFile) {
+  // Source files can be outside of the resource directories, so their
+  // directories are watched as well.
+  std::string directory = std::filesystem::path(path).parent_path().string();
+  WatchDirectory* watchDirectory =
+    AddWatch(directory, &sourceFile->mWatchDescriptor);
+  if (watchDirectory != nullptr) {
+    ++watchDirectory->mSourceFileCount;
+  }
+}
+
+void UnwatchSourceFile(const SourceFile& sourceFile) {
+  WatchDirectory* watchDirectory =
+    nWatchDirectories.TryGet(sourceFile.mWatchDescriptor);
+  if (watchDirectory == nullptr) {
+    return;
+  }
+  --watchDirectory->mSourceFileCount;
+  if (watchDirectory->mSourceFileCount == 0 && !watchDirectory->mResDirectory) {
+    inotify_rm_watch(nInotifyFd, sourceFile.mWatchDescriptor);
+    nWatchDirectories.Remove(sourceFile.mWatchDescriptor);
+  }
+}
+
+void ReadWatchEvents() {
+  alignas(inotify_event) char buffer[4096];
+  while (true) {
+    ssize_t length = read(nInotifyFd, buffer, sizeof(buffer));
+    if (length <= 0) {
+      return;
+    }
+    const char* at = buffer;
+    while (at < buffer + length) {
+      const inotify_event* event = (const inotify_event*)at;
+      at += sizeof(inotify_event) + event->len;
+      nDependentsMutex.lock();
+      WatchDirectory* watchDirectory = nWatchDirectories.TryGet(event->wd);
+      if (watchDirectory == nullptr) {
+        nDependentsMutex.unlock();
+        continue;
+      }
+      // The watch was removed because its directory was deleted.
+      if (event->mask & IN_IGNORED) {
+        nWatchDirectories.Remove(event->wd);
+        nDependentsMutex.unlock();
+        continue;
+      }
+      std::string path = watchDirectory->mPath + '/' + event->name;
+      bool resDirectory = watchDirectory->mResDirectory;
+      if (event->len != 0 && (event->mask & IN_ISDIR) && resDirectory) {
+        WatchResDirectory(path);
+      }
+      nDependentsMutex.unlock();
+
+      if (event->len == 0) {
+        continue;
+      }
+      if (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)) {
+        ClearResPathCache();
+      }
+      if (!(event->mask & IN_ISDIR) &&
+          (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))) {
+        QueueReloads(path);
+      }
+    }
+  }
+}
+#endif
+
+void InitHotReload() {
+  if (!nUseHotReload) {
+    return;
+  }
+#ifdef __linux__
+  nInotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (nInotifyFd < 0) {
+    LogError("Failed to initialize inotify. Hot reloading is disabled.");
+    return;
+  }
+  std::scoped_lock lock(nDependentsMutex);
+  WatchResDirectory(VARKOR_WORKING_DIRECTORY + std::string("vres"));
+  WatchResDirectory(ResDirectory());
+  if (!ExtraResDirectory().empty()) {
+    WatchResDirectory(ExtraResDirectory());
+  }
+#endif
+}
+
+void DeleteReloadRes(const Reload& reload) {
+  const ResTypeData& resTypeData =
+    GetResTypeData(reload.mDependent.mResTypeId);
+  resTypeData.mDestruct(reload.mRes);
+  delete[] reload.mRes;
+}
+
+void PurgeHotReload() {
+  nReloadMutex.lock();
+  nPendingReloads.Clear();
+  nReloadMutex.unlock();
+  if (nReloadWorker.joinable()) {
+    nReloadWorker.join();
+  }
+  for (const Reload& reload: nFinishedReloads) {
+    DeleteReloadRes(reload);
+  }
+  nFinishedReloads.Clear();
+  nUnsharedKeys.Clear();
+  nDependents.Clear();
+
+#ifdef __linux__
+  if (nInotifyFd >= 0) {
+    close(nInotifyFd);
+    nInotifyFd = -1;
+  }
+  nWatchDirectories.Clear();
+#endif
+}
+
+void AddResDependencies(
+  const std::string& assetName,
+  const std::string& resName,
+  ResTypeId resTypeId,
+  const Ds::Vector<std::string>& sourceFiles) {
+  ResDependent dependent;
+  dependent.mAssetName = assetName;
+  dependent.mResName = resName;
+  dependent.mResTypeId = resTypeId;
+  std::scoped_lock lock(nDependentsMutex);
+  for (const std::string& sourceFile: sourceFiles) {
+    std::string path = CanonicalPath(sourceFile);
+    SourceFile* file = nDependents.TryGet(path);
+    if (file == nullptr) {
+      file = &nDependents.Emplace(path);
+      file->mWatchDescriptor = -1;
+#ifdef __linux__
+      if (nInotifyFd >= 0) {
+        WatchSourceFile(path, file);
+      }
+#endif
+    }
+    if (!file->mDependents.Contains(dependent)) {
+      file->mDependents.Push(dependent);
+    }
+  }
+}
+
+void RemResDependencies(const std::string& assetName) {
+  std::scoped_lock lock(nDependentsMutex);
+  Ds::Vector<std::string> unusedPaths;
+  for (auto& kvPair: nDependents) {
+    Ds::Vector<ResDependent>& dependents = kvPair.mValue.mDependents;
+    for (size_t i = 0; i < dependents.Size();) {
+      if (dependents[i].mAssetName == assetName) {
+        dependents.LazyRemove(i);
+      }
+      else {
+        ++i;
+      }
+    }
+    if (dependents.Empty()) {
+      unusedPaths.Push(kvPair.Key());
+    }
+  }
+  for (const std::string& path: unusedPaths) {
+#ifdef __linux__
+    UnwatchSourceFile(nDependents.Get(path));
+#endif
+    nDependents.Remove(path);
+  }
+}
+
+void QueueReloads(const std::string& changedFile) {
+  Ds::Vector<ResDependent> dependents;
+  nDependentsMutex.lock();
+  SourceFile* sourceFile = nDependents.TryGet(CanonicalPath(changedFile));
+  if (sourceFile != nullptr) {
+    dependents = sourceFile->mDependents;
+  }
+  nDependentsMutex.unlock();
+
+  // Editors often write a file multiple times when saving, so a resource is
+  // only queued once.
+  std::scoped_lock lock(nReloadMutex);
+  for (const ResDependent& dependent: dependents) {
+    if (!nPendingReloads.Contains(dependent)) {
+      nPendingReloads.Push(dependent);
+    }
+  }
+}
+
+template<typename T>
+Result InitReloadRes(
+  Reload* reload, const Vlk::Explorer& configEx, const Vlk::Value& configVal) {
+  // The changed source file invalidates the cooked resource, so this cooks the
+  // resource again.
+  VResult<CookedRes> cookResult = ReadOrCookRes<T>(configEx, configVal);
+  if (!cookResult.Success()) {
+    return std::move(cookResult);
+  }
+  T res;
+  Result result = res.Init(&cookResult.mValue.mBlob);
+  if (!result.Success()) {
+    return result;
+  }
+
+  // The resource may depend on new files, like a shader with a new include.
+  const ResDependent& dependent = reload->mDependent;
+  AddResDependencies(
+    dependent.mAssetName,
+    dependent.mResName,
+    dependent.mResTypeId,
+    cookResult.mValue.mSourceFiles);
+  reload->mRes = alloc char[sizeof(T)];
+  GetResTypeData<T>().mMoveConstruct(&res, reload->mRes);
+  return Result();
+}
+
+Result InitReloadRes(Reload* reload) {
+  // The resource is reinitialized with the config that's currently on disk.
+  const ResDependent& dependent = reload->mDependent;
+  VResult<Vlk::Value*> addConfigResult = AddConfig(dependent.mAssetName);
+  if (!addConfigResult.Success()) {
+    return std::move(addConfigResult);
+  }
+  Result result;
+  Vlk::Value* resVal =
+    Asset::TryGetResVal(*addConfigResult.mValue, dependent.mResName);
+  const Vlk::Value* configVal =
+    resVal == nullptr ? nullptr : resVal->TryGetConstPair("Config");
+  if (configVal == nullptr) {
+    result = Result("The resource's config no longer exists.");
+  }
+  else {
+    Vlk::Explorer resEx(*resVal);
+    Vlk::Explorer configEx = resEx("Config");
+    // clang-format off
+    switch (dependent.mResTypeId) {
+    case ResTypeId::Cubemap:
+      result = InitReloadRes<Gfx::Cubemap>(reload, configEx, *configVal); break;
+    case ResTypeId::Font:
+      result = InitReloadRes<Gfx::Font>(reload, configEx, *configVal); break;
+    case ResTypeId::Image:
+      result = InitReloadRes<Gfx::Image>(reload, configEx, *configVal); break;
+    case ResTypeId::Mesh:
+      result = InitReloadRes<Gfx::Mesh>(reload, configEx, *configVal); break;
+    case ResTypeId::Shader:
+      result = InitReloadRes<Gfx::Shader>(reload, configEx, *configVal); break;
+    default: result = Result("The resource type can't be reloaded."); break;
+    }
+    // clang-format on
+
+    // Reloaded resources share their new content like the resources they
+    // replace shared the old content.
+    if (result.Success()) {
+      if (dependent.mResTypeId == ResTypeId::Image) {
+        reload->mShareKey = ShareKey(dependent.mResTypeId, *configVal);
+        ((Gfx::Image*)reload->mRes)->SetShareKey(reload->mShareKey);
+      }
+      else if (dependent.mResTypeId == ResTypeId::Mesh) {
+        reload->mShareKey = ShareKey(dependent.mResTypeId, *configVal);
+        ((Gfx::Mesh*)reload->mRes)->SetShareKey(reload->mShareKey);
+      }
+    }
+  }
+  RemConfig(dependent.mAssetName);
+  return result;
+}
+
+void ReloadWorkerMain() {
+  ProfileThread("Reload");
+
+  while (true) {
+    nReloadMutex.lock();
+    if (nPendingReloads.Empty()) {
+      nReloadMutex.unlock();
+      break;
+    }
+    Reload reload;
+    reload.mDependent = std::move(nPendingReloads[0]);
+    reload.mRes = nullptr;
+    reload.mShareKey = 0;
+    nPendingReloads.Remove(0);
+    nReloadMutex.unlock();
+
+    Result result = InitReloadRes(&reload);
+    if (!result.Success()) {
+      std::string error = "Resource \"" + reload.mDependent.mAssetName + ":" +
+        reload.mDependent.mResName + "\" failed reload.\n" + result.mError;
+      LogError(error.c_str());
+      continue;
+    }
+    nReloadMutex.lock();
+    nFinishedReloads.Push(std::move(reload));
+    nReloadMutex.unlock();
+  }
+  nReloadWorkerRunning = false;
+}
+
+void HandleHotReload(Asset::UploadBudget* budget) {
+  ZoneScoped;
+
+#ifdef __linux__
+  if (nInotifyFd >= 0) {
+    ReadWatchEvents();
+  }
+#endif
+
+  // The reload worker only runs while there are reloads to perform.
+  if (!nReloadWorkerRunning && nReloadWorker.joinable()) {
+    nReloadWorker.join();
+  }
+  nReloadMutex.lock();
+  bool reloadsPending = !nPendingReloads.Empty();
+  bool reloadsFinished = !nFinishedReloads.Empty();
+  nReloadMutex.unlock();
+  if (reloadsPending && !nReloadWorker.joinable()) {
+    nReloadWorkerRunning = true;
+    nReloadWorker = std::thread(ReloadWorkerMain);
+  }
+  if (!nReloadWorker.joinable() && !reloadsFinished) {
+    nUnsharedKeys.Clear();
+  }
+
+  // Replace live resources with their reloaded versions while the budget
+  // allows their uploads.
+  while (true) {
+    nReloadMutex.lock();
+    if (nFinishedReloads.Empty()) {
+      nReloadMutex.unlock();
+      return;
+    }
+    Reload reload = nFinishedReloads[0];
+    nReloadMutex.unlock();
+
+    const ResDependent& dependent = reload.mDependent;
+    size_t stagedBytes = Asset::StagedBytes(dependent.mResTypeId, reload.mRes);
+    if (!budget->Allows(stagedBytes)) {
+      return;
+    }
+    budget->Spend(stagedBytes);
+    // Resources initialized later must use the reloaded content instead of the
+    // content shared by the resources that are about to be replaced.
+    if (reload.mShareKey != 0 && !nUnsharedKeys.Contains(reload.mShareKey)) {
+      if (dependent.mResTypeId == ResTypeId::Image) {
+        Gfx::Image::Unshare(reload.mShareKey);
+      }
+      else {
+        Gfx::Mesh::Unshare(reload.mShareKey);
+      }
+      nUnsharedKeys.Push(reload.mShareKey);
+    }
+    Asset* asset = TryGetAsset(dependent.mAssetName);
+    if (asset != nullptr) {
+      asset->ReplaceRes(dependent.mResTypeId, dependent.mResName, reload.mRes);
+    }
+    DeleteReloadRes(reload);
+
+    nReloadMutex.lock();
+    nFinishedReloads.Remove(0);
+    nReloadMutex.unlock();
+  }
+}
+
+} // namespace Rsl
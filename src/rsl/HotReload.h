@@ -0,0 +1,33 @@
+// Hot reloading watches the resource directories and the directories of source
+// files for changes to the source files of cooked resources. Every resource
+// that depends on a changed file is reinitialized on the reload worker and the
+// result replaces the live resource within its asset. Watching directories is
+// only supported on Linux.
+#ifndef rsl_HotReload_h
+#define rsl_HotReload_h
+
+#include <string>
+
+#include "ds/Vector.h"
+#include "rsl/Asset.h"
+#include "rsl/ResourceType.h"
+
+namespace Rsl {
+
+extern bool nUseHotReload;
+void InitHotReload();
+void PurgeHotReload();
+void AddResDependencies(
+  const std::string& assetName,
+  const std::string& resName,
+  ResTypeId resTypeId,
+  const Ds::Vector<std::string>& sourceFiles);
+// Called when an asset's resources are purged so its source files are no longer
+// watched for it.
+void RemResDependencies(const std::string& assetName);
+void QueueReloads(const std::string& changedFile);
+void HandleHotReload(Asset::UploadBudget* budget);
+
+} // namespace Rsl
+
+#endif
@@ -1,14 +1,20 @@
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <mutex>
 #include <thread>
 
 #include "Options.h"
 #include "Result.h"
-#include "Viewport.h"
+#include "ds/HashMap.h"
 #include "ds/Map.h"
 #include "ds/Vector.h"
 #include "ext/Tracy.h"
+#include "rsl/HotReload.h"
 #include "rsl/Library.h"
+#include "rsl/LoadStats.h"
+#include "rsl/Pack.h"
+#include "vlk/Binary.h"
 
 namespace Rsl {
 
@@ -17,19 +23,74 @@ struct SharedConfig {
   int mRefCount;
 };
 
+bool nUseResPathCache = true;
+// Maps resource paths to their resolutions. A path that failed resolution maps
+// to an empty string.
+std::mutex nResPathCacheMutex;
+Ds::HashMap<std::string, std::string> nResPathCache;
+// Only written by SetExtraResDirectory, which clears the resolution cache.
 std::string nExtraResDirectory;
 Ds::RbTree<Asset> nAssets;
-Ds::Map<std::string, SharedConfig> nSharedConfigs;
-
-std::thread* nInitThread = nullptr;
-bool nStopInitThread = false;
-bool nInitThreadRunning = false;
+// Init workers add and queue the assets that the assets they initialize depend
+// on, so the asset tree is only accessed and assets are only queued while this
+// is held. Assets aren't moved when others are added, so references to them
+// remain valid after it's released.
+std::mutex nAssetsMutex;
+// SharedConfigs are allocated individually because init workers hold pointers
+// to them while other workers add and remove configs.
+std::mutex nSharedConfigsMutex;
+Ds::Map<std::string, SharedConfig*> nSharedConfigs;
+
+// Queued assets are initialized by a pool of init workers. Workers are added
+// while there is more queued work than workers and a worker exits once it finds
+// the queue empty. Exited workers are joined by the main thread.
+Ds::Vector<std::thread> nInitWorkers;
+std::atomic<bool> nStopInitWorkers = false;
+// The queue is a binary min heap. Workers take the asset with the lowest
+// priority value and the asset that was queued first among equal priorities.
+// The heap index of every queued asset is kept so its priority can be raised
+// without searching the queue.
+struct QueuedInit {
+  std::string mAssetName;
+  float mPriority;
+  size_t mSequence;
+};
 std::mutex nInitQueueMutex;
-Ds::Vector<std::string> nInitQueue;
+Ds::Vector<QueuedInit> nInitQueue;
+Ds::HashMap<std::string, size_t> nInitQueueIndices;
+size_t nInitSequence = 0;
+Ds::Vector<std::thread::id> nExitedInitWorkers;
 std::mutex nFinalizeQueueMutex;
 Ds::Vector<std::string> nFinalizeQueue;
+size_t nUploadByteBudget = 16 << 20;
+float nUploadTimeBudget = 0.002f;
+
+size_t nCpuByteBudget = (size_t)256 << 20;
+size_t nGpuByteBudget = (size_t)1 << 30;
+unsigned int nEvictionMinIdleFrames = 60;
+std::atomic<unsigned int> nFrame = 0;
+// Only the most recent evictions are kept for the report.
+constexpr size_t nMaxEvictions = 256;
+Ds::Vector<Eviction> nEvictions;
+
+// A generation of 0 is never used so zeroed cache entries are always stale.
+std::atomic<unsigned int> nResGeneration = 1;
+
+// Each thread caches the resources it has resolved. The cache is indexed by the
+// ResId's interned index, so a hit doesn't require any string work. An entry is
+// stale when any asset was moved or destroyed, because its asset pointer may be
+// invalid, or when its own asset's resources were destroyed.
+struct ResCacheEntry {
+  void* mRes;
+  Asset* mAsset;
+  ResTypeId mResTypeId;
+  unsigned int mGeneration;
+  unsigned int mAssetResGeneration;
+};
+thread_local Ds::Vector<ResCacheEntry> nResCache;
 
-Asset& NewAsset(const std::string& name) {
+// The functions that end in Locked expect the assets mutex to be held.
+Asset& NewAssetLocked(const std::string& name) {
   VResult<Ds::RbTree<Asset>::Iter> result = nAssets.Emplace(name);
   if (!result.Success()) {
     std::stringstream error;
@@ -39,33 +100,65 @@ Asset& NewAsset(const std::string& name) {
   return *result.mValue;
 }
 
+Asset& NewAsset(const std::string& name) {
+  std::scoped_lock lock(nAssetsMutex);
+  return NewAssetLocked(name);
+}
+
 Asset& AddAsset(const std::string& name) {
   Asset& asset = NewAsset(name);
   asset.Finalize();
   return asset;
 }
 
-Asset& QueueAsset(const std::string& name) {
-  Asset& asset = NewAsset(name);
-  asset.QueueInit();
+Asset& QueueAssetLocked(const std::string& name, float priority) {
+  // Evicted assets remain in the tree as dormant assets.
+  Asset* existingAsset = nAssets.TryGet(name);
+  Asset& asset =
+    existingAsset != nullptr ? *existingAsset : NewAssetLocked(name);
+  switch (asset.GetStatus()) {
+  case Asset::Status::Dormant:
+  case Asset::Status::Failed: asset.QueueInit(priority); break;
+  case Asset::Status::Queued: RaiseInitPriority(name, priority); break;
+  default: break;
+  }
   return asset;
 }
 
+Asset& QueueAsset(const std::string& name, float priority) {
+  std::scoped_lock lock(nAssetsMutex);
+  return QueueAssetLocked(name, priority);
+}
+
+void QueueDependencies(
+  const Ds::Vector<std::string>& dependencies, float priority) {
+  std::scoped_lock lock(nAssetsMutex);
+  for (const std::string& dependency: dependencies) {
+    QueueAssetLocked(dependency, priority);
+  }
+}
+
 Asset& RequireAsset(const std::string& name) {
+  // Required assets hold a single reference that's never removed, so they're
+  // never evicted.
   Asset& asset = NewAsset(name);
   asset.InitFinalize();
+  asset.AddRef();
   return asset;
 }
 
 void RemAsset(const std::string& name) {
+  std::scoped_lock lock(nAssetsMutex);
   nAssets.Remove(name);
 }
 
 Asset& GetAsset(const std::string& name) {
+  std::scoped_lock lock(nAssetsMutex);
   return nAssets.Get(name);
 }
 
 Asset* TryGetAsset(const std::string& name) {
+  std::scoped_lock lock(nAssetsMutex);
   return nAssets.TryGet(name);
 }
 
@@ -79,43 +172,67 @@ Asset::Status GetAssetStatus(const std::string& name) {
 
 VResult<Vlk::Value*> AddConfig(const std::string& assetName) {
   // Try to get the existing config.
-  SharedConfig* sharedConfig = nSharedConfigs.TryGet(assetName);
-  if (sharedConfig != nullptr) {
-    ++sharedConfig->mRefCount;
-    return &sharedConfig->mConfig;
+  std::unique_lock<std::mutex> lock(nSharedConfigsMutex);
+  SharedConfig** existingSharedConfig = nSharedConfigs.TryGet(assetName);
+  if (existingSharedConfig != nullptr) {
+    SharedConfig& sharedConfig = **existingSharedConfig;
+    ++sharedConfig.mRefCount;
+    return &sharedConfig.mConfig;
   }
+  lock.unlock();
 
-  // Resolve the asset file.
+  // Read the asset file from the mounted pack or the filesystem.
   std::string file = assetName + nAssetExtension;
-  VResult<std::string> resolutionResult = ResolveResPath(file);
-  if (!resolutionResult.Success()) {
+  VResult<FileData> readResult = ReadResFile(file);
+  if (!readResult.Success()) {
     return Result(
-      "Asset \"" + assetName + "\" add config failed.\n" +
-      resolutionResult.mError);
+      "Asset \"" + assetName + "\" add config failed.\n" + readResult.mError);
   }
-  const std::string& resolvedFile = resolutionResult.mValue;
 
-  // Load the new config.
-  SharedConfig newSharedConfig;
-  Result readResult = newSharedConfig.mConfig.Read(resolvedFile.c_str());
-  if (!readResult.Success()) {
+  // Parse the new config without holding the lock so other configs can be read
+  // at the same time.
+  SharedConfig* newSharedConfig = alloc SharedConfig;
+  StageTimer parseTimer(LoadStats::Stage::Parse);
+  const FileData& configData = readResult.mValue;
+  Vlk::Value& config = newSharedConfig->mConfig;
+  Result parseResult =
+    Vlk::IsBinary(configData.mData, configData.mSize)
+      ? config.ParseBinary(configData.mData, configData.mSize)
+      : config.Parse(configData.mData);
+  if (!parseResult.Success()) {
+    delete newSharedConfig;
     return Result(
-      "Asset \"" + assetName + "\" add config failed.\n" + readResult.mError);
+      "Asset \"" + assetName + "\" add config failed.\n" + file +
+      parseResult.mError);
   }
-  newSharedConfig.mRefCount = 1;
-  return &nSharedConfigs.Emplace(assetName, std::move(newSharedConfig)).mConfig;
+  newSharedConfig->mRefCount = 1;
+
+  // Another thread may have added the same config while it was being read.
+  lock.lock();
+  existingSharedConfig = nSharedConfigs.TryGet(assetName);
+  if (existingSharedConfig != nullptr) {
+    delete newSharedConfig;
+    SharedConfig& sharedConfig = **existingSharedConfig;
+    ++sharedConfig.mRefCount;
+    return &sharedConfig.mConfig;
+  }
+  nSharedConfigs.Insert(assetName, newSharedConfig);
+  return &newSharedConfig->mConfig;
 }
 
 void RemConfig(const std::string& assetName) {
-  SharedConfig& sharedConfig = nSharedConfigs.Get(assetName);
-  --sharedConfig.mRefCount;
-  if (sharedConfig.mRefCount == 0) {
+  std::scoped_lock lock(nSharedConfigsMutex);
+  SharedConfig* sharedConfig = nSharedConfigs.Get(assetName);
+  --sharedConfig->mRefCount;
+  if (sharedConfig->mRefCount == 0) {
     nSharedConfigs.Remove(assetName);
+    delete sharedConfig;
   }
 }
 
 Vlk::Value& GetConfig(const std::string& assetName) {
-  return nSharedConfigs.Get(assetName).mConfig;
+  std::scoped_lock lock(nSharedConfigsMutex);
+  return nSharedConfigs.Get(assetName)->mConfig;
 }
 
 void WriteConfig(const std::string& assetName) {
@@ -126,6 +243,36 @@ void WriteConfig(const std::string& assetName) {
   assetVal.Write(result.mValue.c_str());
 }
 
+void* TryGetCachedRes(const ResId& resId, ResTypeId resTypeId) {
+  unsigned int index = resId.GetIndex();
+  if (index >= nResCache.Size()) {
+    return nullptr;
+  }
+  const ResCacheEntry& entry = nResCache[index];
+  if (entry.mResTypeId != resTypeId ||
+      entry.mGeneration != nResGeneration.load(std::memory_order_relaxed) ||
+      entry.mAssetResGeneration != entry.mAsset->GetResGeneration()) {
+    return nullptr;
+  }
+  entry.mAsset->Touch();
+  return entry.mRes;
+}
+
+void CacheRes(
+  const ResId& resId, ResTypeId resTypeId, void* res, Asset* asset) {
+  unsigned int index = resId.GetIndex();
+  if (index >= nResCache.Size()) {
+    ResCacheEntry staleEntry = {nullptr, nullptr, ResTypeId::Invalid, 0, 0};
+    nResCache.Resize(index + 1, staleEntry);
+  }
+  ResCacheEntry& entry = nResCache[index];
+  entry.mRes = res;
+  entry.mAsset = asset;
+  entry.mResTypeId = resTypeId;
+  entry.mGeneration = nResGeneration.load(std::memory_order_relaxed);
+  entry.mAssetResGeneration = asset->GetResGeneration();
+}
+
 bool IsStandalone() {
   return Options::nConfig.mProjectDirectory == "";
 }
@@ -143,58 +290,207 @@ std::string PrependResDirectory(const std::string& path) {
 // an existing entry in one of the possible paths or an error when an entry
 // doesn't exist. It's analogous to include directories.
 VResult<std::string> ResolveResPath(const std::string& path) {
+  if (nUseResPathCache) {
+    std::scoped_lock lock(nResPathCacheMutex);
+    auto it = nResPathCache.Find(path);
+    if (it != nResPathCache.end()) {
+      if (it->mValue.empty()) {
+        return Result("Resource path \"" + path + "\" failed resolution.");
+      }
+      return VResult<std::string>(it->mValue);
+    }
+  }
+
+  std::string resolution;
   std::string testPaths[4] = {
     path,
     VARKOR_WORKING_DIRECTORY + path,
     PrependResDirectory(path),
     nExtraResDirectory + path};
-  for (const std::string& testPath: testPaths) {
+  for (std::string& testPath: testPaths) {
     if (std::filesystem::exists(testPath)) {
-      return VResult<std::string>(testPath);
+      resolution = std::move(testPath);
+      break;
+    }
+  }
+  if (nUseResPathCache) {
+    std::scoped_lock lock(nResPathCacheMutex);
+    if (!nResPathCache.Contains(path)) {
+      nResPathCache.Insert(path, resolution);
     }
   }
-  return Result("Resource path \"" + path + "\" failed resolution.");
+  if (resolution.empty()) {
+    return Result("Resource path \"" + path + "\" failed resolution.");
+  }
+  return VResult<std::string>(std::move(resolution));
+}
+
+void InvalidateResPath(const std::string& path) {
+  std::scoped_lock lock(nResPathCacheMutex);
+  nResPathCache.TryRemove(path);
+}
+
+void ClearResPathCache() {
+  std::scoped_lock lock(nResPathCacheMutex);
+  nResPathCache.Clear();
+}
+
+const std::string& ExtraResDirectory() {
+  return nExtraResDirectory;
+}
+
+void SetExtraResDirectory(const std::string& directory) {
+  std::scoped_lock lock(nResPathCacheMutex);
+  nExtraResDirectory = directory;
+  nResPathCache.Clear();
 }
 
 void Init() {
   RegisterResourceTypes();
+  std::error_code error;
+  if (std::filesystem::exists(PackFile(), error)) {
+    Result result = MountPack(PackFile());
+    LogAbortIf(!result.Success(), result.mError.c_str());
+  }
+  InitHotReload();
   RequireAsset(nDefaultAssetName);
 }
 
-void Purge() {
-  if (nInitThread != nullptr) {
-    nStopInitThread = true;
-    nInitThread->join();
-    delete nInitThread;
-    nInitThread = nullptr;
-    nStopInitThread = false;
+void JoinInitWorkers() {
+  for (std::thread& initWorker: nInitWorkers) {
+    initWorker.join();
+  }
+  nInitWorkers.Clear();
+  nExitedInitWorkers.Clear();
+}
+
+void JoinExitedInitWorkers() {
+  nInitQueueMutex.lock();
+  Ds::Vector<std::thread::id> exitedInitWorkers =
+    std::move(nExitedInitWorkers);
+  nExitedInitWorkers.Clear();
+  nInitQueueMutex.unlock();
+  for (const std::thread::id& id: exitedInitWorkers) {
+    for (size_t i = 0; i < nInitWorkers.Size(); ++i) {
+      if (nInitWorkers[i].get_id() == id) {
+        nInitWorkers[i].join();
+        nInitWorkers.LazyRemove(i);
+        break;
+      }
+    }
   }
+}
+
+void Purge() {
+  nStopInitWorkers = true;
+  JoinInitWorkers();
+  nStopInitWorkers = false;
+  nInitQueue.Clear();
+  nInitQueueIndices.Clear();
+  PurgeHotReload();
   nAssets.Clear();
+  UnmountPack();
+  ClearResPathCache();
+}
+
+// The functions that access the heap expect the init queue mutex to be held.
+bool MoreUrgentInit(const QueuedInit& a, const QueuedInit& b) {
+  return a.mPriority < b.mPriority ||
+    (a.mPriority == b.mPriority && a.mSequence < b.mSequence);
 }
 
-void AddToInitQueue(const Asset& asset) {
+void SwapQueuedInits(size_t a, size_t b) {
+  std::swap(nInitQueue[a], nInitQueue[b]);
+  nInitQueueIndices.Find(nInitQueue[a].mAssetName)->mValue = a;
+  nInitQueueIndices.Find(nInitQueue[b].mAssetName)->mValue = b;
+}
+
+void SiftUpInit(size_t index) {
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    if (!MoreUrgentInit(nInitQueue[index], nInitQueue[parent])) {
+      return;
+    }
+    SwapQueuedInits(index, parent);
+    index = parent;
+  }
+}
+
+void SiftDownInit(size_t index) {
+  while (true) {
+    size_t urgent = index;
+    size_t left = index * 2 + 1;
+    size_t right = left + 1;
+    if (left < nInitQueue.Size() &&
+        MoreUrgentInit(nInitQueue[left], nInitQueue[urgent])) {
+      urgent = left;
+    }
+    if (right < nInitQueue.Size() &&
+        MoreUrgentInit(nInitQueue[right], nInitQueue[urgent])) {
+      urgent = right;
+    }
+    if (urgent == index) {
+      return;
+    }
+    SwapQueuedInits(index, urgent);
+    index = urgent;
+  }
+}
+
+void AddToInitQueue(const Asset& asset, float priority) {
   if (asset.GetStatus() != Asset::Status::Queued) {
     std::string error =
       "Asset \"" + asset.GetName() + "\" lacks Queued status.";
     LogAbort(error.c_str());
   }
-  nInitQueueMutex.lock();
-  nInitQueue.Push(asset.GetName());
-  nInitQueueMutex.unlock();
+  std::scoped_lock lock(nInitQueueMutex);
+  nInitQueue.Push({asset.GetName(), priority, nInitSequence++});
+  nInitQueueIndices.Insert(asset.GetName(), nInitQueue.Size() - 1);
+  SiftUpInit(nInitQueue.Size() - 1);
+}
+
+void RaiseInitPriority(const std::string& assetName, float priority) {
+  std::scoped_lock lock(nInitQueueMutex);
+  auto it = nInitQueueIndices.Find(assetName);
+  if (it == nInitQueueIndices.end()) {
+    return;
+  }
+  QueuedInit& queuedInit = nInitQueue[it->mValue];
+  if (priority < queuedInit.mPriority) {
+    queuedInit.mPriority = priority;
+    SiftUpInit(it->mValue);
+  }
+}
+
+QueuedInit TakeMostUrgentInit() {
+  SwapQueuedInits(0, nInitQueue.Size() - 1);
+  QueuedInit urgentInit = std::move(nInitQueue.Top());
+  nInitQueue.Pop();
+  nInitQueueIndices.Remove(urgentInit.mAssetName);
+  SiftDownInit(0);
+  return urgentInit;
 }
 
 bool InitThreadOpen() {
-  return nInitThread != nullptr;
+  return !nInitWorkers.Empty();
 }
 
-void InitializationThreadMain() {
+void InitWorkerMain() {
   ProfileThread("Init");
 
-  Viewport::StartContextSharing();
-  nInitThreadRunning = true;
-  while (!nStopInitThread && !nInitQueue.Empty()) {
-    Asset& asset = GetAsset(nInitQueue[0]);
-    Result result = asset.TryInit();
+  while (true) {
+    nInitQueueMutex.lock();
+    if (nStopInitWorkers || nInitQueue.Empty()) {
+      nExitedInitWorkers.Push(std::this_thread::get_id());
+      nInitQueueMutex.unlock();
+      break;
+    }
+    QueuedInit queuedInit = TakeMostUrgentInit();
+    nInitQueueMutex.unlock();
+
+    std::string& assetName = queuedInit.mAssetName;
+    Asset& asset = GetAsset(assetName);
+    Result result = asset.TryInit(queuedInit.mPriority);
     if (!result.Success()) {
       std::string error = "Asset \"" + asset.GetName() +
         "\" initialization failed.\n" + result.mError;
@@ -202,39 +498,179 @@ void InitializationThreadMain() {
     }
     else {
       nFinalizeQueueMutex.lock();
-      nFinalizeQueue.Push(nInitQueue[0]);
+      nFinalizeQueue.Push(std::move(assetName));
       nFinalizeQueueMutex.unlock();
     }
-    nInitQueueMutex.lock();
-    nInitQueue.Remove(0);
-    nInitQueueMutex.unlock();
   }
-  Viewport::EndContextSharing();
-  nInitThreadRunning = false;
 }
 
-void HandleFinalization() {
-  while (!nFinalizeQueue.Empty()) {
+void HandleFinalization(Asset::UploadBudget* budget) {
+  // Initialized assets are finalized in order until the upload budget is spent.
+  // An asset that isn't completely finalized continues in the next call.
+  while (true) {
+    nFinalizeQueueMutex.lock();
+    if (nFinalizeQueue.Empty()) {
+      nFinalizeQueueMutex.unlock();
+      return;
+    }
     Asset& asset = GetAsset(nFinalizeQueue[0]);
-    asset.Finalize();
+    nFinalizeQueueMutex.unlock();
+    if (!asset.Finalize(budget)) {
+      return;
+    }
     nFinalizeQueueMutex.lock();
     nFinalizeQueue.Remove(0);
     nFinalizeQueueMutex.unlock();
   }
 }
 
-void HandleInitialization() {
-  // Create the thread when there are initializations to perform and delete it
-  // when there are no initializations left.
-  if (nInitThread != nullptr && !nInitThreadRunning) {
-    nInitThread->join();
-    delete nInitThread;
-    nInitThread = nullptr;
+std::string FormatBytes(size_t bytes) {
+  std::stringstream formatted;
+  formatted << std::fixed << std::setprecision(1)
+            << (float)bytes / (float)(1 << 20) << " MiB";
+  return formatted.str();
+}
+
+void EvictAssets() {
+  // Init workers don't queue assets while they're evicted.
+  std::scoped_lock lock(nAssetsMutex);
+
+  // Find the memory used by live assets and the assets that can be evicted.
+  size_t cpuBytes = 0;
+  size_t gpuBytes = 0;
+  Ds::Vector<Asset*> candidates;
+  unsigned int frame = nFrame.load(std::memory_order_relaxed);
+  for (Asset& asset: nAssets) {
+    if (asset.GetStatus() != Asset::Status::Live) {
+      continue;
+    }
+    cpuBytes += asset.GetCpuBytes();
+    gpuBytes += asset.GetGpuBytes();
+    unsigned int idleFrames = frame - asset.GetLastUseFrame();
+    if (asset.GetRefCount() == 0 && idleFrames >= nEvictionMinIdleFrames) {
+      candidates.Push(&asset);
+    }
+  }
+  if (cpuBytes <= nCpuByteBudget && gpuBytes <= nGpuByteBudget) {
+    return;
+  }
+
+  // Evict the least recently used assets until both budgets are met.
+  candidates.Sort([](const Asset* a, const Asset* b) -> bool {
+    return a->GetLastUseFrame() > b->GetLastUseFrame();
+  });
+  for (Asset* asset: candidates) {
+    if (cpuBytes <= nCpuByteBudget && gpuBytes <= nGpuByteBudget) {
+      break;
+    }
+    Eviction eviction;
+    eviction.mAssetName = asset->GetName();
+    eviction.mCpuBytes = asset->GetCpuBytes();
+    eviction.mGpuBytes = asset->GetGpuBytes();
+    eviction.mIdleFrames = frame - asset->GetLastUseFrame();
+    if (gpuBytes > nGpuByteBudget) {
+      eviction.mReason = "GPU usage " + FormatBytes(gpuBytes) +
+        " exceeded budget " + FormatBytes(nGpuByteBudget);
+    }
+    else {
+      eviction.mReason = "CPU usage " + FormatBytes(cpuBytes) +
+        " exceeded budget " + FormatBytes(nCpuByteBudget);
+    }
+    cpuBytes -= eviction.mCpuBytes;
+    gpuBytes -= eviction.mGpuBytes;
+    asset->Evict();
+
+    if (nEvictions.Size() == nMaxEvictions) {
+      nEvictions.Remove(0);
+    }
+    nEvictions.Push(std::move(eviction));
+  }
+}
+
+const Ds::Vector<Eviction>& GetEvictions() {
+  return nEvictions;
+}
+
+std::string EvictionReport() {
+  std::stringstream report;
+  for (const Eviction& eviction: nEvictions) {
+    report << "\"" << eviction.mAssetName << "\": "
+           << "CPU " << FormatBytes(eviction.mCpuBytes) << ", "
+           << "GPU " << FormatBytes(eviction.mGpuBytes) << ", "
+           << "idle " << eviction.mIdleFrames << " frames. "
+           << eviction.mReason << ".\n";
+  }
+  return report.str();
+}
+
+Result WriteLoadStats(const std::string& file) {
+  std::ofstream stream(file);
+  if (!stream.is_open()) {
+    return Result("Failed to open \"" + file + "\".");
   }
-  if (!nInitQueue.Empty() && nInitThread == nullptr) {
-    nInitThread = alloc std::thread(InitializationThreadMain);
+  bool json = std::filesystem::path(file).extension() == ".json";
+  if (json) {
+    stream << "[";
+  }
+  else {
+    LoadStats::WriteCsvHeader(stream);
+  }
+  bool first = true;
+  std::scoped_lock lock(nAssetsMutex);
+  for (const Asset& asset: nAssets) {
+    // Evicted assets are dormant, but they keep the stats of their last load.
+    Asset::Status status = asset.GetStatus();
+    const LoadStats& loadStats = asset.GetLoadStats();
+    bool finished = status == Asset::Status::Live ||
+      status == Asset::Status::Failed ||
+      (status == Asset::Status::Dormant && !loadStats.mResStats.Empty());
+    if (!finished) {
+      continue;
+    }
+    if (json) {
+      stream << (first ? "\n" : ",\n");
+      loadStats.WriteJson(stream, asset.GetName());
+    }
+    else {
+      loadStats.WriteCsv(stream, asset.GetName());
+    }
+    first = false;
+  }
+  if (json) {
+    stream << "\n]\n";
+  }
+  stream.close();
+  if (!stream) {
+    return Result("Failed to write \"" + file + "\".");
+  }
+  return Result();
+}
+
+void HandleInitialization() {
+  // Init workers are added while there are more queued initializations than
+  // running workers. Workers that have run out of work are joined first so
+  // they aren't counted as running.
+  JoinExitedInitWorkers();
+  nInitQueueMutex.lock();
+  size_t queueSize = nInitQueue.Size();
+  nInitQueueMutex.unlock();
+  // One hardware thread is left for the main thread.
+  size_t maxWorkerCount = std::thread::hardware_concurrency();
+  maxWorkerCount = maxWorkerCount > 1 ? maxWorkerCount - 1 : 1;
+  size_t runningWorkerCount = nInitWorkers.Size();
+  if (queueSize > 0 && runningWorkerCount < maxWorkerCount) {
+    size_t workerCount = maxWorkerCount - runningWorkerCount;
+    workerCount = workerCount < queueSize ? workerCount : queueSize;
+    for (size_t i = 0; i < workerCount; ++i) {
+      nInitWorkers.Emplace(InitWorkerMain);
+    }
   }
-  HandleFinalization();
+  // Finalization and hot reloading share the frame's upload budget.
+  Asset::UploadBudget budget(nUploadByteBudget, nUploadTimeBudget);
+  HandleFinalization(&budget);
+  HandleHotReload(&budget);
+  EvictAssets();
+  ++nFrame;
 }
 
 } // namespace Rsl
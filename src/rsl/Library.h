@@ -1,6 +1,7 @@
 #ifndef rsl_Library_h
 #define rsl_Library_h
 
+#include <atomic>
 #include <string>
 
 #include "Result.h"
@@ -12,10 +13,15 @@ namespace Rsl {
 
 constexpr const char* nInvalidAssetName = "vres/invalid";
 constexpr const char* nDefaultAssetName = "vres/defaults";
-extern std::string nExtraResDirectory;
 
 Asset& AddAsset(const std::string& name);
-Asset& QueueAsset(const std::string& name);
+// A queued asset has its priority raised instead. Nothing is read here. The
+// init worker that takes the asset reads its config and queues the assets it
+// depends on with the same priority before initializing its resources.
+Asset& QueueAsset(
+  const std::string& name, float priority = nLowestInitPriority);
+void QueueDependencies(
+  const Ds::Vector<std::string>& dependencies, float priority);
 Asset& RequireAsset(const std::string& name);
 void RemAsset(const std::string& name);
 Asset& GetAsset(const std::string& name);
@@ -33,21 +39,78 @@ template<typename T>
 T& GetDefaultRes();
 template<typename T>
 T& GetRes(const ResId& resId);
+// The priority is used when the resource's asset needs to be queued or is
+// already queued. See nLowestInitPriority.
 template<typename T>
-T* TryGetRes(const ResId& resId, const ResId& defaultResId = "");
+T* TryGetRes(
+  const ResId& resId,
+  const ResId& defaultResId = ResId(),
+  float priority = nLowestInitPriority);
 template<typename T>
 bool HasRes(const ResId& resId);
 
+// The generation is incremented whenever an asset is moved or destroyed. Each
+// asset also has a resource generation that's incremented whenever its
+// resources are destroyed. Anything that holds a resource pointer beyond a
+// single call can compare both to know when that pointer must be resolved
+// again. Replacing a resource keeps its address, so it changes neither.
+extern std::atomic<unsigned int> nResGeneration;
+void* TryGetCachedRes(const ResId& resId, ResTypeId resTypeId);
+void CacheRes(const ResId& resId, ResTypeId resTypeId, void* res, Asset* asset);
+
 bool IsStandalone();
 std::string ResDirectory();
 std::string PrependResDirectory(const std::string& path);
 VResult<std::string> ResolveProjPath(const std::string& path);
 VResult<std::string> ResolveResPath(const std::string& path);
+// Resolutions, including failed ones, are cached while nUseResPathCache is
+// true. Hot reloading clears the cache whenever a file is added or removed.
+// Without it, a caller that fails to open a resolved file invalidates that path
+// so it's resolved again, and the cache must be cleared for added files to be
+// found.
+// The project directory must be set before any path is resolved.
+extern bool nUseResPathCache;
+void InvalidateResPath(const std::string& path);
+void ClearResPathCache();
+// The extra directory is searched after the others. Setting it clears the
+// cache.
+const std::string& ExtraResDirectory();
+void SetExtraResDirectory(const std::string& directory);
 
 extern Ds::RbTree<Asset> nAssets;
+// The amount of staged resource data uploaded per call to HandleInitialization.
+extern size_t nUploadByteBudget;
+extern float nUploadTimeBudget;
+
+// Live assets that aren't referenced are evicted, least recently used first,
+// while the memory used by live assets exceeds either budget. An evicted asset
+// becomes dormant and it's queued again the next time one of its resources is
+// requested. Assets used within the last nEvictionMinIdleFrames are kept.
+extern size_t nCpuByteBudget;
+extern size_t nGpuByteBudget;
+extern unsigned int nEvictionMinIdleFrames;
+// The number of calls made to HandleInitialization. Assets are stamped with it
+// whenever they are used.
+extern std::atomic<unsigned int> nFrame;
+struct Eviction {
+  std::string mAssetName;
+  size_t mCpuBytes;
+  size_t mGpuBytes;
+  unsigned int mIdleFrames;
+  std::string mReason;
+};
+const Ds::Vector<Eviction>& GetEvictions();
+std::string EvictionReport();
+// Writes the load stats of every asset that has finished initialization. The
+// stats are written as JSON when the file has a .json extension and as CSV
+// otherwise.
+Result WriteLoadStats(const std::string& file);
 void Init();
 void Purge();
-void AddToInitQueue(const Asset& asset);
+void AddToInitQueue(const Asset& asset, float priority);
+// Moves a queued asset ahead of the assets with a higher priority value. A
+// priority value is never increased by this.
+void RaiseInitPriority(const std::string& assetName, float priority);
 void HandleInitialization();
 bool InitThreadOpen();
 
@@ -2,8 +2,8 @@ namespace Rsl {
 
 template<typename T>
 ResId GetDefaultResId() {
-  const ResTypeData& resTypeData = GetResTypeData<T>();
-  return ResId(nDefaultAssetName, "Default");
+  static const ResId defaultResId(nDefaultAssetName, "Default");
+  return defaultResId;
 }
 
 template<typename T>
@@ -13,34 +13,52 @@ T& GetDefaultRes() {
 
 template<typename T>
 T& GetRes(const ResId& resId) {
-  Asset& asset = nAssets.Get(resId.GetAssetName());
-  return asset.GetRes<T>(resId.GetResourceName());
+  ResTypeId resTypeId = GetResTypeId<T>();
+  void* cachedRes = TryGetCachedRes(resId, resTypeId);
+  if (cachedRes != nullptr) {
+    return *(T*)cachedRes;
+  }
+  Asset& asset = GetAsset(resId.GetAssetName());
+  T& res = asset.GetRes<T>(resId.GetResourceName());
+  asset.Touch();
+  if (asset.GetStatus() == Asset::Status::Live) {
+    CacheRes(resId, resTypeId, &res, &asset);
+  }
+  return res;
 }
 
 template<typename T>
-T* TryGetRes(const ResId& resId, const ResId& defaultResId) {
-  std::string assetName = resId.GetAssetName();
+T* TryGetRes(const ResId& resId, const ResId& defaultResId, float priority) {
+  ResTypeId resTypeId = GetResTypeId<T>();
+  void* cachedRes = TryGetCachedRes(resId, resTypeId);
+  if (cachedRes != nullptr) {
+    return (T*)cachedRes;
+  }
+
+  const std::string& assetName = resId.GetAssetName();
   switch (GetAssetStatus(assetName)) {
-  case Asset::Status::Dormant: QueueAsset(assetName);
-  case Asset::Status::Queued:
+  case Asset::Status::Dormant: QueueAsset(assetName, priority); return nullptr;
+  case Asset::Status::Queued: RaiseInitPriority(assetName, priority);
   case Asset::Status::Initializing: return nullptr;
   case Asset::Status::Failed: return &GetDefaultRes<T>();
   case Asset::Status::Live: break;
   }
   Asset& asset = GetAsset(assetName);
+  asset.Touch();
   T* res = asset.TryGetRes<T>(resId.GetResourceName());
   if (res == nullptr) {
-    if (defaultResId == "") {
+    if (defaultResId.GetId().empty()) {
       return &GetDefaultRes<T>();
     }
     return &GetRes<T>(defaultResId);
   }
+  CacheRes(resId, resTypeId, res, &asset);
   return res;
 }
 
 template<typename T>
 bool HasRes(const ResId& resId) {
-  Asset* asset = nAssets.TryGet(resId.GetAssetName());
+  Asset* asset = TryGetAsset(resId.GetAssetName());
   if (asset == nullptr) {
     return false;
   }
@@ -0,0 +1,201 @@
+#include <iomanip>
+
+#include "rsl/LoadStats.h"
+
+namespace Rsl {
+
+// The stats, resource, and stage that the calling thread is recording to. Time
+// since nStageStart hasn't been recorded yet.
+thread_local LoadStats* nActiveStats = nullptr;
+thread_local size_t nActiveResIndex = LoadStats::smNoRes;
+thread_local LoadStats::Stage nActiveStage = LoadStats::Stage::Count;
+thread_local std::chrono::steady_clock::time_point nStageStart;
+
+void RecordActiveStage() {
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (nActiveStats != nullptr && nActiveStage != LoadStats::Stage::Count) {
+    std::chrono::duration<double> duration = now - nStageStart;
+    nActiveStats->mTotal.mSeconds[(int)nActiveStage] += duration.count();
+    if (nActiveResIndex != LoadStats::smNoRes) {
+      LoadStats::ResStats& resStats = nActiveStats->mResStats[nActiveResIndex];
+      resStats.mTimings.mSeconds[(int)nActiveStage] += duration.count();
+    }
+  }
+  nStageStart = now;
+}
+
+const char* LoadStats::StageName(Stage stage) {
+  switch (stage) {
+  case Stage::Read: return "Read";
+  case Stage::Parse: return "Parse";
+  case Stage::Decode: return "Decode";
+  case Stage::Import: return "Import";
+  case Stage::Upload: return "Upload";
+  case Stage::FinalizeWait: return "FinalizeWait";
+  default: return "Invalid";
+  }
+}
+
+LoadStats::Timings::Timings(): mBytesRead(0) {
+  for (int i = 0; i < (int)Stage::Count; ++i) {
+    mSeconds[i] = 0.0;
+  }
+}
+
+LoadStats::LoadStats(): mAwaitingFinalize(false) {}
+
+void LoadStats::Clear() {
+  mTotal = Timings();
+  mResStats.Clear();
+  mAwaitingFinalize = false;
+}
+
+void LoadStats::EndInit() {
+  mInitEndTime = std::chrono::steady_clock::now();
+  mAwaitingFinalize = true;
+}
+
+void LoadStats::BeginFinalize() {
+  if (!mAwaitingFinalize) {
+    return;
+  }
+  std::chrono::duration<double> duration =
+    std::chrono::steady_clock::now() - mInitEndTime;
+  mTotal.mSeconds[(int)Stage::FinalizeWait] += duration.count();
+  mAwaitingFinalize = false;
+}
+
+void WriteCsvTimings(std::ostream& stream, const LoadStats::Timings& timings) {
+  for (int i = 0; i < (int)LoadStats::Stage::Count; ++i) {
+    stream << ',' << timings.mSeconds[i] * 1000.0;
+  }
+  stream << ',' << timings.mBytesRead << '\n';
+}
+
+void WriteCsvString(std::ostream& stream, const std::string& string) {
+  stream << std::quoted(string, '"', '"');
+}
+
+void LoadStats::WriteCsvHeader(std::ostream& stream) {
+  stream << "Asset,Resource,Type";
+  for (int i = 0; i < (int)Stage::Count; ++i) {
+    stream << ',' << StageName((Stage)i);
+  }
+  stream << ",BytesRead\n";
+}
+
+void LoadStats::WriteCsv(
+  std::ostream& stream, const std::string& assetName) const {
+  WriteCsvString(stream, assetName);
+  stream << ",,";
+  WriteCsvTimings(stream, mTotal);
+  for (const ResStats& resStats: mResStats) {
+    WriteCsvString(stream, assetName);
+    stream << ',';
+    WriteCsvString(stream, resStats.mName);
+    stream << ',' << GetResTypeData(resStats.mResTypeId).mName;
+    WriteCsvTimings(stream, resStats.mTimings);
+  }
+}
+
+void WriteJsonString(std::ostream& stream, const std::string& string) {
+  stream << '"';
+  for (char c: string) {
+    switch (c) {
+    case '"': stream << "\\\""; break;
+    case '\\': stream << "\\\\"; break;
+    case '\n': stream << "\\n"; break;
+    case '\t': stream << "\\t"; break;
+    default: stream << c; break;
+    }
+  }
+  stream << '"';
+}
+
+void WriteJsonTimings(std::ostream& stream, const LoadStats::Timings& timings) {
+  for (int i = 0; i < (int)LoadStats::Stage::Count; ++i) {
+    stream << '"' << LoadStats::StageName((LoadStats::Stage)i)
+           << "\": " << timings.mSeconds[i] * 1000.0 << ", ";
+  }
+  stream << "\"BytesRead\": " << timings.mBytesRead;
+}
+
+void LoadStats::WriteJson(
+  std::ostream& stream, const std::string& assetName) const {
+  stream << "{\"Asset\": ";
+  WriteJsonString(stream, assetName);
+  stream << ", ";
+  WriteJsonTimings(stream, mTotal);
+  stream << ", \"Resources\": [";
+  for (size_t i = 0; i < mResStats.Size(); ++i) {
+    const ResStats& resStats = mResStats[i];
+    stream << (i == 0 ? "\n  " : ",\n  ") << "{\"Resource\": ";
+    WriteJsonString(stream, resStats.mName);
+    stream << ", \"Type\": \"" << GetResTypeData(resStats.mResTypeId).mName
+           << "\", ";
+    WriteJsonTimings(stream, resStats.mTimings);
+    stream << '}';
+  }
+  stream << "]}";
+}
+
+LoadStats::Scope::Scope(LoadStats* stats):
+  mOuterStats(nActiveStats),
+  mOuterResIndex(nActiveResIndex),
+  mOuterStage(nActiveStage) {
+  RecordActiveStage();
+  nActiveStats = stats;
+  nActiveResIndex = smNoRes;
+  nActiveStage = Stage::Count;
+}
+
+LoadStats::Scope::~Scope() {
+  RecordActiveStage();
+  nActiveStats = mOuterStats;
+  nActiveResIndex = mOuterResIndex;
+  nActiveStage = mOuterStage;
+}
+
+size_t LoadStats::BeginRes(const std::string& name, ResTypeId resTypeId) {
+  if (nActiveStats == nullptr) {
+    return smNoRes;
+  }
+  RecordActiveStage();
+  nActiveStats->mResStats.Emplace();
+  ResStats& resStats = nActiveStats->mResStats.Top();
+  resStats.mName = name;
+  resStats.mResTypeId = resTypeId;
+  nActiveResIndex = nActiveStats->mResStats.Size() - 1;
+  return nActiveResIndex;
+}
+
+void LoadStats::SelectRes(size_t resIndex) {
+  RecordActiveStage();
+  nActiveResIndex = resIndex;
+}
+
+size_t LoadStats::SelectedRes() {
+  return nActiveResIndex;
+}
+
+StageTimer::StageTimer(LoadStats::Stage stage): mOuterStage(nActiveStage) {
+  RecordActiveStage();
+  nActiveStage = stage;
+}
+
+StageTimer::~StageTimer() {
+  RecordActiveStage();
+  nActiveStage = mOuterStage;
+}
+
+void AddBytesRead(size_t byteCount) {
+  if (nActiveStats == nullptr) {
+    return;
+  }
+  nActiveStats->mTotal.mBytesRead += byteCount;
+  if (nActiveResIndex != LoadStats::smNoRes) {
+    nActiveStats->mResStats[nActiveResIndex].mTimings.mBytesRead += byteCount;
+  }
+}
+
+} // namespace Rsl
@@ -0,0 +1,96 @@
+// Load stats break down the time spent loading an asset into stages, both for
+// the entire asset and for each of the resources defined in its config. They
+// are always recorded, so load times can be inspected in the editor or written
+// after a headless run without a profiler.
+//
+// Stages are timed with StageTimers. A nested timer pauses the timer it's
+// nested in, so no time is counted for two stages. Decode covers the part of a
+// resource's initialization that isn't spent reading files or importing.
+
+#ifndef rsl_LoadStats_h
+#define rsl_LoadStats_h
+
+#include <chrono>
+#include <ostream>
+#include <string>
+
+#include "ds/Vector.h"
+#include "rsl/ResourceType.h"
+
+namespace Rsl {
+
+struct LoadStats {
+  enum class Stage {
+    Read,
+    Parse,
+    Decode,
+    Import,
+    Upload,
+    FinalizeWait,
+    Count,
+  };
+  static const char* StageName(Stage stage);
+
+  struct Timings {
+    Timings();
+    double mSeconds[(int)Stage::Count];
+    size_t mBytesRead;
+  };
+
+  struct ResStats {
+    std::string mName;
+    ResTypeId mResTypeId;
+    Timings mTimings;
+  };
+
+  LoadStats();
+  void Clear();
+  // The time between the end of initialization and the start of finalization
+  // is recorded as the FinalizeWait stage of the entire asset.
+  void EndInit();
+  void BeginFinalize();
+
+  // Times are written in milliseconds. Every resource gets a CSV row and the
+  // row for the entire asset has empty resource and type fields.
+  static void WriteCsvHeader(std::ostream& stream);
+  void WriteCsv(std::ostream& stream, const std::string& assetName) const;
+  void WriteJson(std::ostream& stream, const std::string& assetName) const;
+
+  Timings mTotal;
+  Ds::Vector<ResStats> mResStats;
+
+  // While a scope exists, the stage timers and bytes read on its thread are
+  // recorded to its stats and to the stats of the selected resource.
+  struct Scope {
+    Scope(LoadStats* stats);
+    ~Scope();
+
+  private:
+    LoadStats* mOuterStats;
+    size_t mOuterResIndex;
+    Stage mOuterStage;
+  };
+  static constexpr size_t smNoRes = (size_t)-1;
+  // Adds and selects a resource within the stats of the current scope.
+  static size_t BeginRes(const std::string& name, ResTypeId resTypeId);
+  static void SelectRes(size_t resIndex);
+  static size_t SelectedRes();
+
+private:
+  std::chrono::steady_clock::time_point mInitEndTime;
+  bool mAwaitingFinalize;
+};
+
+struct StageTimer {
+  StageTimer(LoadStats::Stage stage);
+  ~StageTimer();
+
+private:
+  LoadStats::Stage mOuterStage;
+};
+
+void AddBytesRead(size_t byteCount);
+
+} // namespace Rsl
+
+#endif
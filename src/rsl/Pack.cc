@@ -0,0 +1,570 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Options.h"
+#include "gfx/Model.h"
+#include "rsl/Cook.h"
+#include "rsl/Library.h"
+#include "rsl/LoadStats.h"
+#include "rsl/Pack.h"
+#include "vlk/Binary.h"
+
+namespace Rsl {
+
+// The header is followed by the entry data and the index is at the end of the
+// file. Every entry's data is followed by a null terminator.
+constexpr unsigned int nPackMagic = 0x4b434150;
+constexpr unsigned int nPackVersion = 1;
+constexpr size_t nPackHeaderSize =
+  2 * sizeof(unsigned int) + 2 * sizeof(size_t);
+
+// LZ4 block format constants. Matches are at least 4 bytes, the last 5 bytes
+// of a block are always literals, and the last match starts at least 12 bytes
+// before the end of a block.
+constexpr size_t nLz4MinMatch = 4;
+constexpr size_t nLz4LastLiterals = 5;
+constexpr size_t nLz4MatchLimit = 12;
+constexpr size_t nLz4MaxOffset = 65535;
+constexpr int nLz4HashBits = 16;
+
+Pack nPack;
+
+FileData::FileData(): mData(nullptr), mSize(0) {}
+
+Pack::Pack(): mData(nullptr), mSize(0) {}
+
+Pack::~Pack() {
+  Close();
+}
+
+Result Pack::Open(const std::string& file) {
+  Close();
+#ifdef __linux__
+  int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return Result("Failed to open \"" + file + "\".");
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+    close(fd);
+    return Result("Failed to stat \"" + file + "\".");
+  }
+  void* map = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return Result("Failed to map \"" + file + "\".");
+  }
+  mData = (const char*)map;
+  mSize = (size_t)fileStat.st_size;
+#else
+  std::ifstream stream(file, std::ifstream::binary);
+  if (!stream.is_open()) {
+    return Result("Failed to open \"" + file + "\".");
+  }
+  stream.seekg(0, stream.end);
+  std::streamoff byteCount = stream.tellg();
+  stream.seekg(0, stream.beg);
+  mFileData.Resize((size_t)byteCount);
+  stream.read(mFileData.Data(), byteCount);
+  if (!stream) {
+    mFileData.Clear();
+    return Result("Failed to read \"" + file + "\".");
+  }
+  mData = mFileData.CData();
+  mSize = mFileData.Size();
+#endif
+
+  Result result = ReadIndex();
+  if (!result.Success()) {
+    Close();
+    return Result("Pack \"" + file + "\" is invalid.\n" + result.mError);
+  }
+  return Result();
+}
+
+void Pack::Close() {
+#ifdef __linux__
+  if (mData != nullptr) {
+    munmap((void*)mData, mSize);
+  }
+#else
+  mFileData.Clear();
+#endif
+  mData = nullptr;
+  mSize = 0;
+  mEntries.Clear();
+}
+
+bool Pack::IsOpen() const {
+  return mData != nullptr;
+}
+
+const Pack::Entry* Pack::TryGetEntry(const std::string& path) const {
+  size_t low = 0;
+  size_t high = mEntries.Size();
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    int comparison = mEntries[middle].mPath.compare(path);
+    if (comparison == 0) {
+      return &mEntries[middle];
+    }
+    if (comparison < 0) {
+      low = middle + 1;
+    }
+    else {
+      high = middle;
+    }
+  }
+  return nullptr;
+}
+
+VResult<FileData> Pack::Read(const Entry& entry) const {
+  FileData fileData;
+  const char* storedData = mData + entry.mOffset;
+  if (entry.mCompression == Compression::None) {
+    fileData.mData = storedData;
+    fileData.mSize = entry.mSize;
+    return std::move(fileData);
+  }
+  fileData.mOwnedData.Resize(entry.mSize + 1);
+  bool success = DecompressLz4(
+    storedData, entry.mStoredSize, fileData.mOwnedData.Data(), entry.mSize);
+  if (!success) {
+    return Result("Pack entry \"" + entry.mPath + "\" is corrupt.");
+  }
+  fileData.mOwnedData[entry.mSize] = '\0';
+  fileData.mData = fileData.mOwnedData.CData();
+  fileData.mSize = entry.mSize;
+  return std::move(fileData);
+}
+
+const Ds::Vector<Pack::Entry>& Pack::GetEntries() const {
+  return mEntries;
+}
+
+Result Pack::Write(
+  const std::string& file, Ds::Vector<Input>* inputs, bool compress) {
+  inputs->Sort([](const Input& a, const Input& b) {
+    return a.mPath > b.mPath;
+  });
+  for (size_t i = 1; i < inputs->Size(); ++i) {
+    if ((*inputs)[i].mPath == (*inputs)[i - 1].mPath) {
+      return Result("Pack path \"" + (*inputs)[i].mPath + "\" is duplicated.");
+    }
+  }
+
+  std::ofstream stream(file, std::ofstream::binary);
+  if (!stream.is_open()) {
+    return Result("Failed to open \"" + file + "\".");
+  }
+  Blob header;
+  header.mData.Resize(nPackHeaderSize);
+  stream.write(header.mData.CData(), header.mData.Size());
+
+  // Write the entry data and build the index.
+  Blob index;
+  size_t offset = nPackHeaderSize;
+  Ds::Vector<char> compressed;
+  for (const Input& input: *inputs) {
+    const char* storedData = input.mData.CData();
+    size_t storedSize = input.mData.Size();
+    Compression compression = Compression::None;
+    if (compress) {
+      CompressLz4(input.mData.CData(), input.mData.Size(), &compressed);
+      if (compressed.Size() < input.mData.Size()) {
+        storedData = compressed.CData();
+        storedSize = compressed.Size();
+        compression = Compression::Lz4;
+      }
+    }
+    stream.write(storedData, storedSize);
+    stream.put('\0');
+    index.Write(input.mPath);
+    index.Write(offset);
+    index.Write(storedSize);
+    index.Write(input.mData.Size());
+    index.Write(compression);
+    offset += storedSize + 1;
+  }
+  stream.write(index.mData.CData(), index.mData.Size());
+
+  header.mData.Clear();
+  header.Write(nPackMagic);
+  header.Write(nPackVersion);
+  header.Write(inputs->Size());
+  header.Write(offset);
+  stream.seekp(0, stream.beg);
+  stream.write(header.mData.CData(), header.mData.Size());
+  stream.close();
+  if (!stream) {
+    return Result("Failed to write \"" + file + "\".");
+  }
+  return Result();
+}
+
+Result Pack::ReadIndex() {
+  Blob header;
+  if (mSize < nPackHeaderSize) {
+    return Result("The header is truncated.");
+  }
+  header.View(mData, nPackHeaderSize);
+  unsigned int magic, version;
+  size_t entryCount, indexOffset;
+  header.Read(&magic);
+  header.Read(&version);
+  header.Read(&entryCount);
+  header.Read(&indexOffset);
+  if (magic != nPackMagic) {
+    return Result("The header is invalid.");
+  }
+  if (version != nPackVersion) {
+    return Result("The pack has an outdated version.");
+  }
+  if (indexOffset > mSize) {
+    return Result("The index is truncated.");
+  }
+
+  Blob index;
+  index.View(mData + indexOffset, mSize - indexOffset);
+  for (size_t i = 0; i < entryCount; ++i) {
+    Entry entry;
+    bool success = index.Read(&entry.mPath) && index.Read(&entry.mOffset) &&
+      index.Read(&entry.mStoredSize) && index.Read(&entry.mSize) &&
+      index.Read(&entry.mCompression);
+    if (!success) {
+      return Result("The index is truncated.");
+    }
+    // The stored data and its null terminator must precede the index.
+    bool inBounds = entry.mOffset >= nPackHeaderSize &&
+      entry.mOffset <= indexOffset &&
+      entry.mStoredSize < indexOffset - entry.mOffset;
+    if (!inBounds) {
+      return Result("Entry \"" + entry.mPath + "\" is out of bounds.");
+    }
+    if (entry.mCompression != Compression::None &&
+        entry.mCompression != Compression::Lz4) {
+      return Result("Entry \"" + entry.mPath + "\" has invalid compression.");
+    }
+    bool validSize = entry.mCompression != Compression::None ||
+      entry.mStoredSize == entry.mSize;
+    if (!validSize || mData[entry.mOffset + entry.mStoredSize] != '\0') {
+      return Result("Entry \"" + entry.mPath + "\" has an invalid size.");
+    }
+    if (!mEntries.Empty() && !(mEntries.Top().mPath < entry.mPath)) {
+      return Result("The index isn't sorted.");
+    }
+    mEntries.Push(std::move(entry));
+  }
+  return Result();
+}
+
+unsigned int ReadUint32(const char* data) {
+  unsigned int value;
+  memcpy(&value, data, sizeof(unsigned int));
+  return value;
+}
+
+void WriteLz4Length(size_t length, Ds::Vector<char>* compressed) {
+  while (length >= 255) {
+    compressed->Push((char)255);
+    length -= 255;
+  }
+  compressed->Push((char)length);
+}
+
+void WriteLz4Sequence(
+  const char* literals,
+  size_t literalCount,
+  size_t offset,
+  size_t matchLength,
+  Ds::Vector<char>* compressed) {
+  // The token holds the literal count and the match length in its two nibbles.
+  // A nibble of 15 means the remainder of the value follows.
+  size_t matchCode = matchLength == 0 ? 0 : matchLength - nLz4MinMatch;
+  unsigned char token = (unsigned char)(
+    ((literalCount < 15 ? literalCount : 15) << 4) |
+    (matchCode < 15 ? matchCode : 15));
+  compressed->Push((char)token);
+  if (literalCount >= 15) {
+    WriteLz4Length(literalCount - 15, compressed);
+  }
+  size_t literalIndex = compressed->Size();
+  compressed->Resize(literalIndex + literalCount);
+  memcpy(compressed->Data() + literalIndex, literals, literalCount);
+  if (matchLength == 0) {
+    return;
+  }
+  compressed->Push((char)(offset & 0xff));
+  compressed->Push((char)(offset >> 8));
+  if (matchCode >= 15) {
+    WriteLz4Length(matchCode - 15, compressed);
+  }
+}
+
+void CompressLz4(const char* data, size_t size, Ds::Vector<char>* compressed) {
+  compressed->Clear();
+  size_t anchor = 0;
+  if (size > nLz4MatchLimit) {
+    // Every position is hashed by its first four bytes and a match is found
+    // when the last position with the same hash has the same four bytes.
+    Ds::Vector<size_t> table;
+    table.Resize((size_t)1 << nLz4HashBits, SIZE_MAX);
+    size_t matchStartLimit = size - nLz4MatchLimit;
+    size_t matchEndLimit = size - nLz4LastLiterals;
+    size_t i = 0;
+    while (i < matchStartLimit) {
+      unsigned int sequence = ReadUint32(data + i);
+      size_t hash = (sequence * 2654435761u) >> (32 - nLz4HashBits);
+      size_t candidate = table[hash];
+      table[hash] = i;
+      if (candidate == SIZE_MAX || i - candidate > nLz4MaxOffset ||
+          ReadUint32(data + candidate) != sequence) {
+        ++i;
+        continue;
+      }
+      size_t matchLength = nLz4MinMatch;
+      while (i + matchLength < matchEndLimit &&
+             data[candidate + matchLength] == data[i + matchLength]) {
+        ++matchLength;
+      }
+      WriteLz4Sequence(
+        data + anchor, i - anchor, i - candidate, matchLength, compressed);
+      i += matchLength;
+      anchor = i;
+    }
+  }
+  WriteLz4Sequence(data + anchor, size - anchor, 0, 0, compressed);
+}
+
+bool ReadLz4Length(
+  const unsigned char* compressed,
+  size_t compressedSize,
+  size_t* index,
+  size_t* length) {
+  unsigned char byte;
+  do {
+    if (*index >= compressedSize) {
+      return false;
+    }
+    byte = compressed[(*index)++];
+    *length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+bool DecompressLz4(
+  const char* compressedData, size_t compressedSize, char* data, size_t size) {
+  const unsigned char* compressed = (const unsigned char*)compressedData;
+  size_t in = 0;
+  size_t out = 0;
+  while (in < compressedSize) {
+    unsigned char token = compressed[in++];
+    size_t literalCount = token >> 4;
+    if (literalCount == 15 &&
+        !ReadLz4Length(compressed, compressedSize, &in, &literalCount)) {
+      return false;
+    }
+    if (literalCount > compressedSize - in || literalCount > size - out) {
+      return false;
+    }
+    memcpy(data + out, compressed + in, literalCount);
+    in += literalCount;
+    out += literalCount;
+
+    // The last sequence only has literals.
+    if (in == compressedSize) {
+      break;
+    }
+    if (compressedSize - in < 2) {
+      return false;
+    }
+    size_t offset = (size_t)compressed[in] | ((size_t)compressed[in + 1] << 8);
+    in += 2;
+    if (offset == 0 || offset > out) {
+      return false;
+    }
+    size_t matchLength = token & 15;
+    if (matchLength == 15 &&
+        !ReadLz4Length(compressed, compressedSize, &in, &matchLength)) {
+      return false;
+    }
+    matchLength += nLz4MinMatch;
+    if (matchLength > size - out) {
+      return false;
+    }
+    // Matches can overlap the bytes they produce, so they're copied in order.
+    for (size_t i = 0; i < matchLength; ++i) {
+      data[out + i] = data[out - offset + i];
+    }
+    out += matchLength;
+  }
+  return out == size;
+}
+
+std::string PackFile() {
+  return Options::nConfig.mProjectDirectory + "res.pack";
+}
+
+Result MountPack(const std::string& file) {
+  return nPack.Open(file);
+}
+
+void UnmountPack() {
+  nPack.Close();
+}
+
+VResult<FileData> ReadResFile(const std::string& path) {
+  StageTimer readTimer(LoadStats::Stage::Read);
+  if (nPack.IsOpen()) {
+    const Pack::Entry* entry = nPack.TryGetEntry(path);
+    if (entry != nullptr) {
+      AddBytesRead(entry->mStoredSize);
+      return nPack.Read(*entry);
+    }
+  }
+
+  VResult<std::string> resolutionResult = ResolveResPath(path);
+  if (!resolutionResult.Success()) {
+    return Result(resolutionResult.mError);
+  }
+  const std::string& file = resolutionResult.mValue;
+  if (!std::filesystem::is_regular_file(file)) {
+    InvalidateResPath(path);
+    return Result("\"" + file + "\" is not a regular file.");
+  }
+  std::ifstream stream(file, std::ifstream::binary);
+  if (!stream.is_open()) {
+    InvalidateResPath(path);
+    return Result("Failed to open \"" + file + "\".");
+  }
+  stream.seekg(0, stream.end);
+  std::streamoff byteCount = stream.tellg();
+  stream.seekg(0, stream.beg);
+  FileData fileData;
+  fileData.mOwnedData.Resize((size_t)byteCount + 1);
+  stream.read(fileData.mOwnedData.Data(), byteCount);
+  if (!stream) {
+    return Result("Failed to read \"" + file + "\".");
+  }
+  fileData.mOwnedData[(size_t)byteCount] = '\0';
+  fileData.mData = fileData.mOwnedData.CData();
+  fileData.mSize = (size_t)byteCount;
+  AddBytesRead(fileData.mSize);
+  return std::move(fileData);
+}
+
+bool HasPackInput(
+  const Ds::Vector<Pack::Input>& inputs, const std::string& path) {
+  for (const Pack::Input& input: inputs) {
+    if (input.mPath == path) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Adds a file that's read through ReadResFile unless it was already added.
+Result AddSourceInput(
+  const std::string& path, Ds::Vector<Pack::Input>* inputs) {
+  if (HasPackInput(*inputs, path)) {
+    return Result();
+  }
+  VResult<FileData> readResult = ReadResFile(path);
+  if (!readResult.Success()) {
+    return Result(readResult.mError);
+  }
+  Pack::Input input;
+  input.mPath = path;
+  const FileData& fileData = readResult.mValue;
+  input.mData.Resize(fileData.mSize);
+  memcpy(input.mData.Data(), fileData.mData, fileData.mSize);
+  inputs->Push(std::move(input));
+  return Result();
+}
+
+Result AddPackInputs(
+  const std::string& assetName, Ds::Vector<Pack::Input>* inputs) {
+  // Add the config.
+  std::string assetFile = assetName + nAssetExtension;
+  VResult<FileData> readResult = ReadResFile(assetFile);
+  if (!readResult.Success()) {
+    return Result(readResult.mError);
+  }
+  Pack::Input configInput;
+  configInput.mPath = assetFile;
+  const FileData& configData = readResult.mValue;
+  configInput.mData.Resize(configData.mSize);
+  memcpy(configInput.mData.Data(), configData.mData, configData.mSize);
+  inputs->Push(std::move(configInput));
+
+  Vlk::Value rootVal;
+  Result result = Vlk::IsBinary(configData.mData, configData.mSize)
+    ? rootVal.ParseBinary(configData.mData, configData.mSize)
+    : rootVal.Parse(configData.mData);
+  if (!result.Success()) {
+    return Result(assetFile + result.mError);
+  }
+  Vlk::Explorer rootEx(rootVal);
+  if (!rootEx.Valid(Vlk::Value::Type::ValueArray)) {
+    return Result("Root Value is not a ValueArray.");
+  }
+
+  // Add the cooked data of every cookable resource. Resources that share a
+  // config share cooked data, so their data is only added once. Models aren't
+  // cookable, so the files they're imported from are added instead.
+  for (int i = 0; i < rootEx.Size(); ++i) {
+    Vlk::Explorer resEx = rootEx[i];
+    ResTypeId resTypeId = GetResTypeId(resEx("Type").As<std::string>(""));
+    if (resTypeId == ResTypeId::Model) {
+      Ds::Vector<std::string> sourceFiles;
+      Result packResult =
+        Gfx::Model::CollectSourceFiles(resEx("Config"), &sourceFiles);
+      for (const std::string& sourceFile: sourceFiles) {
+        if (packResult.Success()) {
+          packResult = AddSourceInput(sourceFile, inputs);
+        }
+      }
+      if (!packResult.Success()) {
+        return Result(
+          "Model at \"" + resEx.Path() + "\" failed packing.\n" +
+          packResult.mError);
+      }
+      continue;
+    }
+    const Vlk::Value* configVal = rootVal[i].TryGetConstPair("Config");
+    if (!Cookable(resTypeId) || configVal == nullptr) {
+      continue;
+    }
+    std::string packPath = CookPackPath(CookKey(resTypeId, *configVal));
+    if (HasPackInput(*inputs, packPath)) {
+      continue;
+    }
+    CookedRes cookedRes;
+    Result cookResult = CookRes(resTypeId, resEx("Config"), &cookedRes);
+    if (!cookResult.Success()) {
+      return Result(
+        "Resource at \"" + resEx.Path() + "\" failed cooking.\n" +
+        cookResult.mError);
+    }
+    VResult<Blob> serializeResult = SerializeCookedRes(cookedRes);
+    if (!serializeResult.Success()) {
+      return Result(serializeResult.mError);
+    }
+    Pack::Input cookedInput;
+    cookedInput.mPath = std::move(packPath);
+    cookedInput.mData = std::move(serializeResult.mValue.mData);
+    inputs->Push(std::move(cookedInput));
+  }
+  return Result();
+}
+
+} // namespace Rsl
@@ -0,0 +1,93 @@
+// A pack is a single archive that holds the asset configs and cooked resources
+// of a shipping build. Its index is sorted by path so entries are found with a
+// binary search, and entries can be stored with LZ4 block compression. The pack
+// is memory mapped, so uncompressed entries are read without any copies.
+//
+// When a pack is mounted, ReadResFile serves files from it before falling back
+// to the filesystem. Pack entries aren't files, so ResolveResPath never
+// resolves to them and everything read from a pack goes through ReadResFile.
+
+#ifndef rsl_Pack_h
+#define rsl_Pack_h
+
+#include <string>
+
+#include "Result.h"
+#include "ds/Vector.h"
+
+namespace Rsl {
+
+// The content of a file read through ReadResFile. The content is always
+// followed by a null terminator so text can be parsed in place. Uncompressed
+// pack entries point into the mapped pack and other content is owned.
+struct FileData {
+  FileData();
+
+  const char* mData;
+  size_t mSize;
+  Ds::Vector<char> mOwnedData;
+};
+
+struct Pack {
+  enum class Compression : unsigned char {
+    None,
+    Lz4,
+  };
+
+  struct Entry {
+    std::string mPath;
+    size_t mOffset;
+    size_t mStoredSize;
+    size_t mSize;
+    Compression mCompression;
+  };
+
+  // The content of an entry when writing a pack.
+  struct Input {
+    std::string mPath;
+    Ds::Vector<char> mData;
+  };
+
+  Pack();
+  ~Pack();
+  Result Open(const std::string& file);
+  void Close();
+  bool IsOpen() const;
+  const Entry* TryGetEntry(const std::string& path) const;
+  VResult<FileData> Read(const Entry& entry) const;
+  const Ds::Vector<Entry>& GetEntries() const;
+
+  // Entries are only compressed when compression makes them smaller.
+  static Result Write(
+    const std::string& file, Ds::Vector<Input>* inputs, bool compress);
+
+private:
+  const char* mData;
+  size_t mSize;
+  // Platforms without mmap read the entire pack into memory instead.
+  Ds::Vector<char> mFileData;
+  Ds::Vector<Entry> mEntries;
+
+  Result ReadIndex();
+};
+
+// LZ4 block format compression. Decompression fails instead of reading or
+// writing out of bounds when the compressed data is malformed.
+void CompressLz4(const char* data, size_t size, Ds::Vector<char>* compressed);
+bool DecompressLz4(
+  const char* compressed, size_t compressedSize, char* data, size_t size);
+
+extern Pack nPack;
+std::string PackFile();
+Result MountPack(const std::string& file);
+void UnmountPack();
+// Reads a resource file from the mounted pack or a resolved resource path.
+VResult<FileData> ReadResFile(const std::string& path);
+// Adds an asset's config, the cooked data of its cookable resources, and the
+// files that its models are imported from.
+Result AddPackInputs(
+  const std::string& assetName, Ds::Vector<Pack::Input>* inputs);
+
+} // namespace Rsl
+
+#endif
@@ -1,16 +1,71 @@
+#include <mutex>
+
+#include "debug/MemLeak.h"
+#include "ds/HashSet.h"
 #include "rsl/ResourceId.h"
 
 namespace Rsl {
 
-ResourceId::ResourceId() {}
+// The interned ids are stored in a HashSet of InternKeys and they are found
+// using an InternLookup, which avoids creating an InternedId for the search.
+struct InternKey {
+  const ResourceId::InternedId* mInterned;
+};
+
+struct InternLookup {
+  const std::string& mId;
+  size_t mHash;
+};
+
+bool operator==(const InternKey& key, const InternLookup& lookup) {
+  return key.mInterned->mHash == lookup.mHash &&
+    key.mInterned->mId == lookup.mId;
+}
+
+bool operator==(const InternKey& a, const InternKey& b) {
+  return a.mInterned == b.mInterned;
+}
+
+size_t Hash(const InternKey& key) {
+  return key.mInterned->mHash;
+}
+
+size_t Hash(const InternLookup& lookup) {
+  return lookup.mHash;
+}
+
+struct InternTable {
+  std::mutex mMutex;
+  Ds::HashSet<InternKey> mKeys;
+};
+
+InternTable& GetInternTable() {
+  // A function static is used because ResourceIds are created during static
+  // initialization.
+  static InternTable internTable;
+  return internTable;
+}
+
+size_t HashId(const std::string& id) {
+  // 64 bit FNV-1a.
+  size_t hash = 14695981039346656037ull;
+  for (char c: id) {
+    hash ^= (unsigned char)c;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
 
-ResourceId::ResourceId(const ResourceId& other): mId(other.mId) {}
+ResourceId::ResourceId() {
+  static const InternedId* emptyInterned = Intern("");
+  mInterned = emptyInterned;
+}
 
-ResourceId::ResourceId(ResourceId&& other): mId(std::move(other.mId)) {}
+ResourceId::ResourceId(const ResourceId& other): mInterned(other.mInterned) {}
 
-ResourceId::ResourceId(const char* id): mId(id) {}
+ResourceId::ResourceId(const char* id): mInterned(Intern(id)) {}
 
-ResourceId::ResourceId(const std::string& id): mId(id) {}
+ResourceId::ResourceId(const std::string& id): mInterned(Intern(id)) {}
 
 ResourceId::ResourceId(
   const std::string& assetName, const std::string& resourceName) {
@@ -18,63 +73,89 @@ ResourceId::ResourceId(
 }
 
 ResourceId& ResourceId::operator=(const ResourceId& other) {
-  mId = other.mId;
+  mInterned = other.mInterned;
   return *this;
 }
 
 ResourceId& ResourceId::operator=(const char* id) {
-  mId = id;
+  mInterned = Intern(id);
   return *this;
 }
 
 ResourceId& ResourceId::operator=(const std::string& id) {
-  mId = id;
+  mInterned = Intern(id);
   return *this;
 }
 
 void ResourceId::Init(
   const std::string& assetName, const std::string& resourceName) {
-  mId = assetName + nResIdDelimeter + resourceName;
+  mInterned = Intern(assetName + nResIdDelimeter + resourceName);
 }
 
-std::string ResourceId::GetAssetName() const {
-  size_t assetIdEnd = mId.find(nResIdDelimeter);
-  if (assetIdEnd == std::string::npos) {
-    return mId;
-  }
-  return mId.substr(0, assetIdEnd);
+const std::string& ResourceId::GetId() const {
+  return mInterned->mId;
+}
+
+const std::string& ResourceId::GetAssetName() const {
+  return mInterned->mAssetName;
 }
 
 std::string ResourceId::GetAssetFile() const {
   return GetAssetName() + nAssetExtension;
 }
 
-std::string ResourceId::GetResourceName() const {
-  size_t assetIdEnd = mId.find(nResIdDelimeter);
-  if (assetIdEnd == std::string::npos) {
-    return "";
-  }
-  size_t resourceNameStart = assetIdEnd + 1;
-  size_t count = mId.size() - resourceNameStart;
-  return mId.substr(resourceNameStart, count);
+const std::string& ResourceId::GetResourceName() const {
+  return mInterned->mResourceName;
 }
 
 void ResourceId::SetResourceName(const std::string& name) {
-  size_t assetNameEnd = mId.find(nResIdDelimeter);
+  size_t assetNameEnd = mInterned->mId.find(nResIdDelimeter);
   if (assetNameEnd == std::string::npos) {
-    mId = nResIdDelimeter + name;
+    mInterned = Intern(nResIdDelimeter + name);
     return;
   }
-  mId.erase(assetNameEnd + 1);
-  mId += name;
+  mInterned = Intern(mInterned->mId.substr(0, assetNameEnd + 1) + name);
+}
+
+size_t ResourceId::GetHash() const {
+  return mInterned->mHash;
+}
+
+unsigned int ResourceId::GetIndex() const {
+  return mInterned->mIndex;
 }
 
-bool ResourceId::operator==(const ResId& other) const {
-  return mId == other.mId;
+bool ResourceId::operator==(const ResourceId& other) const {
+  return mInterned == other.mInterned;
 }
 
 bool ResourceId::operator!=(const ResourceId& other) const {
-  return mId != other.mId;
+  return mInterned != other.mInterned;
+}
+
+const ResourceId::InternedId* ResourceId::Intern(const std::string& id) {
+  InternTable& internTable = GetInternTable();
+  InternLookup lookup = {id, HashId(id)};
+  std::scoped_lock lock(internTable.mMutex);
+  auto it = internTable.mKeys.Find(lookup);
+  if (it != internTable.mKeys.end()) {
+    return it->mInterned;
+  }
+
+  InternedId* interned = alloc InternedId;
+  interned->mId = id;
+  size_t assetNameEnd = id.find(nResIdDelimeter);
+  if (assetNameEnd == std::string::npos) {
+    interned->mAssetName = id;
+  }
+  else {
+    interned->mAssetName = id.substr(0, assetNameEnd);
+    interned->mResourceName = id.substr(assetNameEnd + 1);
+  }
+  interned->mHash = lookup.mHash;
+  interned->mIndex = (unsigned int)internTable.mKeys.Size();
+  internTable.mKeys.Insert(InternKey {interned});
+  return interned;
 }
 
 } // namespace Rsl
@@ -8,14 +8,13 @@ namespace Rsl {
 constexpr const char* nAssetExtension = ".a";
 constexpr const char* nResIdDelimeter = ":";
 
-// A way to identify a specific resource within the resource library.
+// A way to identify a specific resource within the resource library. The id
+// has the form "AssetName:ResourceName". Every distinct id is interned once, so
+// a ResourceId only refers to its interned entry. This makes copies and
+// comparisons cheap and gives every id a small index that caches can use.
 struct ResourceId {
-  // Stores the asset and resource name like so "AssetName:ResourceName"
-  std::string mId;
-
   ResourceId();
   ResourceId(const ResourceId& other);
-  ResourceId(ResourceId&& other);
   ResourceId(const char* id);
   ResourceId(const std::string& id);
   ResourceId(const std::string& assetName, const std::string& resourceName);
@@ -24,12 +23,29 @@ struct ResourceId {
   ResourceId& operator=(const std::string& id);
   void Init(const std::string& assetName, const std::string& resourceName);
 
-  std::string GetAssetName() const;
+  const std::string& GetId() const;
+  const std::string& GetAssetName() const;
   std::string GetAssetFile() const;
-  std::string GetResourceName() const;
+  const std::string& GetResourceName() const;
   void SetResourceName(const std::string& name);
+  size_t GetHash() const;
+  unsigned int GetIndex() const;
   bool operator==(const ResourceId& other) const;
   bool operator!=(const ResourceId& other) const;
+
+  struct InternedId {
+    std::string mId;
+    std::string mAssetName;
+    std::string mResourceName;
+    size_t mHash;
+    unsigned int mIndex;
+  };
+
+private:
+  // Interned ids are never freed, so this pointer remains valid.
+  const InternedId* mInterned;
+
+  static const InternedId* Intern(const std::string& id);
 };
 typedef ResourceId ResId;
 
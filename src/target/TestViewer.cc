@@ -369,7 +369,7 @@ void Init() {
     TestType::SphereTriangleIntersection);
   RegisterTestVector<Test::TriangleClosestPointToTest>(
     TestType::TriangleClosestPointTo);
-  Rsl::nExtraResDirectory = "test/math_Hull/res/";
+  Rsl::SetExtraResDirectory("test/math_Hull/res/");
   RegisterTestVector<Test::QuickHullTest>(TestType::QuickHull);
 
   nSelectedTest.mType = TestType::BoxBoxIntersection;
@@ -0,0 +1,34 @@
+#include <iostream>
+#include <string>
+
+#include "vlk/Value.h"
+
+// Usage: varkorConvert input output
+// The input can be text or binary Valkor. The output is binary when its
+// extension is .vlkb and text otherwise.
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::cout << "Usage: varkorConvert input output" << std::endl;
+    return 1;
+  }
+  Vlk::Value rootVal;
+  Result result = rootVal.Read(argv[1]);
+  if (!result.Success()) {
+    std::cout << result.mError << std::endl;
+    return 1;
+  }
+
+  std::string output = argv[2];
+  const std::string binaryExtension = ".vlkb";
+  bool binary = output.size() >= binaryExtension.size() &&
+    output.compare(
+      output.size() - binaryExtension.size(),
+      binaryExtension.size(),
+      binaryExtension) == 0;
+  result = binary ? rootVal.WriteBinary(argv[2]) : rootVal.Write(argv[2]);
+  if (!result.Success()) {
+    std::cout << result.mError << std::endl;
+    return 1;
+  }
+  return 0;
+}
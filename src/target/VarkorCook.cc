@@ -0,0 +1,59 @@
+#include <filesystem>
+#include <iostream>
+
+#include "Options.h"
+#include "rsl/Cook.h"
+#include "rsl/Library.h"
+
+// Cooks every asset within a directory. The asset names are relative to the
+// name directory, the same way they are when an asset is required.
+int CookAssets(const std::string& directory, const std::string& nameDirectory) {
+  if (!std::filesystem::is_directory(directory)) {
+    return 0;
+  }
+  int failureCount = 0;
+  std::filesystem::recursive_directory_iterator it(directory);
+  for (const std::filesystem::directory_entry& entry: it) {
+    const std::filesystem::path& path = entry.path();
+    if (!entry.is_regular_file() || path.extension() != Rsl::nAssetExtension) {
+      continue;
+    }
+    std::filesystem::path relativePath =
+      std::filesystem::relative(path, nameDirectory);
+    std::string assetName =
+      relativePath.replace_extension("").generic_string();
+    Result result = Rsl::CookAsset(assetName);
+    if (result.Success()) {
+      std::cout << "Cooked \"" << assetName << "\"" << std::endl;
+    }
+    else {
+      std::cout << "Failed \"" << assetName << "\"\n"
+                << result.mError << std::endl;
+      ++failureCount;
+    }
+  }
+  return failureCount;
+}
+
+// Usage: varkorCook [projectDirectory]
+int main(int argc, char* argv[]) {
+  Options::Config config;
+  config.mEditorLevel = Options::EditorLevel::Simple;
+  config.mProjectDirectory = "";
+  if (argc > 1 && argv[1][0] != '-') {
+    config.mProjectDirectory = argv[1];
+  }
+  Result result = Options::Init(argc, argv, std::move(config));
+  if (!result.Success()) {
+    return 1;
+  }
+  Rsl::RegisterResourceTypes();
+
+  int failureCount = CookAssets(
+    VARKOR_WORKING_DIRECTORY + std::string("vres"), VARKOR_WORKING_DIRECTORY);
+  if (!Rsl::IsStandalone()) {
+    failureCount += CookAssets(Rsl::ResDirectory(), Rsl::ResDirectory());
+  }
+  std::cout << "Cooked into \"" << Rsl::CookDirectory() << "\"" << std::endl;
+  return failureCount == 0 ? 0 : 1;
+}
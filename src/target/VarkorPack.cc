@@ -0,0 +1,76 @@
+#include <filesystem>
+#include <iostream>
+
+#include "Options.h"
+#include "rsl/Library.h"
+#include "rsl/Pack.h"
+
+// Adds every asset within a directory to the pack inputs. The asset names are
+// relative to the name directory, the same way they are when an asset is
+// required.
+int AddAssets(
+  const std::string& directory,
+  const std::string& nameDirectory,
+  Ds::Vector<Rsl::Pack::Input>* inputs) {
+  if (!std::filesystem::is_directory(directory)) {
+    return 0;
+  }
+  int failureCount = 0;
+  std::filesystem::recursive_directory_iterator it(directory);
+  for (const std::filesystem::directory_entry& entry: it) {
+    const std::filesystem::path& path = entry.path();
+    if (!entry.is_regular_file() || path.extension() != Rsl::nAssetExtension) {
+      continue;
+    }
+    std::filesystem::path relativePath =
+      std::filesystem::relative(path, nameDirectory);
+    std::string assetName =
+      relativePath.replace_extension("").generic_string();
+    Result result = Rsl::AddPackInputs(assetName, inputs);
+    if (result.Success()) {
+      std::cout << "Added \"" << assetName << "\"" << std::endl;
+    }
+    else {
+      std::cout << "Failed \"" << assetName << "\"\n"
+                << result.mError << std::endl;
+      ++failureCount;
+    }
+  }
+  return failureCount;
+}
+
+// Usage: varkorPack [projectDirectory]
+int main(int argc, char* argv[]) {
+  Options::Config config;
+  config.mEditorLevel = Options::EditorLevel::Simple;
+  config.mProjectDirectory = "";
+  if (argc > 1 && argv[1][0] != '-') {
+    config.mProjectDirectory = argv[1];
+  }
+  Result result = Options::Init(argc, argv, std::move(config));
+  if (!result.Success()) {
+    return 1;
+  }
+  Rsl::RegisterResourceTypes();
+
+  Ds::Vector<Rsl::Pack::Input> inputs;
+  int failureCount = AddAssets(
+    VARKOR_WORKING_DIRECTORY + std::string("vres"),
+    VARKOR_WORKING_DIRECTORY,
+    &inputs);
+  if (!Rsl::IsStandalone()) {
+    failureCount +=
+      AddAssets(Rsl::ResDirectory(), Rsl::ResDirectory(), &inputs);
+  }
+  if (failureCount > 0) {
+    return 1;
+  }
+  result = Rsl::Pack::Write(Rsl::PackFile(), &inputs, true);
+  if (!result.Success()) {
+    std::cout << result.mError << std::endl;
+    return 1;
+  }
+  std::cout << "Packed " << inputs.Size() << " files into \""
+            << Rsl::PackFile() << "\"" << std::endl;
+  return 0;
+}
@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#include "debug/MemLeak.h"
+#include "debug/MemTrack.h"
+#include "test/Test.h"
+
+// Storing allocations here prevents the compiler from removing them.
+void* volatile nEscape;
+template<typename T>
+T* Escape(T* allocation) {
+  nEscape = allocation;
+  return allocation;
+}
+
+void PrintStats(Debug::MemTrack::Tag tag) {
+  Debug::MemTrack::Stats stats = Debug::MemTrack::GetStats(tag);
+  std::cout << Debug::MemTrack::GetTagName(tag) << ": "
+            << "[Live: " << stats.mLiveBytes << ", Peak: " << stats.mPeakBytes
+            << ", LiveAllocations: " << stats.mLiveAllocations
+            << ", TotalAllocations: " << stats.mTotalAllocations << "]\n";
+}
+
+void Allocate() {
+  char* a;
+  char* b;
+  {
+    Debug::MemTrack::Scope scope(Debug::MemTrack::Tag::World);
+    a = Escape(alloc char[100]);
+    b = Escape(alloc char[50]);
+  }
+  char* c = Escape(alloc char[10]);
+  PrintStats(Debug::MemTrack::Tag::World);
+  delete[] a;
+  PrintStats(Debug::MemTrack::Tag::World);
+  delete[] b;
+  delete[] c;
+  PrintStats(Debug::MemTrack::Tag::World);
+}
+
+void NestedScopes() {
+  Debug::MemTrack::Scope rslScope(Debug::MemTrack::Tag::Rsl);
+  int* a = Escape(alloc int);
+  {
+    Debug::MemTrack::Scope vlkScope(Debug::MemTrack::Tag::Vlk);
+    std::cout << "Current: "
+              << Debug::MemTrack::GetTagName(Debug::MemTrack::CurrentTag())
+              << '\n';
+    delete a;
+  }
+  std::cout << "Current: "
+            << Debug::MemTrack::GetTagName(Debug::MemTrack::CurrentTag())
+            << '\n';
+  PrintStats(Debug::MemTrack::Tag::Rsl);
+  PrintStats(Debug::MemTrack::Tag::Vlk);
+}
+
+void Threads() {
+  // Memory returns to the tag it was allocated with no matter which thread
+  // frees it, and scopes only affect the thread they are created on.
+  char* allocation = nullptr;
+  Debug::MemTrack::Scope scope(Debug::MemTrack::Tag::Editor);
+  std::thread thread([&allocation]() {
+    Debug::MemTrack::Scope scope(Debug::MemTrack::Tag::Gfx);
+    allocation = Escape(alloc char[64]);
+  });
+  thread.join();
+  PrintStats(Debug::MemTrack::Tag::Gfx);
+  delete[] allocation;
+  PrintStats(Debug::MemTrack::Tag::Gfx);
+}
+
+void OtherForms() {
+  // Over-aligned and nothrow allocations are tracked like any other.
+  struct alignas(64) Wide {
+    char mData[64];
+  };
+  Debug::MemTrack::Scope scope(Debug::MemTrack::Tag::Vlk);
+  Wide* wide = Escape(alloc Wide);
+  Wide* wides = Escape(alloc Wide[2]);
+  int* integer = Escape(new (std::nothrow) int);
+  std::cout << "Aligned: " << ((uintptr_t)wide % 64 == 0) << ", "
+            << ((uintptr_t)wides % 64 == 0) << '\n';
+  PrintStats(Debug::MemTrack::Tag::Vlk);
+  delete wide;
+  delete[] wides;
+  delete integer;
+  PrintStats(Debug::MemTrack::Tag::Vlk);
+}
+
+int main(void) {
+  EnableLeakOutput();
+  RunTest(Allocate);
+  RunTest(NestedScopes);
+  RunTest(Threads);
+  RunTest(OtherForms);
+}
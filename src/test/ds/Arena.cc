@@ -0,0 +1,83 @@
+#include <iostream>
+
+#include "debug/MemLeak.h"
+#include "ds/Allocator.h"
+#include "ds/Arena.h"
+#include "ds/Vector.h"
+#include "test/ds/Print.h"
+#include "test/ds/Test.h"
+#include "test/ds/TestType.h"
+
+void PrintArena(const Ds::Arena& arena) {
+  std::cout << "Usage: " << arena.Usage() << std::endl;
+  std::cout << "PeakUsage: " << arena.PeakUsage() << std::endl;
+  std::cout << "Capacity: " << arena.Capacity() << std::endl;
+}
+
+void Allocate() {
+  Ds::Arena arena(256);
+  PrintArena(arena);
+  bool aligned = true;
+  for (int i = 1; i <= 8; ++i) {
+    void* allocation = arena.Allocate(i * 3);
+    aligned = aligned && (size_t)allocation % Ds::Arena::smAlignment == 0;
+  }
+  std::cout << "Aligned: " << aligned << std::endl;
+  PrintArena(arena);
+}
+
+void Overflow() {
+  // Allocations that don't fit in the current block create a new one, and
+  // allocations larger than the block size get a block of their own.
+  Ds::Arena arena(256);
+  arena.Allocate(200);
+  arena.Allocate(200);
+  PrintArena(arena);
+  arena.Allocate(1000);
+  PrintArena(arena);
+}
+
+void Reset() {
+  Ds::Arena arena(256);
+  for (int i = 0; i < 10; ++i) {
+    arena.Allocate(100);
+  }
+  PrintArena(arena);
+
+  // The blocks are combined so the same allocations fit in a single block.
+  arena.Reset();
+  PrintArena(arena);
+  for (int i = 0; i < 10; ++i) {
+    arena.Allocate(100);
+  }
+  PrintArena(arena);
+}
+
+void FrameAllocator() {
+  Ds::ResetFrameArena();
+  {
+    Ds::Vector<TestType, Ds::FrameAllocator> test;
+    for (int i = 0; i < 15; ++i) {
+      test.Emplace(i);
+    }
+    PrintVector(test);
+    Ds::Vector<TestType, Ds::FrameAllocator> copy(test);
+    copy.Sort([](const TestType& a, const TestType& b) {
+      return a.mA < b.mA;
+    });
+    PrintVector(copy, false);
+  }
+  std::cout << "FrameUsage: " << Ds::FrameArena().Usage() << std::endl;
+  Ds::ResetFrameArena();
+  std::cout << "FrameUsage: " << Ds::FrameArena().Usage() << std::endl;
+  TestType::PrintCounts();
+}
+
+int main(void) {
+  Error::Init();
+  EnableLeakOutput();
+  RunDsTest(Allocate);
+  RunDsTest(Overflow);
+  RunDsTest(Reset);
+  RunDsTest(FrameAllocator);
+}
@@ -9,18 +9,24 @@
 #include "ds/Map.h"
 #include "ds/Pool.h"
 #include "ds/RbTree.h"
+#include "ds/SmallVector.h"
 #include "ds/Vector.h"
 
 template<typename K, typename V>
 std::ostream& operator<<(std::ostream& os, const Ds::KvPair<K, V>& hashSet);
 template<typename T>
 std::ostream& operator<<(std::ostream& os, const Ds::HashSet<T>& hashSet);
-template<typename T>
-std::ostream& operator<<(std::ostream& os, const Ds::Vector<T>& vector);
+template<typename T, typename A>
+std::ostream& operator<<(std::ostream& os, const Ds::Vector<T, A>& vector);
+template<typename T, size_t N>
+std::ostream& operator<<(
+  std::ostream& os, const Ds::SmallVector<T, N>& smallVector);
 template<typename T>
 void PrintHashSetDs(const Ds::HashSet<T>& hashSet);
-template<typename T>
-void PrintVector(const Ds::Vector<T>& vector, bool stats = true);
+template<typename T, typename A>
+void PrintVector(const Ds::Vector<T, A>& vector, bool stats = true);
+template<typename T, size_t N>
+void PrintVector(const Ds::SmallVector<T, N>& smallVector, bool stats = true);
 template<typename T>
 void PrintList(const Ds::List<T>& list);
 template<typename T>
@@ -22,8 +22,8 @@ std::ostream& operator<<(std::ostream& os, const Ds::HashSet<T>& hashSet) {
   return os;
 }
 
-template<typename T>
-std::ostream& operator<<(std::ostream& os, const Ds::Vector<T>& vector) {
+template<typename T, typename A>
+std::ostream& operator<<(std::ostream& os, const Ds::Vector<T, A>& vector) {
   if (vector.Size() == 0) {
     os << "[]";
     return os;
@@ -36,6 +36,21 @@ std::ostream& operator<<(std::ostream& os, const Ds::Vector<T>& vector) {
   return os;
 }
 
+template<typename T, size_t N>
+std::ostream& operator<<(
+  std::ostream& os, const Ds::SmallVector<T, N>& smallVector) {
+  if (smallVector.Size() == 0) {
+    os << "[]";
+    return os;
+  }
+  os << "[";
+  for (int i = 0; i < smallVector.Size() - 1; ++i) {
+    os << smallVector[i] << ", ";
+  }
+  os << smallVector[smallVector.Size() - 1] << "]";
+  return os;
+}
+
 template<typename T>
 void PrintHashSetDs(const Ds::HashSet<T>& hashSet) {
   if (hashSet.Empty()) {
@@ -53,8 +68,8 @@ void PrintHashSetDs(const Ds::HashSet<T>& hashSet) {
   std::cout << ']';
 }
 
-template<typename T>
-void PrintVector(const Ds::Vector<T>& vector, bool stats) {
+template<typename T, typename A>
+void PrintVector(const Ds::Vector<T, A>& vector, bool stats) {
   if (stats) {
     std::cout << "Size: " << vector.Size() << std::endl;
     std::cout << "Capactiy: " << vector.Capacity() << std::endl;
@@ -62,6 +77,16 @@ void PrintVector(const Ds::Vector<T>& vector, bool stats) {
   std::cout << vector << std::endl;
 }
 
+template<typename T, size_t N>
+void PrintVector(const Ds::SmallVector<T, N>& smallVector, bool stats) {
+  if (stats) {
+    std::cout << "Size: " << smallVector.Size() << std::endl;
+    std::cout << "Capactiy: " << smallVector.Capacity() << std::endl;
+    std::cout << "Inline: " << smallVector.Inline() << std::endl;
+  }
+  std::cout << smallVector << std::endl;
+}
+
 template<typename T>
 void PrintList(const Ds::List<T>& list) {
   std::cout << "-List-\n";
@@ -0,0 +1,201 @@
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "debug/MemLeak.h"
+#include "ds/SmallVector.h"
+#include "test/ds/Print.h"
+#include "test/ds/Test.h"
+#include "test/ds/TestType.h"
+
+void InlinePush() {
+  Ds::SmallVector<TestType, 4> test;
+  PrintVector(test);
+  for (int i = 0; i < 4; ++i) {
+    test.Emplace(i);
+  }
+  PrintVector(test);
+  TestType::PrintCounts();
+}
+
+void HeapPush() {
+  Ds::SmallVector<TestType, 4> test;
+  for (int i = 0; i < 10; ++i) {
+    test.Emplace(i);
+  }
+  PrintVector(test);
+  TestType::PrintCounts();
+}
+
+void MultiplePush() {
+  Ds::SmallVector<int, 4> test;
+  test.Push(0, 3);
+  PrintVector(test);
+  test.Push(1, 6);
+  PrintVector(test);
+}
+
+void Insert() {
+  Ds::SmallVector<std::string, 4> test;
+  test.Insert(0, "b");
+  test.Insert(0, "a");
+  test.Insert(2, "d");
+  test.Insert(2, "c");
+  PrintVector(test);
+  test.Insert(1, "a.5");
+  PrintVector(test);
+}
+
+void CopyConstructor() {
+  Ds::SmallVector<TestType, 4> inlineTest;
+  Ds::SmallVector<TestType, 4> heapTest;
+  for (int i = 0; i < 3; ++i) {
+    inlineTest.Emplace(i);
+  }
+  for (int i = 0; i < 6; ++i) {
+    heapTest.Emplace(i);
+  }
+  Ds::SmallVector<TestType, 4> inlineCopy(inlineTest);
+  Ds::SmallVector<TestType, 4> heapCopy(heapTest);
+  PrintVector(inlineCopy);
+  PrintVector(heapCopy);
+  TestType::PrintCounts();
+}
+
+void MoveConstructor() {
+  // Inline elements are moved individually and heap allocations are taken.
+  Ds::SmallVector<int, 4> inlineTest = {0, 1, 2};
+  Ds::SmallVector<int, 4> heapTest = {0, 1, 2, 3, 4, 5};
+  const int* heapPtr = heapTest.CData();
+  Ds::SmallVector<int, 4> inlineMove(std::move(inlineTest));
+  Ds::SmallVector<int, 4> heapMove(std::move(heapTest));
+  PrintVector(inlineTest);
+  PrintVector(inlineMove);
+  PrintVector(heapTest);
+  PrintVector(heapMove);
+  std::cout << "Moved: " << (heapPtr == heapMove.CData()) << '\n';
+}
+
+void CopyAssignment() {
+  Ds::SmallVector<TestType, 4> test;
+  Ds::SmallVector<TestType, 4> copy;
+  for (int i = 0; i < 6; ++i) {
+    test.Emplace(i);
+  }
+  copy.Emplace(-1);
+  copy = test;
+  PrintVector(copy);
+  test.Resize(2);
+  copy = test;
+  PrintVector(copy);
+  TestType::PrintCounts();
+}
+
+void MoveAssignment() {
+  Ds::SmallVector<TestType, 4> test;
+  Ds::SmallVector<TestType, 4> move;
+  for (int i = 0; i < 6; ++i) {
+    move.Emplace(-i);
+  }
+  for (int i = 0; i < 3; ++i) {
+    test.Emplace(i);
+  }
+  move = std::move(test);
+  PrintVector(test);
+  PrintVector(move);
+  TestType::PrintCounts();
+}
+
+void Sort() {
+  Ds::SmallVector<int, 8> test = {8, 6, 9, 0, 1, 3, 7, 5, 4, 2};
+  test.Sort();
+  PrintVector(test, false);
+  test.Sort([](const int& a, const int& b) -> bool {
+    return a < b;
+  });
+  PrintVector(test, false);
+}
+
+void Remove() {
+  Ds::SmallVector<TestType, 4> test;
+  for (int i = 0; i < 6; ++i) {
+    test.Emplace(i);
+  }
+  test.Remove(0);
+  test.LazyRemove(1);
+  test.Pop();
+  PrintVector(test, false);
+  TestType::PrintCounts();
+}
+
+void Resize() {
+  Ds::SmallVector<std::string, 4> test;
+  test.Resize(3, "a");
+  PrintVector(test);
+  test.Resize(6, "b");
+  PrintVector(test);
+  test.Resize(1);
+  PrintVector(test);
+}
+
+void Shrink() {
+  Ds::SmallVector<int, 4> test = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+  test.Resize(6);
+  test.Shrink();
+  PrintVector(test);
+  test.Resize(2);
+  test.Shrink();
+  PrintVector(test);
+}
+
+void Find() {
+  Ds::SmallVector<int, 4> test = {0, 2, 4, 6, 8, 10};
+  std::cout << "4: " << test.Find(4) << '\n';
+  std::cout << "10: " << test.Find(10) << '\n';
+  std::cout << "3: " << test.Find(3) << '\n';
+  std::cout << "Contains 8: " << test.Contains(8) << '\n';
+}
+
+void Iterate() {
+  Ds::SmallVector<int, 4> test = {0, 1, 2, 3, 4, 5};
+  int sum = 0;
+  for (int value: test) {
+    sum += value;
+  }
+  std::cout << "Sum: " << sum << '\n';
+  std::cout << "Top: " << test.Top() << '\n';
+}
+
+void ConstructionDestructionCounts() {
+  {
+    Ds::SmallVector<Ds::SmallVector<TestType, 4>, 2> test;
+    for (int i = 0; i < 5; ++i) {
+      Ds::SmallVector<TestType, 4> inner;
+      for (int j = 0; j < 2 * i; ++j) {
+        inner.Emplace(j);
+      }
+      test.Push(std::move(inner));
+    }
+  }
+  TestType::PrintCounts();
+}
+
+int main(void) {
+  Error::Init();
+  EnableLeakOutput();
+  RunDsTest(InlinePush);
+  RunDsTest(HeapPush);
+  RunDsTest(MultiplePush);
+  RunDsTest(Insert);
+  RunDsTest(CopyConstructor);
+  RunDsTest(MoveConstructor);
+  RunDsTest(CopyAssignment);
+  RunDsTest(MoveAssignment);
+  RunDsTest(Sort);
+  RunDsTest(Remove);
+  RunDsTest(Resize);
+  RunDsTest(Shrink);
+  RunDsTest(Find);
+  RunDsTest(Iterate);
+  RunDsTest(ConstructionDestructionCounts);
+}
@@ -204,6 +204,67 @@ void Sort() {
   std::cout << "Sorts Successful" << std::endl;
 }
 
+void SortPatterns() {
+  // These inputs degrade a plain quicksort.
+  const int size = 1'000'000;
+  Ds::Vector<int> test[4];
+  for (int i = 0; i < size; ++i) {
+    test[0].Push(i);
+    test[1].Push(size - i);
+    test[2].Push(7);
+    test[3].Push(i < size / 2 ? i : size - i);
+  }
+  auto ensureSort = [](const Ds::Vector<int>& vector) {
+    for (int j = 0; j < vector.Size() - 1; ++j) {
+      LogAbortIf(vector[j] > vector[j + 1], "Elements not sorted");
+    }
+  };
+  for (int i = 0; i < 4; ++i) {
+    test[i].Sort();
+    ensureSort(test[i]);
+  }
+
+  Ds::Vector<TestType> types;
+  for (int i = 0; i < 20; ++i) {
+    types.Emplace((i * 7) % 20);
+  }
+  types.Sort([](const TestType& a, const TestType& b) {
+    return a.mA < b.mA;
+  });
+  PrintVector(types, false);
+}
+
+void RadixSort() {
+  Ds::Vector<int> ints = {5, -3, 400, -70000, 0, 12, -1, 70000, 5};
+  ints.RadixSort();
+  PrintVector(ints, false);
+
+  Ds::Vector<float> floats = {2.5f, -0.5f, 0.0f, -100.0f, 1e6f, -1e-3f, 3.0f};
+  floats.RadixSort();
+  PrintVector(floats, false);
+
+  // Elements with equal keys must keep their order.
+  Ds::Vector<TestType> types;
+  for (int i = 0; i < 10; ++i) {
+    types.Emplace(i % 3, (float)i);
+  }
+  types.RadixSort([](const TestType& value) {
+    return value.mA;
+  });
+  PrintVector(types, false);
+
+  srand(34);
+  Ds::Vector<uint64_t> keys;
+  for (int i = 0; i < 100'000; ++i) {
+    keys.Push(((uint64_t)rand() << 32) | (uint64_t)rand());
+  }
+  keys.RadixSort();
+  for (int i = 0; i < keys.Size() - 1; ++i) {
+    LogAbortIf(keys[i] > keys[i + 1], "Elements not sorted");
+  }
+  std::cout << "Radix Sort Successful" << std::endl;
+}
+
 void Pop() {
   Ds::Vector<TestType> testVector;
   for (int i = 0; i < 10; ++i) {
@@ -597,6 +658,8 @@ int main(void) {
   RunDsTest(Insert3);
   RunDsTest(Swap);
   RunDsTest(Sort);
+  RunDsTest(SortPatterns);
+  RunDsTest(RadixSort);
   RunDsTest(Pop);
   RunDsTest(Clear);
   RunDsTest(Remove0);
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <string>
+
+#include "Error.h"
+#include "debug/MemLeak.h"
+#include "gfx/Image.h"
+#include "test/Test.h"
+
+// No window or gl context is created. Staging images must not require one.
+
+void PrintStaging(const Gfx::Image::Staging& staging) {
+  std::cout << "ByteCount: " << staging.ByteCount()
+            << ", Compressed: " << staging.mCompressed
+            << ", Format: " << staging.mFormat << ", Levels: ";
+  for (const Gfx::Image::Staging::Level& level: staging.mLevels) {
+    std::cout << "[" << level.mWidth << "x" << level.mHeight << ", "
+              << level.mByteCount << "]";
+  }
+  std::cout << '\n';
+}
+
+std::string PpmData() {
+  // A 2x1 ppm with a red and a blue pixel.
+  std::string data = "P6\n2 1\n255\n";
+  data += {(char)255, 0, 0, 0, 0, (char)255};
+  return data;
+}
+
+void StagingFromFileData() {
+  std::string data = PpmData();
+  VResult<Gfx::Image::Staging> result =
+    Gfx::Image::Staging::Init(data.data(), data.size());
+  std::cout << "Success: " << result.Success() << '\n';
+  PrintStaging(result.mValue);
+  const char* pixels = result.mValue.mData.CData();
+  std::cout << "FirstPixel: " << (int)(unsigned char)pixels[0] << ' '
+            << (int)(unsigned char)pixels[1] << ' '
+            << (int)(unsigned char)pixels[2] << '\n';
+}
+
+void StagingFromPixels() {
+  unsigned char pixels[12] = {0};
+  Gfx::Image::Staging staging =
+    Gfx::Image::Staging::Init(pixels, 4, 3, GL_R8, GL_RED, 1);
+  PrintStaging(staging);
+  staging = Gfx::Image::Staging::Init(pixels, 3, 1, GL_RGBA, GL_RGBA, 4);
+  PrintStaging(staging);
+}
+
+void StagingFailure() {
+  std::string data = "not an image";
+  VResult<Gfx::Image::Staging> result =
+    Gfx::Image::Staging::Init(data.data(), data.size());
+  std::cout << "Success: " << result.Success() << '\n'
+            << "Error: " << result.mError << '\n';
+}
+
+void StagedImage() {
+  // The staged data is released with the image when it is never uploaded.
+  std::string data = PpmData();
+  Gfx::Image image;
+  Result result = image.Init(data.data(), (int)data.size());
+  std::cout << "Success: " << result.Success() << '\n'
+            << "StagedBytes: " << image.StagedBytes() << '\n'
+            << "Aspect: " << image.Aspect() << '\n'
+            << "Id: " << image.Id() << '\n';
+}
+
+int main() {
+  Error::Init();
+  EnableLeakOutput();
+  RunTest(StagingFromFileData);
+  RunTest(StagingFromPixels);
+  RunTest(StagingFailure);
+  RunTest(StagedImage);
+}
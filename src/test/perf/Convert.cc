@@ -0,0 +1,54 @@
+#include <chrono>
+#include <iostream>
+
+#include "ext/Tracy.h"
+#include "test/perf/Helper.h"
+#include "vlk/Valkor.h"
+
+// The Values resemble the transforms of a layer with 40000 members.
+constexpr int nMemberCount = 40000;
+Vlk::Value nRootVal;
+
+void Serialize() {
+  ZoneScopedC(0xFF0000);
+  nRootVal.Clear();
+  nRootVal[{nMemberCount}];
+  for (int i = 0; i < nMemberCount; ++i) {
+    float offset = (float)i * 0.37f;
+    Vlk::Value& transformVal = nRootVal[i];
+    transformVal("Translation") = Vec3({offset, offset * 2.0f, -offset});
+    transformVal("Scale") = Vec3({1.0f, 1.5f, 2.0f});
+    transformVal("Rotation") = Quat(0.7071068f, offset, 0.0f, 0.7071068f);
+  }
+}
+
+void Deserialize() {
+  ZoneScopedC(0x00FF00);
+  float sum = 0.0f;
+  for (int i = 0; i < nMemberCount; ++i) {
+    Vlk::Value& transformVal = nRootVal[i];
+    sum += transformVal("Translation").As<Vec3>()[0];
+    sum += transformVal("Scale").As<Vec3>()[0];
+    sum += transformVal("Rotation").As<Quat>()[0];
+  }
+  if (sum < 0.0f) {
+    std::cout << sum << std::endl;
+  }
+}
+
+void Measure(const char* name, void (*function)()) {
+  constexpr int count = 10;
+  auto start = std::chrono::steady_clock::now();
+  Profile(function, count);
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::milli> duration = end - start;
+  std::cout << name << ": " << duration.count() / count << "ms per "
+            << nMemberCount << " transforms" << std::endl;
+}
+
+int main(void) {
+  ProfileThread("Main");
+
+  Measure("Serialize", Serialize);
+  Measure("Deserialize", Deserialize);
+}
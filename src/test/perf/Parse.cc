@@ -0,0 +1,62 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "Error.h"
+#include "ext/Tracy.h"
+#include "test/perf/Helper.h"
+#include "vlk/Document.h"
+#include "vlk/Value.h"
+
+// The text resembles a layer file with 40000 members and is about 7 MiB.
+constexpr int nMemberCount = 40000;
+std::string nText;
+
+void CreateText() {
+  nText = "{\n";
+  for (int i = 0; i < nMemberCount; ++i) {
+    nText += "  :Member" + std::to_string(i) +
+      ": {\n"
+      "    :Transform: {\n"
+      "      :Translation: ['1.0', '2.0', '3.0']\n"
+      "      :Scale: ['1.0', '1.0', '1.0']\n"
+      "    }\n"
+      "    :Name: 'A member name with \\'escaped\\' quotes'\n"
+      "  }\n";
+  }
+  nText += "}\n";
+}
+
+void ParseValue() {
+  ZoneScopedC(0xFF0000);
+  Vlk::Value rootVal;
+  Result result = rootVal.Parse(nText.c_str());
+  LogAbortIf(!result.Success(), result.mError.c_str());
+}
+
+void ParseDocument() {
+  ZoneScopedC(0x00FF00);
+  Vlk::Document document;
+  Result result = document.Parse(std::string(nText));
+  LogAbortIf(!result.Success(), result.mError.c_str());
+}
+
+void Measure(const char* name, void (*function)()) {
+  constexpr int count = 20;
+  auto start = std::chrono::steady_clock::now();
+  Profile(function, count);
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::milli> duration = end - start;
+  std::cout << name << ": " << duration.count() / count << "ms per "
+            << nText.size() / 1024 << " KiB" << std::endl;
+}
+
+int main(void) {
+  ProfileThread("Main");
+
+  Error::Init();
+
+  CreateText();
+  Measure("Value", ParseValue);
+  Measure("Document", ParseDocument);
+}
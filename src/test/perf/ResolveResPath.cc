@@ -0,0 +1,74 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "Error.h"
+#include "ext/Tracy.h"
+#include "rsl/Library.h"
+#include "test/perf/Helper.h"
+
+// The project has 1000 resources split between assets and the files they
+// reference. Each load resolves every asset path and every resource path.
+constexpr int nAssetCount = 250;
+constexpr int nFilesPerAsset = 3;
+const char* nProjectDirectory = "resolveResPathProject/";
+Ds::Vector<std::string> nPaths;
+
+void CreateProject() {
+  std::filesystem::remove_all(nProjectDirectory);
+  for (int i = 0; i < nAssetCount; ++i) {
+    std::string directory = "assets" + std::to_string(i % 10) + '/';
+    std::filesystem::create_directories(nProjectDirectory + directory);
+    std::string assetPath = directory + "asset" + std::to_string(i);
+    nPaths.Push(assetPath + Rsl::nAssetExtension);
+    for (int j = 0; j < nFilesPerAsset; ++j) {
+      nPaths.Push(assetPath + "_" + std::to_string(j) + ".png");
+    }
+  }
+  for (const std::string& path: nPaths) {
+    std::ofstream stream(nProjectDirectory + path);
+  }
+}
+
+void LoadProject() {
+  ZoneScopedC(0xFFFF00);
+  for (const std::string& path: nPaths) {
+    VResult<std::string> result = Rsl::ResolveResPath(path);
+    LogAbortIf(!result.Success(), result.mError.c_str());
+  }
+}
+
+void LoadProjectUncached() {
+  ZoneScopedC(0xFF0000);
+  Rsl::nUseResPathCache = false;
+  LoadProject();
+}
+
+void LoadProjectCached() {
+  ZoneScopedC(0x00FF00);
+  Rsl::nUseResPathCache = true;
+  LoadProject();
+}
+
+void Benchmark(const char* name, void (*function)(), int count) {
+  auto start = std::chrono::steady_clock::now();
+  Profile(function, count);
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::milli> duration = end - start;
+  std::cout << name << ": " << duration.count() / count << "ms per load of "
+            << nPaths.Size() << " resources" << std::endl;
+}
+
+int main(void) {
+  ProfileThread("Main");
+
+  Error::Init();
+
+  Rsl::SetExtraResDirectory(nProjectDirectory);
+  CreateProject();
+  Benchmark("Uncached", LoadProjectUncached, 50);
+  Rsl::ClearResPathCache();
+  Benchmark("Cached", LoadProjectCached, 50);
+  std::filesystem::remove_all(nProjectDirectory);
+}
@@ -0,0 +1,46 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "Error.h"
+#include "ext/Tracy.h"
+#include "test/perf/Helper.h"
+#include "vlk/Tokenizer.h"
+
+// The text resembles a layer file with 40000 members and is about 6 MiB.
+constexpr int nMemberCount = 40000;
+std::string nText;
+
+void CreateText() {
+  for (int i = 0; i < nMemberCount; ++i) {
+    nText += "  :Member" + std::to_string(i) +
+      ": {\n"
+      "    :Transform: {\n"
+      "      :Translation: ['1.0', '2.0', '3.0'],\n"
+      "      :Scale: ['1.0', '1.0', '1.0']\n"
+      "    },\n"
+      "    :Name: 'A member name with \\'escaped\\' quotes'\n"
+      "  },\n";
+  }
+}
+
+void Tokenize() {
+  ZoneScopedC(0x00FF00);
+  VResult<Ds::Vector<Vlk::Token>> result = Vlk::Tokenize(nText.c_str());
+  LogAbortIf(!result.Success(), result.mError.c_str());
+}
+
+int main(void) {
+  ProfileThread("Main");
+
+  Error::Init();
+
+  CreateText();
+  constexpr int count = 20;
+  auto start = std::chrono::steady_clock::now();
+  Profile(Tokenize, count);
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::milli> duration = end - start;
+  std::cout << "Tokenize: " << duration.count() / count << "ms per "
+            << nText.size() / 1024 << " KiB" << std::endl;
+}
@@ -0,0 +1,94 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "Error.h"
+#include "Viewport.h"
+#include "debug/MemLeak.h"
+#include "gfx/Image.h"
+#include "rsl/Cook.h"
+#include "rsl/HotReload.h"
+#include "rsl/Library.h"
+#include "test/Test.h"
+
+GLuint ImageId(const std::string& assetName, const std::string& resName) {
+  return Rsl::GetRes<Gfx::Image>(ResId(assetName, resName)).Id();
+}
+
+size_t UploadedBytes(const std::string& assetName, const std::string& resName) {
+  for (const Rsl::Asset::ResDesc& resDesc:
+       Rsl::GetAsset(assetName).GetResDescs()) {
+    if (resDesc.mName == resName) {
+      return resDesc.mUploadedBytes;
+    }
+  }
+  return 0;
+}
+
+void SharedUpload() {
+  // A and B name the same file through different paths. B is staged before A
+  // is uploaded, so it uses A's texture when it's uploaded.
+  Rsl::RequireAsset("First");
+  Rsl::RequireAsset("Different");
+  std::cout << "Shared: " << (ImageId("First", "A") == ImageId("First", "B"))
+            << '\n';
+  std::cout << "Different: "
+            << (ImageId("First", "A") != ImageId("Different", "Image")) << '\n';
+  size_t uploadedBytes = UploadedBytes("First", "A");
+  std::cout << "A Uploaded: " << (uploadedBytes > 0) << '\n';
+  std::cout << "B Uploaded: " << UploadedBytes("First", "B") << '\n';
+  std::cout << "Gpu Bytes: "
+            << (Rsl::GetAsset("First").GetGpuBytes() == uploadedBytes) << '\n';
+}
+
+void SharedInit() {
+  // The texture is already uploaded, so the image shares it without staging.
+  Rsl::RequireAsset("Later");
+  std::cout << "Shared: "
+            << (ImageId("First", "A") == ImageId("Later", "Image")) << '\n';
+  std::cout << "Uploaded: " << UploadedBytes("Later", "Image") << '\n';
+}
+
+void SharedReload() {
+  // All of the reloaded images share a single new texture.
+  GLuint oldId = ImageId("First", "A");
+  std::string file =
+    VARKOR_WORKING_DIRECTORY + std::string("vres/image/whiteBox.png");
+  Rsl::QueueReloads(file);
+  int frames = 0;
+  while (true) {
+    GLuint id = ImageId("First", "A");
+    if (id != oldId && id == ImageId("First", "B") &&
+        id == ImageId("Later", "Image")) {
+      break;
+    }
+    if (frames == 1000) {
+      std::cout << "Timed Out\n";
+      break;
+    }
+    Rsl::HandleInitialization();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ++frames;
+  }
+  int uploads = (UploadedBytes("First", "A") > 0) +
+    (UploadedBytes("First", "B") > 0) + (UploadedBytes("Later", "Image") > 0);
+  std::cout << "Uploads: " << uploads << '\n';
+
+  // Images initialized after the reload share the new texture.
+  Rsl::RequireAsset("After");
+  std::cout << "Shared: "
+            << (ImageId("First", "A") == ImageId("After", "Image")) << '\n';
+}
+
+int main(void) {
+  EnableLeakOutput();
+  Error::Init();
+  Viewport::Init("rsl_Asset", false);
+  Rsl::RegisterResourceTypes();
+  Rsl::nUseCookedRes = false;
+  RunTest(SharedUpload);
+  RunTest(SharedInit);
+  RunTest(SharedReload);
+  Rsl::Purge();
+  Viewport::Purge();
+}
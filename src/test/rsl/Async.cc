@@ -0,0 +1,62 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "Error.h"
+#include "Viewport.h"
+#include "debug/MemLeak.h"
+#include "gfx/Material.h"
+#include "rsl/Async.h"
+#include "test/Test.h"
+
+bool nTaskDone = false;
+
+Rsl::Task AwaitMaterial() {
+  std::cout << "Task Started\n";
+  Gfx::Material* material =
+    co_await Rsl::LoadAsync<Gfx::Material>(ResId("Async", "Material"));
+  std::cout << "Material Loaded: " << (material != nullptr) << '\n';
+  co_await Rsl::NextFrame();
+  std::cout << "Next Frame\n";
+  nTaskDone = true;
+}
+
+void PrintStatus(const std::string& assetName, Rsl::Asset::Status status) {
+  std::cout << assetName << ": "
+            << (Rsl::GetAssetStatus(assetName) == status) << '\n';
+}
+
+void LoadAsync() {
+  // The task suspends until its asset and the asset's dependency are loaded.
+  AwaitMaterial();
+  std::cout << "Suspended: " << !nTaskDone << '\n';
+  PrintStatus("Async", Rsl::Asset::Status::Queued);
+  PrintStatus("Dependency", Rsl::Asset::Status::Queued);
+
+  int frames = 0;
+  while (!nTaskDone ||
+         Rsl::GetAssetStatus("Dependency") != Rsl::Asset::Status::Live) {
+    if (frames == 1000) {
+      std::cout << "Timed Out\n";
+      break;
+    }
+    Rsl::HandleInitialization();
+    Rsl::ResumeTasks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ++frames;
+  }
+  std::cout << "Done: " << nTaskDone << '\n';
+  PrintStatus("Async", Rsl::Asset::Status::Live);
+  PrintStatus("Dependency", Rsl::Asset::Status::Live);
+}
+
+int main(void) {
+  EnableLeakOutput();
+  Error::Init();
+  Viewport::Init("rsl_Async", false);
+  Rsl::RegisterResourceTypes();
+  RunTest(LoadAsync);
+  Rsl::PurgeTasks();
+  Rsl::Purge();
+  Viewport::Purge();
+}
@@ -0,0 +1,99 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "debug/MemLeak.h"
+#include "rsl/Cook.h"
+#include "test/Test.h"
+
+void WriteSourceFile(const char* content) {
+  std::ofstream stream("source.txt");
+  stream << content;
+}
+
+void BlobReadWrite() {
+  Rsl::Blob blob;
+  blob.Write(5);
+  blob.Write(2.5f);
+  blob.Write(std::string("string"));
+  Ds::Vector<int> vector = {1, 2, 3};
+  blob.Write(vector);
+
+  int intValue;
+  float floatValue;
+  std::string stringValue;
+  Ds::Vector<int> vectorValue;
+  bool success = blob.Read(&intValue) && blob.Read(&floatValue) &&
+    blob.Read(&stringValue) && blob.Read(&vectorValue);
+  std::cout << "Success: " << success << '\n'
+            << "Values: " << intValue << ", " << floatValue << ", "
+            << stringValue << ", [";
+  for (int value: vectorValue) {
+    std::cout << value << (value == vectorValue.Top() ? "" : ", ");
+  }
+  std::cout << "]\nReadIndex: " << blob.mReadIndex << '\n';
+
+  // Reads past the end of the data fail.
+  std::cout << "Read Past End: " << blob.Read(&intValue) << '\n';
+}
+
+void BlobMalformed() {
+  // A size that is larger than the remaining data fails instead of allocating.
+  Rsl::Blob blob;
+  blob.Write((size_t)1000);
+  blob.Write(std::string("x"));
+  std::string stringValue;
+  std::cout << "String: " << blob.Read(&stringValue) << '\n';
+  blob.mReadIndex = 0;
+  Ds::Vector<int> vectorValue;
+  std::cout << "Vector: " << blob.Read(&vectorValue) << '\n';
+}
+
+void CookedRes() {
+  std::filesystem::remove_all(Rsl::CookDirectory());
+  WriteSourceFile("original");
+  const size_t cookKey = 0x1234;
+  std::cout << "Missing: " << Rsl::ReadCookedRes(cookKey).Success() << '\n';
+
+  Rsl::CookedRes cookedRes;
+  cookedRes.mSourceFiles.Push("source.txt");
+  cookedRes.mBlob.Write(std::string("cooked"));
+  Result result = Rsl::WriteCookedRes(cookKey, cookedRes);
+  std::cout << "Write: " << result.Success() << '\n';
+
+  VResult<Rsl::CookedRes> readResult = Rsl::ReadCookedRes(cookKey);
+  std::string content;
+  readResult.mValue.mBlob.Read(&content);
+  std::cout << "Read: " << readResult.Success() << ", " << content << ", "
+            << readResult.mValue.mSourceFiles[0] << '\n';
+
+  // A source file with a new write time is hashed again, so rewriting the same
+  // content doesn't invalidate the cooked resource. Changed content of the same
+  // size does.
+  std::filesystem::file_time_type writeTime =
+    std::filesystem::last_write_time("source.txt");
+  std::filesystem::last_write_time(
+    "source.txt", writeTime + std::chrono::seconds(10));
+  std::cout << "Touched: " << Rsl::ReadCookedRes(cookKey).Success() << '\n';
+  WriteSourceFile("0riginal");
+  std::filesystem::last_write_time(
+    "source.txt", writeTime + std::chrono::seconds(20));
+  readResult = Rsl::ReadCookedRes(cookKey);
+  std::cout << "Same Size: " << readResult.Success() << '\n';
+
+  // Changing a source file invalidates the cooked resource.
+  WriteSourceFile("changed");
+  readResult = Rsl::ReadCookedRes(cookKey);
+  std::cout << "Stale: " << readResult.Success() << '\n'
+            << readResult.mError << '\n';
+  std::filesystem::remove_all(Rsl::CookDirectory());
+  std::filesystem::remove("source.txt");
+}
+
+int main(void) {
+  EnableLeakOutput();
+  RunTest(BlobReadWrite);
+  RunTest(BlobMalformed);
+  RunTest(CookedRes);
+}
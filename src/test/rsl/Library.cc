@@ -0,0 +1,74 @@
+#include <iostream>
+
+#include "Error.h"
+#include "debug/MemLeak.h"
+#include "gfx/Material.h"
+#include "rsl/Library.h"
+#include "test/Test.h"
+
+void AddMaterialAsset(const std::string& name, unsigned int frame) {
+  Rsl::Asset& asset = Rsl::AddAsset(name);
+  asset.InitRes<Gfx::Material>("Material", ResId());
+  Rsl::nFrame = frame;
+  asset.Touch();
+}
+
+void PrintLive(const std::string& name) {
+  bool live = Rsl::GetAssetStatus(name) == Rsl::Asset::Status::Live;
+  std::cout << name << " Live: " << live << '\n';
+}
+
+void RequireAsset() {
+  // Required assets hold a single reference.
+  Rsl::Asset& asset = Rsl::RequireAsset("Required");
+  std::cout << "Live: " << (asset.GetStatus() == Rsl::Asset::Status::Live)
+            << '\n';
+  std::cout << "References: " << asset.GetRefCount() << '\n';
+}
+
+void EvictionOrder() {
+  Rsl::nEvictionMinIdleFrames = 2;
+  AddMaterialAsset("A", 2);
+  AddMaterialAsset("B", 1);
+  AddMaterialAsset("C", 3);
+  AddMaterialAsset("Recent", 9);
+  AddMaterialAsset("Held", 0);
+  Rsl::GetAsset("Held").AddRef();
+
+  // Only two assets fit within the budget. The referenced asset and the
+  // recently used asset are kept and the rest are evicted oldest first.
+  size_t assetBytes = Rsl::GetAsset("A").GetCpuBytes();
+  std::cout << "Asset Bytes: " << (assetBytes > 0) << '\n';
+  Rsl::nCpuByteBudget = assetBytes * 2;
+  Rsl::nFrame = 10;
+  Rsl::HandleInitialization();
+  PrintLive("A");
+  PrintLive("B");
+  PrintLive("C");
+  PrintLive("Recent");
+  PrintLive("Held");
+  PrintLive("Required");
+  const Ds::Vector<Rsl::Eviction>& evictions = Rsl::GetEvictions();
+  for (const Rsl::Eviction& eviction: evictions) {
+    std::cout << eviction.mAssetName << ": " << eviction.mIdleFrames << '\n';
+  }
+
+  // Nothing else is evicted once the budget is met.
+  Rsl::HandleInitialization();
+  std::cout << "Evictions: " << Rsl::GetEvictions().Size() << '\n';
+  Rsl::GetAsset("Held").RemRef();
+}
+
+void EvictionReport() {
+  std::cout << Rsl::EvictionReport();
+}
+
+int main(void) {
+  EnableLeakOutput();
+  Error::Init();
+  Rsl::RegisterResourceTypes();
+  RunTest(RequireAsset);
+  RunTest(EvictionOrder);
+  RunTest(EvictionReport);
+  Rsl::Purge();
+}
@@ -0,0 +1,132 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "debug/MemLeak.h"
+#include "rsl/LoadStats.h"
+#include "test/Test.h"
+
+void Wait(int milliseconds) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+double StageSeconds(
+  const Rsl::LoadStats::Timings& timings, Rsl::LoadStats::Stage stage) {
+  return timings.mSeconds[(int)stage];
+}
+
+void StageTimers() {
+  using Stage = Rsl::LoadStats::Stage;
+  Rsl::LoadStats stats;
+  {
+    Rsl::LoadStats::Scope scope(&stats);
+    Rsl::LoadStats::BeginRes("image", ResTypeId::Image);
+    Rsl::StageTimer decodeTimer(Stage::Decode);
+    Wait(5);
+    {
+      // The nested timer pauses the decode timer.
+      Rsl::StageTimer readTimer(Stage::Read);
+      Rsl::AddBytesRead(100);
+      Wait(20);
+    }
+    Wait(5);
+  }
+  // Timers outside of a scope don't record anything.
+  {
+    Rsl::StageTimer readTimer(Stage::Read);
+    Rsl::AddBytesRead(50);
+  }
+
+  const Rsl::LoadStats::Timings& resTimings = stats.mResStats[0].mTimings;
+  double decodeSeconds = StageSeconds(resTimings, Stage::Decode);
+  double readSeconds = StageSeconds(resTimings, Stage::Read);
+  std::cout << "Resources: " << stats.mResStats.Size() << '\n'
+            << "Name: " << stats.mResStats[0].mName << '\n'
+            << "Bytes Read: " << resTimings.mBytesRead << ", "
+            << stats.mTotal.mBytesRead << '\n'
+            << "Decode Recorded: " << (decodeSeconds >= 0.01) << '\n'
+            << "Decode Paused: " << (decodeSeconds < readSeconds) << '\n'
+            << "Read Recorded: " << (readSeconds >= 0.02) << '\n'
+            << "Totals Match: "
+            << (StageSeconds(stats.mTotal, Stage::Read) == readSeconds) << '\n'
+            << "Upload: " << StageSeconds(resTimings, Stage::Upload) << '\n';
+}
+
+void NestedScopes() {
+  using Stage = Rsl::LoadStats::Stage;
+  Rsl::LoadStats outerStats;
+  Rsl::LoadStats innerStats;
+  Rsl::LoadStats::Scope outerScope(&outerStats);
+  Rsl::LoadStats::BeginRes("outer", ResTypeId::Model);
+  Rsl::StageTimer decodeTimer(Stage::Decode);
+  {
+    // The outer stage and resource aren't recorded to the inner stats.
+    Rsl::LoadStats::Scope innerScope(&innerStats);
+    Rsl::StageTimer readTimer(Stage::Read);
+    Rsl::AddBytesRead(10);
+    Wait(5);
+  }
+  Rsl::AddBytesRead(20);
+  std::cout << "Outer Bytes: " << outerStats.mTotal.mBytesRead << '\n'
+            << "Inner Bytes: " << innerStats.mTotal.mBytesRead << '\n'
+            << "Inner Resources: " << innerStats.mResStats.Size() << '\n'
+            << "Inner Decode: "
+            << StageSeconds(innerStats.mTotal, Stage::Decode) << '\n'
+            << "Outer Read: " << StageSeconds(outerStats.mTotal, Stage::Read)
+            << '\n';
+}
+
+void FinalizeWait() {
+  using Stage = Rsl::LoadStats::Stage;
+  Rsl::LoadStats stats;
+  stats.BeginFinalize();
+  std::cout << "Before Init: "
+            << StageSeconds(stats.mTotal, Stage::FinalizeWait) << '\n';
+  stats.EndInit();
+  Wait(5);
+  stats.BeginFinalize();
+  double waitSeconds = StageSeconds(stats.mTotal, Stage::FinalizeWait);
+  Wait(5);
+  // Only the first call after initialization records the wait.
+  stats.BeginFinalize();
+  std::cout << "Recorded: " << (waitSeconds >= 0.005) << '\n'
+            << "Recorded Once: "
+            << (StageSeconds(stats.mTotal, Stage::FinalizeWait) == waitSeconds)
+            << '\n';
+  stats.Clear();
+  std::cout << "Cleared: " << StageSeconds(stats.mTotal, Stage::FinalizeWait)
+            << '\n';
+}
+
+void Write() {
+  Rsl::RegisterResourceTypes();
+  Rsl::LoadStats stats;
+  stats.mTotal.mSeconds[(int)Rsl::LoadStats::Stage::Read] = 0.5;
+  stats.mTotal.mSeconds[(int)Rsl::LoadStats::Stage::Parse] = 0.25;
+  stats.mTotal.mSeconds[(int)Rsl::LoadStats::Stage::FinalizeWait] = 2.0;
+  stats.mTotal.mBytesRead = 1024;
+  Rsl::LoadStats::ResStats resStats;
+  resStats.mName = "quoted \"name\"";
+  resStats.mResTypeId = ResTypeId::Mesh;
+  resStats.mTimings.mSeconds[(int)Rsl::LoadStats::Stage::Read] = 0.125;
+  resStats.mTimings.mSeconds[(int)Rsl::LoadStats::Stage::Upload] = 0.0625;
+  resStats.mTimings.mBytesRead = 512;
+  stats.mResStats.Push(resStats);
+  resStats.mName = "image";
+  resStats.mResTypeId = ResTypeId::Image;
+  stats.mResStats.Push(resStats);
+
+  Rsl::LoadStats::WriteCsvHeader(std::cout);
+  stats.WriteCsv(std::cout, "vres/asset");
+  std::cout << '\n';
+  stats.WriteJson(std::cout, "vres/asset");
+  std::cout << '\n';
+}
+
+int main(void) {
+  EnableLeakOutput();
+  RunTest(StageTimers);
+  RunTest(NestedScopes);
+  RunTest(FinalizeWait);
+  RunTest(Write);
+}
@@ -0,0 +1,178 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "debug/MemLeak.h"
+#include "rsl/Cook.h"
+#include "rsl/Pack.h"
+#include "test/Test.h"
+
+void PrintRoundTrip(const char* name, const std::string& data) {
+  Ds::Vector<char> compressed;
+  Rsl::CompressLz4(data.data(), data.size(), &compressed);
+  Ds::Vector<char> decompressed;
+  decompressed.Resize(data.size());
+  bool success = Rsl::DecompressLz4(
+    compressed.CData(), compressed.Size(), decompressed.Data(), data.size());
+  bool same = memcmp(decompressed.CData(), data.data(), data.size()) == 0;
+  std::cout << name << ": " << data.size() << " -> " << compressed.Size()
+            << ", " << success << ", " << same << '\n';
+}
+
+void Lz4RoundTrip() {
+  PrintRoundTrip("Empty", "");
+  PrintRoundTrip("Short", "abc");
+  PrintRoundTrip("Literals", "the quick brown fox jumps over the lazy dog");
+  std::string repeated;
+  for (int i = 0; i < 1000; ++i) {
+    repeated += "Type: Image\n";
+  }
+  PrintRoundTrip("Repeated", repeated);
+  PrintRoundTrip("Run", std::string(5000, 'x'));
+  std::string mixed;
+  for (int i = 0; i < 2000; ++i) {
+    mixed += std::to_string(i * 7919 % 1000) + ',';
+  }
+  PrintRoundTrip("Mixed", mixed);
+}
+
+void Lz4Malformed() {
+  std::string data(100, 'y');
+  Ds::Vector<char> compressed;
+  Rsl::CompressLz4(data.data(), data.size(), &compressed);
+  char decompressed[100];
+
+  // The output size must match exactly.
+  std::cout << "Small Output: "
+            << Rsl::DecompressLz4(
+                 compressed.CData(), compressed.Size(), decompressed, 99)
+            << '\n';
+  // Truncated input fails.
+  std::cout << "Truncated: "
+            << Rsl::DecompressLz4(
+                 compressed.CData(), compressed.Size() - 3, decompressed, 100)
+            << '\n';
+  // An offset that reaches before the start of the output fails.
+  const char badOffset[] = {0x10, 'a', 0x09, 0x00};
+  std::cout << "Bad Offset: "
+            << Rsl::DecompressLz4(badOffset, 4, decompressed, 5) << '\n';
+}
+
+Rsl::Pack::Input MakeInput(const std::string& path, const std::string& data) {
+  Rsl::Pack::Input input;
+  input.mPath = path;
+  input.mData.Resize(data.size());
+  memcpy(input.mData.Data(), data.data(), data.size());
+  return input;
+}
+
+void PackWriteRead() {
+  std::string repeated;
+  for (int i = 0; i < 100; ++i) {
+    repeated += "repeated ";
+  }
+  Ds::Vector<Rsl::Pack::Input> inputs;
+  inputs.Push(MakeInput("vres/b.a", "[{:Name: b}]"));
+  inputs.Push(MakeInput("cooked/0.ck", repeated));
+  inputs.Push(MakeInput("vres/a.a", "[{:Name: a}]"));
+  Result result = Rsl::Pack::Write("test.pack", &inputs, true);
+  std::cout << "Write: " << result.Success() << '\n';
+
+  Rsl::Pack pack;
+  result = pack.Open("test.pack");
+  std::cout << "Open: " << result.Success() << '\n';
+  for (const Rsl::Pack::Entry& entry: pack.GetEntries()) {
+    VResult<Rsl::FileData> readResult = pack.Read(entry);
+    std::cout << entry.mPath << ": " << entry.mStoredSize << ", "
+              << entry.mSize << ", " << (int)entry.mCompression << ", "
+              << readResult.Success() << ", "
+              << (strlen(readResult.mValue.mData) == entry.mSize) << '\n';
+  }
+  const Rsl::Pack::Entry* entry = pack.TryGetEntry("vres/b.a");
+  std::cout << "Found: " << pack.Read(*entry).mValue.mData << '\n'
+            << "Missing: " << (pack.TryGetEntry("vres/c.a") == nullptr)
+            << '\n';
+  pack.Close();
+  std::cout << "Closed: " << pack.IsOpen() << '\n';
+
+  // Mounted packs serve resource files.
+  Rsl::MountPack("test.pack");
+  VResult<Rsl::FileData> readResult = Rsl::ReadResFile("vres/a.a");
+  std::cout << "Mounted: " << readResult.mValue.mData << '\n';
+  Rsl::UnmountPack();
+  std::filesystem::remove("test.pack");
+}
+
+Rsl::Pack::Input MakeCookedInput(size_t cookKey, const std::string& data) {
+  Rsl::CookedRes cookedRes;
+  cookedRes.mBlob.Write(data);
+  Rsl::Pack::Input input;
+  input.mPath = Rsl::CookPackPath(cookKey);
+  input.mData = std::move(Rsl::SerializeCookedRes(cookedRes).mValue.mData);
+  return input;
+}
+
+void PackCookedRes() {
+  std::string repeated;
+  for (int i = 0; i < 100; ++i) {
+    repeated += "repeated ";
+  }
+
+  // Uncompressed cooked data is read in place from the mapped pack and
+  // compressed cooked data is read from the decompressed entry.
+  for (bool compress: {false, true}) {
+    Ds::Vector<Rsl::Pack::Input> inputs;
+    inputs.Push(MakeCookedInput(0, repeated));
+    Rsl::Pack::Write("test.pack", &inputs, compress);
+    Rsl::MountPack("test.pack");
+    const Rsl::Pack::Entry* entry =
+      Rsl::nPack.TryGetEntry(Rsl::CookPackPath(0));
+    VResult<Rsl::FileData> entryResult = Rsl::nPack.Read(*entry);
+    const char* entryData = entryResult.mValue.mData;
+    VResult<Rsl::CookedRes> readResult = Rsl::ReadCookedRes(0);
+    Rsl::Blob& blob = readResult.mValue.mBlob;
+    bool inPlace =
+      blob.Data() >= entryData && blob.Data() < entryData + entry->mSize;
+    std::string content;
+    blob.Read(&content);
+    std::cout << compress << ": " << readResult.Success() << ", "
+              << (int)entry->mCompression << ", " << inPlace << ", "
+              << (content == repeated) << '\n';
+    Rsl::UnmountPack();
+  }
+
+  // Writing to a blob that views the pack copies the viewed data first.
+  Ds::Vector<Rsl::Pack::Input> inputs;
+  inputs.Push(MakeCookedInput(0, "cooked"));
+  Rsl::Pack::Write("test.pack", &inputs, false);
+  Rsl::MountPack("test.pack");
+  VResult<Rsl::CookedRes> readResult = Rsl::ReadCookedRes(0);
+  Rsl::Blob& blob = readResult.mValue.mBlob;
+  blob.Write(std::string("written"));
+  std::string content, written;
+  blob.Read(&content);
+  blob.Read(&written);
+  std::cout << "Write: " << content << ", " << written << '\n';
+  Rsl::UnmountPack();
+  std::filesystem::remove("test.pack");
+}
+
+void PackInvalid() {
+  Rsl::Pack pack;
+  std::cout << pack.Open("missing.pack") << '\n';
+  std::ofstream stream("bad.pack", std::ofstream::binary);
+  stream << "not a pack file at all";
+  stream.close();
+  std::cout << pack.Open("bad.pack") << '\n';
+  std::filesystem::remove("bad.pack");
+}
+
+int main(void) {
+  EnableLeakOutput();
+  RunTest(Lz4RoundTrip);
+  RunTest(Lz4Malformed);
+  RunTest(PackWriteRead);
+  RunTest(PackCookedRes);
+  RunTest(PackInvalid);
+}
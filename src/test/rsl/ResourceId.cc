@@ -0,0 +1,83 @@
+#include <iostream>
+#include <thread>
+
+#include "debug/MemLeak.h"
+#include "rsl/ResourceId.h"
+#include "test/Test.h"
+
+void PrintResId(const ResId& resId) {
+  std::cout << "[Id: " << resId.GetId()
+            << ", AssetName: " << resId.GetAssetName()
+            << ", ResourceName: " << resId.GetResourceName() << "]\n";
+}
+
+void Constructor() {
+  ResId a;
+  ResId b("asset:resource");
+  ResId c(std::string("asset"));
+  ResId d("asset", "resource");
+  ResId e(":resource");
+  PrintResId(a);
+  PrintResId(b);
+  PrintResId(c);
+  PrintResId(d);
+  PrintResId(e);
+}
+
+void Interning() {
+  // Equal ids share a single interned entry.
+  ResId a("asset:resource");
+  ResId b("asset", "resource");
+  ResId c("asset:other");
+  std::cout << "a == b: " << (a == b) << '\n'
+            << "a != c: " << (a != c) << '\n'
+            << "Same Index: " << (a.GetIndex() == b.GetIndex()) << '\n'
+            << "Same Hash: " << (a.GetHash() == b.GetHash()) << '\n'
+            << "Different Index: " << (a.GetIndex() != c.GetIndex()) << '\n';
+  c = "asset:resource";
+  std::cout << "a == c: " << (a == c) << '\n';
+}
+
+void SetResourceName() {
+  ResId a("asset:resource");
+  a.SetResourceName("other");
+  PrintResId(a);
+  std::cout << "a == asset:other: " << (a == ResId("asset:other")) << '\n';
+  ResId b("asset");
+  b.SetResourceName("resource");
+  PrintResId(b);
+}
+
+void Threads() {
+  // Interning the same ids from multiple threads results in the same entries.
+  constexpr int threadCount = 4;
+  constexpr int idCount = 100;
+  ResId ids[threadCount][idCount];
+  std::thread threads[threadCount];
+  for (int t = 0; t < threadCount; ++t) {
+    threads[t] = std::thread([&ids, t]() {
+      for (int i = 0; i < idCount; ++i) {
+        ids[t][i] = "thread:" + std::to_string(i);
+      }
+    });
+  }
+  for (std::thread& thread: threads) {
+    thread.join();
+  }
+  bool allEqual = true;
+  for (int t = 1; t < threadCount; ++t) {
+    for (int i = 0; i < idCount; ++i) {
+      allEqual = allEqual && ids[0][i] == ids[t][i];
+    }
+  }
+  std::cout << "All Equal: " << allEqual << '\n';
+  PrintResId(ids[2][42]);
+}
+
+int main(void) {
+  EnableLeakOutput();
+  RunTest(Constructor);
+  RunTest(Interning);
+  RunTest(SetResourceName);
+  RunTest(Threads);
+}
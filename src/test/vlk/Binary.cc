@@ -0,0 +1,92 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "debug/MemLeak.h"
+#include "test/Test.h"
+#include "vlk/Binary.h"
+#include "vlk/Value.h"
+
+size_t FileSize(const char* filename) {
+  std::ifstream stream(filename, std::ifstream::binary | std::ifstream::ate);
+  return (size_t)stream.tellg();
+}
+
+void RoundTrip() {
+  Vlk::Value textVal;
+  textVal.Read("../vlk_Value/SerializeDeserialize.vlk");
+  Result result = textVal.WriteBinary("RoundTrip.vlkb");
+  std::cout << "WriteBinary: " << result.Success() << '\n';
+
+  Vlk::Value binaryVal;
+  result = binaryVal.ReadBinary("RoundTrip.vlkb");
+  std::cout << "ReadBinary: " << result.Success() << '\n'
+            << "Matches: " << (binaryVal == textVal) << '\n';
+  textVal.Write("RoundTrip.vlk");
+  std::cout << "Smaller: "
+            << (FileSize("RoundTrip.vlkb") < FileSize("RoundTrip.vlk")) << '\n';
+
+  // Read detects binary files.
+  Vlk::Value readVal;
+  result = readVal.Read("RoundTrip.vlkb");
+  std::cout << "Read: " << result.Success() << '\n'
+            << "Matches: " << (readVal == textVal) << '\n';
+  std::remove("RoundTrip.vlkb");
+  std::remove("RoundTrip.vlk");
+}
+
+void TrueValues() {
+  // Only TrueValues that are formatted the same way as numbers are stored as
+  // numbers, so all of these TrueValues remain unchanged.
+  Vlk::Value rootVal;
+  const char* trueValues[] = {
+    "0", "-1", "9223372036854775807", "-9223372036854775808",
+    "18446744073709551616", "007", "+5", "1.0", "0.5", "-2.25", "1e+10",
+    "3.1415927", "inf", "", "text", "It's \\ escaped"};
+  for (const char* trueValue: trueValues) {
+    rootVal.PushValue(std::string(trueValue));
+  }
+  std::string data;
+  Vlk::Encoder encoder;
+  encoder.Encode(rootVal, &data);
+  Vlk::Value decodedVal;
+  Result result = decodedVal.ParseBinary(data.data(), data.size());
+  std::cout << "Success: " << result.Success() << '\n' << decodedVal << '\n';
+  std::cout << "Matches: " << (decodedVal == rootVal) << '\n';
+}
+
+void Errors() {
+  Vlk::Value rootVal;
+  rootVal("Key")[{2}];
+  rootVal("Key")[0] = "Text";
+  rootVal("Key")[1] = 5;
+  std::string data;
+  Vlk::Encoder encoder;
+  encoder.Encode(rootVal, &data);
+
+  Vlk::Value noHeaderVal;
+  std::cout << noHeaderVal.ParseBinary("{}", 2).mError << '\n';
+  Vlk::Value versionVal;
+  std::string versionData = data;
+  versionData[4] = 2;
+  std::cout
+    << versionVal.ParseBinary(versionData.data(), versionData.size()).mError
+    << '\n';
+  for (size_t size: {(size_t)5, (size_t)8, data.size() - 1}) {
+    Vlk::Value truncatedVal;
+    Result result = truncatedVal.ParseBinary(data.data(), size);
+    std::cout << size << ": " << result.mError << " "
+              << (truncatedVal.GetType() == Vlk::Value::Type::Invalid) << '\n';
+  }
+  Vlk::Value missingVal;
+  std::cout << missingVal.ReadBinary("Missing.vlkb").mError << '\n';
+}
+
+int main(void) {
+  EnableLeakOutput();
+  RunTest(RoundTrip);
+  RunTest(TrueValues);
+  RunTest(Errors);
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "debug/MemLeak.h"
+#include "test/Test.h"
+#include "vlk/Document.h"
+#include "vlk/Value.h"
+
+bool Matches(const Vlk::View& view, const Vlk::Value& val) {
+  if (view.GetType() != val.GetType()) {
+    return false;
+  }
+  switch (val.GetType()) {
+  case Vlk::Value::Type::TrueValue:
+    return view.As<std::string>() == val.As<std::string>();
+  case Vlk::Value::Type::ValueArray:
+    if (view.Size() != val.Size()) {
+      return false;
+    }
+    for (size_t i = 0; i < val.Size(); ++i) {
+      if (!Matches(view[i], val[i])) {
+        return false;
+      }
+    }
+    return true;
+  case Vlk::Value::Type::PairArray:
+    if (view.Size() != val.Size()) {
+      return false;
+    }
+    for (size_t i = 0; i < val.Size(); ++i) {
+      const Vlk::Pair& pair = *val.TryGetConstPair(i);
+      if (view(i).Key() != pair.Key() || !Matches(view(i), pair)) {
+        return false;
+      }
+    }
+    return true;
+  default: return true;
+  }
+}
+
+void Read() {
+  Vlk::Document document;
+  Result result = document.Read("../vlk_Value/SerializeDeserialize.vlk");
+  std::cout << "Success: " << result.Success() << '\n';
+  const Vlk::View& rootView = document.Root();
+  const Vlk::View& containerView = rootView("Container");
+  std::cout << "Integer: " << rootView("Integer").As<int>() << '\n'
+            << "Float: " << rootView("Floats")[2].As<float>() << '\n'
+            << "String: " << containerView("Strings")[1][1].As<std::string>()
+            << '\n'
+            << "Sentence: " << containerView("SentenceString").TrueValue()
+            << '\n'
+            << "PairArray Size: " << rootView(3).Size() << '\n'
+            << "PairArray Key: " << rootView(3).Key() << '\n'
+            << "Other Key: " << rootView("ArrayOfPairArrays")[1](1).Key()
+            << '\n'
+            << "Invalid Pair: " << (rootView.TryGetPair("Invalid") == nullptr)
+            << '\n'
+            << "Invalid Value: " << (rootView.TryGetValue(0) == nullptr) << '\n'
+            << "Default: " << rootView("Container").As<int>(-1) << '\n';
+
+  Vlk::Value rootVal;
+  rootVal.Read("../vlk_Value/SerializeDeserialize.vlk");
+  std::cout << "Matches Value: " << Matches(rootView, rootVal) << '\n';
+}
+
+void Escapes() {
+  Vlk::Document document;
+  document.Parse("'It\\'s a \\\\ and \\'quote\\''");
+  std::string_view quote = document.Root().TrueValue();
+  std::cout << "Quote: " << quote << '\n'
+            << "Key: " << document.Root().Key().empty() << '\n';
+
+  document.Parse("{:Plain: 'No escapes'}");
+  std::cout << "Plain: " << document.Root()("Plain").TrueValue() << '\n';
+}
+
+void ParserError() {
+  Vlk::Document document;
+  Result result = document.Parse("{:Missing: [}");
+  std::cout << result.mError << '\n'
+            << "Invalid Root: "
+            << (document.Root().GetType() == Vlk::Value::Type::Invalid)
+            << '\n';
+  result = document.Parse("{:Valid: []}");
+  std::cout << "Success: " << result.Success() << '\n'
+            << "Empty Size: " << document.Root()("Valid").Size() << '\n';
+}
+
+int main(void) {
+  EnableLeakOutput();
+  RunTest(Read);
+  RunTest(Escapes);
+  RunTest(ParserError);
+}
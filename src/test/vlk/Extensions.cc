@@ -37,7 +37,60 @@ void VectorDeserialize() {
   std::cout << vec4Ex("4").As<Vec4>({16.0f, 17.0f, 18.0f, 19.0f}) << '\n';
 }
 
+void NumberSerialize() {
+  // Floats are written with the fewest digits that read back as the same float.
+  Vlk::Value root;
+  root("float") = 3.14159265f;
+  root("double") = 0.1;
+  root("int") = -2147483647 - 1;
+  root("unsigned") = 18446744073709551615ull;
+  root("quat") = Quat(0.5f, 0.25f, 1.0f / 3.0f, 1e-8f);
+  Ds::Vector<int> vector;
+  for (int i = 0; i < 4; ++i) {
+    vector.Push(i * 100);
+  }
+  root("vector") = vector;
+  PrintParsePrint(root);
+
+  Vlk::Explorer rootEx(root);
+  std::cout << (rootEx("float").As<float>() == 3.14159265f) << '\n'
+            << (rootEx("quat").As<Quat>()[2] == 1.0f / 3.0f) << '\n'
+            << rootEx("vector").As<Ds::Vector<int>>()[3] << '\n';
+}
+
+void NumberDeserialize() {
+  // Numbers that can't be read use the default.
+  Vlk::Value rootVal;
+  rootVal.Parse(
+    "{:Text: 'text' :Large: '99999999999' :Negative: '-1' :Array: ['1', 'x']}");
+  Vlk::Explorer rootEx(rootVal);
+  std::cout << rootEx("Text").As<float>(-1.0f) << '\n'
+            << rootEx("Large").As<int>(-1) << '\n'
+            << rootEx("Negative").As<unsigned int>(1) << '\n'
+            << rootEx("Array").As<Vec2>({2.0f, 3.0f}) << '\n';
+}
+
+void NumberDeserializeTrailing() {
+  // Text after a number makes the whole value invalid.
+  Vlk::Value rootVal;
+  rootVal.Parse("{:Int: '12abc' :Float: '1.5x' :Array: ['1', '2', '3x']}");
+  Vlk::Explorer rootEx(rootVal);
+  std::cout << rootEx("Int").As<int>(-1) << '\n'
+            << rootEx("Float").As<float>(-1.0f) << '\n';
+
+  // A vector that fails to deserialize keeps only its original elements.
+  Ds::Vector<int> vector;
+  vector.Push(7);
+  bool deserialized = Vlk::Converter<Ds::Vector<int>>::Deserialize(
+    rootVal("Array"), &vector);
+  std::cout << deserialized << ", " << vector.Size() << ", " << vector[0]
+            << '\n';
+}
+
 int main() {
   RunTest(VectorSerialize);
   RunTest(VectorDeserialize);
+  RunTest(NumberSerialize);
+  RunTest(NumberDeserialize);
+  RunTest(NumberDeserializeTrailing);
 }
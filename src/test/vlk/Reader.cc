@@ -0,0 +1,132 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "debug/MemLeak.h"
+#include "test/Test.h"
+#include "vlk/Reader.h"
+#include "vlk/Value.h"
+
+const char* EventName(Vlk::Reader::Event event) {
+  switch (event) {
+  case Vlk::Reader::Event::BeginPairArray: return "BeginPairArray";
+  case Vlk::Reader::Event::EndPairArray: return "EndPairArray";
+  case Vlk::Reader::Event::BeginValueArray: return "BeginValueArray";
+  case Vlk::Reader::Event::EndValueArray: return "EndValueArray";
+  case Vlk::Reader::Event::Key: return "Key";
+  case Vlk::Reader::Event::TrueValue: return "TrueValue";
+  case Vlk::Reader::Event::End: return "End";
+  }
+  return "Invalid";
+}
+
+void PrintEvents(Vlk::Reader* reader) {
+  while (true) {
+    VResult<Vlk::Reader::Event> result = reader->Next();
+    if (!result.Success()) {
+      std::cout << result.mError << '\n';
+      return;
+    }
+    Vlk::Reader::Event event = result.mValue;
+    std::cout << EventName(event);
+    if (event == Vlk::Reader::Event::Key) {
+      std::cout << ": " << reader->Key();
+    }
+    else if (event == Vlk::Reader::Event::TrueValue) {
+      std::cout << ": " << reader->TrueValue();
+    }
+    std::cout << '\n';
+    if (event == Vlk::Reader::Event::End) {
+      return;
+    }
+  }
+}
+
+void Events() {
+  Vlk::Reader reader;
+  reader.Start(
+    "{\n"
+    "  :Integer: '5'\n"
+    "  :Escaped: 'It\\'s \\\\ escaped'\n"
+    "  :Arrays: [['0', '1',], [], {:Key: '2'}]\n"
+    "  :Empty: {}\n"
+    "}");
+  PrintEvents(&reader);
+  VResult<Vlk::Reader::Event> result = reader.Next();
+  std::cout << "After End: " << EventName(result.mValue) << '\n';
+}
+
+void ReadSkipValue() {
+  Vlk::Reader reader;
+  Result result = reader.Open("../vlk_Value/SerializeDeserialize.vlk");
+  std::cout << "Open: " << result.Success() << '\n';
+  reader.Next();
+  while (reader.Next().mValue == Vlk::Reader::Event::Key) {
+    if (reader.Key() != "Container") {
+      std::cout << "Skipped: " << reader.Key() << '\n';
+      reader.SkipValue();
+      continue;
+    }
+    Vlk::Value containerVal;
+    reader.ReadValue(&containerVal);
+    std::cout << containerVal << '\n';
+  }
+
+  // Reading the entire file creates the same Value as parsing it.
+  Vlk::Value readVal;
+  reader.Open("../vlk_Value/SerializeDeserialize.vlk");
+  reader.ReadValue(&readVal);
+  Vlk::Value parsedVal;
+  parsedVal.Read("../vlk_Value/SerializeDeserialize.vlk");
+  std::cout << "Matches Parse: " << (readVal == parsedVal) << '\n';
+}
+
+void LargeFile() {
+  // The file is larger than the Reader's buffer and contains a TrueValue that
+  // needs the buffer to grow.
+  Vlk::Value rootVal;
+  for (int i = 0; i < 5000; ++i) {
+    Vlk::Value& memberVal = rootVal("Member" + std::to_string(i));
+    memberVal("Name") = "Member name " + std::to_string(i);
+    memberVal("Values")[{3}];
+    for (int j = 0; j < 3; ++j) {
+      memberVal("Values")[j] = i * j;
+    }
+  }
+  rootVal("Long") = std::string(200000, 'x') + "\\'";
+  rootVal.Write("Large.vlk");
+
+  Vlk::Reader reader;
+  reader.Open("Large.vlk");
+  Vlk::Value readVal;
+  Result result = reader.ReadValue(&readVal);
+  std::cout << "Success: " << result.Success() << '\n'
+            << "Matches: " << (readVal == rootVal) << '\n';
+  std::remove("Large.vlk");
+}
+
+void PrintErrors(const char* text) {
+  Vlk::Reader reader;
+  reader.Start(text);
+  Vlk::Value readVal;
+  std::cout << "Reader: " << reader.ReadValue(&readVal).mError << '\n';
+  Vlk::Value parsedVal;
+  std::cout << "Parser: " << parsedVal.Parse(text).mError << '\n';
+}
+
+void Errors() {
+  PrintErrors("{\n:Pair: '0'\n]");
+  PrintErrors("['0' '1']");
+  PrintErrors("[}");
+  PrintErrors("{:Pair:}");
+  PrintErrors("{\n\n:Pair: '0' ?}");
+  PrintErrors("");
+}
+
+int main(void) {
+  EnableLeakOutput();
+  RunTest(Events);
+  RunTest(ReadSkipValue);
+  RunTest(LargeFile);
+  RunTest(Errors);
+}
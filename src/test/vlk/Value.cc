@@ -342,6 +342,41 @@ void PushPopRemoveValue() {
   std::cout << arrayVal << '\n';
 }
 
+void LargePairArray() {
+  // These PairArrays are large enough for lookups to use an index.
+  Vlk::Value rootVal;
+  for (int i = 0; i < 100; ++i) {
+    rootVal("Key-" + std::to_string(i)) = i;
+  }
+  std::cout << "Key-7: " << rootVal("Key-7").As<int>() << '\n'
+            << "Key-99: " << rootVal.TryGetPairIndex("Key-99") << '\n'
+            << "Key-100: " << rootVal.TryGetPairIndex("Key-100") << '\n';
+
+  // Removing a Pair changes the indices of the Pairs after it.
+  rootVal.RemovePair("Key-10");
+  rootVal("Key-100") = 100;
+  std::cout << "Key-11: " << rootVal.TryGetPairIndex("Key-11") << '\n'
+            << "Key-10: " << rootVal.TryGetPairIndex("Key-10") << '\n'
+            << "Key-100: " << rootVal("Key-100").As<int>() << '\n'
+            << "Size: " << rootVal.Size() << '\n';
+
+  // Copies and moved Values find the same Pairs.
+  Vlk::Value copyVal = rootVal;
+  Vlk::Value movedVal = std::move(rootVal);
+  std::cout << "Copy Key-50: " << copyVal.TryGetPairIndex("Key-50") << '\n'
+            << "Moved Key-50: " << movedVal.TryGetPairIndex("Key-50") << '\n';
+
+  // The first of multiple Pairs with the same key is found.
+  std::string text = "{";
+  for (int i = 0; i < 40; ++i) {
+    text += ":Key-" + std::to_string(i % 20) + ": '" + std::to_string(i) + "'";
+  }
+  text += "}";
+  Vlk::Value parsedVal;
+  parsedVal.Parse(text.c_str());
+  std::cout << "Repeated Key-5: " << parsedVal("Key-5").As<int>() << '\n';
+}
+
 int main() {
   EnableLeakOutput();
   RunTest(TrueValue);
@@ -357,4 +392,5 @@ int main() {
   RunTest(Copy);
   RunTest(Comparison);
   RunTest(PushPopRemoveValue);
+  RunTest(LargePairArray);
 }
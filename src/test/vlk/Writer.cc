@@ -0,0 +1,103 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "debug/MemLeak.h"
+#include "test/Test.h"
+#include "vlk/Value.h"
+#include "vlk/Writer.h"
+
+void Events() {
+  std::string text;
+  Vlk::Writer writer;
+  writer.Start(&text);
+  writer.BeginPairArray();
+  writer.Key("Integer");
+  writer.TrueValue("5");
+  writer.Key("Escaped");
+  writer.TrueValue("It's \\ escaped");
+  writer.Key("Arrays");
+  writer.BeginValueArray();
+  writer.BeginValueArray();
+  writer.TrueValue("0");
+  writer.TrueValue("1");
+  writer.EndValueArray();
+  writer.BeginValueArray();
+  writer.EndValueArray();
+  writer.BeginPairArray();
+  writer.Key("Key");
+  writer.TrueValue("2");
+  writer.EndPairArray();
+  writer.EndValueArray();
+  writer.Key("Empty");
+  writer.BeginPairArray();
+  writer.EndPairArray();
+  writer.Key("Value");
+  Vlk::Value value;
+  value("Packed")[{3}];
+  for (int i = 0; i < 3; ++i) {
+    value("Packed")[i] = i;
+  }
+  value("Invalid");
+  writer.WriteValue(value);
+  writer.EndPairArray();
+  std::cout << text << '\n';
+
+  // The text can be parsed.
+  Vlk::Value parsedVal;
+  Result result = parsedVal.Parse(text.c_str());
+  std::cout << "Parse: " << result.Success() << '\n';
+}
+
+void MatchesFile() {
+  // WriteValue formats Values the same way they were formatted in the file.
+  std::ifstream stream("../vlk_Value/SerializeDeserialize.vlk");
+  std::stringstream fileText;
+  fileText << stream.rdbuf();
+  Vlk::Value rootVal;
+  rootVal.Read("../vlk_Value/SerializeDeserialize.vlk");
+
+  std::string text;
+  Vlk::Writer writer;
+  writer.Start(&text);
+  writer.WriteValue(rootVal);
+  std::cout << "Matches: " << (text == fileText.str()) << '\n';
+}
+
+void LargeFile() {
+  // The file is larger than the Writer's buffer, so it's written in chunks.
+  Vlk::Value expectedVal;
+  Vlk::Writer writer;
+  Result result = writer.Open("Large.vlk");
+  std::cout << "Open: " << result.Success() << '\n';
+  writer.BeginPairArray();
+  for (int i = 0; i < 5000; ++i) {
+    Vlk::Value memberVal;
+    memberVal("Name") = "Member name " + std::to_string(i);
+    memberVal("Values")[{3}];
+    for (int j = 0; j < 3; ++j) {
+      memberVal("Values")[j] = i * j;
+    }
+    std::string key = "Member" + std::to_string(i);
+    writer.Key(key);
+    writer.WriteValue(memberVal);
+    expectedVal(key) = std::move(memberVal);
+  }
+  writer.EndPairArray();
+  result = writer.Close();
+  std::cout << "Close: " << result.Success() << '\n';
+
+  Vlk::Value readVal;
+  readVal.Read("Large.vlk");
+  std::cout << "Matches: " << (readVal == expectedVal) << '\n';
+  std::remove("Large.vlk");
+}
+
+int main(void) {
+  EnableLeakOutput();
+  RunTest(Events);
+  RunTest(MatchesFile);
+  RunTest(LargeFile);
+}
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <sstream>
 
 #include "comp/Relationship.h"
 #include "comp/Type.h"
@@ -6,6 +7,9 @@
 #include "test/Test.h"
 #include "test/world/Print.h"
 #include "test/world/TestTypes.h"
+#include "vlk/Reader.h"
+#include "vlk/Valkor.h"
+#include "vlk/Writer.h"
 #include "world/Space.h"
 #include "world/Types.h"
 
@@ -389,6 +393,61 @@ void Slice() {
   printMemberVector(dynamicSlice);
 }
 
+void SerializeWriter() {
+  World::Space space;
+  World::MemberId parentId = space.CreateMember();
+  space.AddComponent<Simple0>(parentId).SetData(1);
+  space.AddComponent<Dynamic>(parentId);
+  World::MemberId childId = space.CreateChildMember(parentId);
+  space.AddComponent<Simple1>(childId).SetData(2);
+  space.AddComponent<Container>(childId).SetData(3);
+  space.CreateMember();
+
+  // Streaming a Space must create the same text as printing its Value.
+  std::string writerText;
+  Vlk::Writer writer;
+  writer.Start(&writerText);
+  space.Serialize(&writer);
+  Vlk::Value spaceVal;
+  space.Serialize(spaceVal);
+  std::stringstream valueText;
+  valueText << spaceVal;
+  std::cout << writerText << '\n'
+            << "Match: " << (writerText == valueText.str()) << '\n';
+}
+
+void DeserializeReader() {
+  World::Space space;
+  World::MemberId parentId = space.CreateMember();
+  space.AddComponent<Simple0>(parentId).SetData(4);
+  World::MemberId childId = space.CreateChildMember(parentId);
+  space.AddComponent<Simple1>(childId).SetData(5);
+  space.CreateMember();
+  Vlk::Value spaceVal;
+  space.Serialize(spaceVal);
+  std::stringstream spaceText;
+  spaceText << spaceVal;
+
+  // Reading a Space one event at a time must recreate the original Space.
+  std::string text = spaceText.str();
+  Vlk::Reader reader;
+  reader.Start(text.c_str());
+  World::Space readSpace;
+  Result result = readSpace.Deserialize(&reader);
+  std::cout << "Success: " << result.Success() << '\n';
+  PrintSpace(readSpace);
+  Vlk::Value readSpaceVal;
+  readSpace.Serialize(readSpaceVal);
+  std::stringstream readSpaceText;
+  readSpaceText << readSpaceVal;
+  std::cout << "Match: " << (readSpaceText.str() == text) << '\n';
+
+  // Unknown component types fail deserialization.
+  reader.Start("{:0: {:Invalid: {}}}");
+  World::Space invalidSpace;
+  std::cout << invalidSpace.Deserialize(&reader) << '\n';
+}
+
 int main(void) {
   Error::Init();
   RegisterComponentTypes();
@@ -411,4 +470,6 @@ int main(void) {
   RunTest(Duplicate3);
   RunCallCounterTest(Dependencies);
   RunTest(Slice);
+  RunTest(SerializeWriter);
+  RunTest(DeserializeReader);
 }
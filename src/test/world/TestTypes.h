@@ -79,6 +79,10 @@ struct Simple0 {
     val("m0") = m0;
     val("m1") = m1;
   }
+  void VDeserialize(const Vlk::Explorer& ex) {
+    m0 = ex("m0").As<float>();
+    m1 = ex("m1").As<float>();
+  }
 };
 
 std::ostream& operator<<(std::ostream& os, const Simple0& comp) {
@@ -100,6 +104,10 @@ struct Simple1 {
     val("m0") = m0;
     val("m1") = m1;
   }
+  void VDeserialize(const Vlk::Explorer& ex) {
+    m0 = ex("m0").As<double>();
+    m1 = ex("m1").As<int>();
+  }
 };
 
 std::ostream& operator<<(std::ostream& os, const Simple1& comp) {
@@ -0,0 +1,258 @@
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+#include "vlk/Binary.h"
+
+namespace Vlk {
+
+constexpr char nBinaryMagic[4] = {'V', 'L', 'K', 'B'};
+constexpr unsigned long long nBinaryVersion = 1;
+// Malformed data can't recurse deeper than this while decoding.
+constexpr size_t nMaxDecodeDepth = 1024;
+
+bool IsBinary(const char* data, size_t size) {
+  return size >= sizeof(nBinaryMagic) &&
+    memcmp(data, nBinaryMagic, sizeof(nBinaryMagic)) == 0;
+}
+
+void Encoder::Encode(const Value& value, std::string* data) {
+  mData = data;
+  AddKeys(value);
+
+  mData->append(nBinaryMagic, sizeof(nBinaryMagic));
+  WriteVarint(nBinaryVersion);
+  WriteVarint(mKeys.Size());
+  for (const std::string* key: mKeys) {
+    WriteString(*key);
+  }
+  WriteValue(value);
+}
+
+void Encoder::AddKeys(const Value& value) {
+  switch (value.mType) {
+  case Value::Type::ValueArray:
+    for (const Value& element: value.mValueArray) {
+      AddKeys(element);
+    }
+    break;
+  case Value::Type::PairArray:
+    for (const Pair& pair: value.mPairArray) {
+      if (!mKeyIndices.Contains(pair.Key())) {
+        mKeyIndices.Insert(pair.Key(), mKeys.Size());
+        mKeys.Push(&pair.Key());
+      }
+      AddKeys(pair);
+    }
+    break;
+  default: break;
+  }
+}
+
+void Encoder::WriteVarint(unsigned long long value) {
+  while (value >= 0x80) {
+    mData->push_back((char)((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  mData->push_back((char)value);
+}
+
+void Encoder::WriteString(const std::string& string) {
+  WriteVarint(string.size());
+  mData->append(string);
+}
+
+void Encoder::WriteValue(const Value& value) {
+  switch (value.mType) {
+  case Value::Type::TrueValue: WriteTrueValue(value.mTrueValue); break;
+  case Value::Type::ValueArray:
+    mData->push_back((char)ValueTag::ValueArray);
+    WriteVarint(value.mValueArray.Size());
+    for (const Value& element: value.mValueArray) {
+      WriteValue(element);
+    }
+    break;
+  case Value::Type::PairArray:
+    mData->push_back((char)ValueTag::PairArray);
+    WriteVarint(value.mPairArray.Size());
+    for (const Pair& pair: value.mPairArray) {
+      WriteVarint(mKeyIndices.Get(pair.Key()));
+      WriteValue(pair);
+    }
+    break;
+  default: mData->push_back((char)ValueTag::Invalid); break;
+  }
+}
+
+void Encoder::WriteTrueValue(const std::string& trueValue) {
+  // Numbers are only used when the decoded TrueValue will be identical.
+  const char* start = trueValue.data();
+  const char* end = start + trueValue.size();
+  long long integer;
+  std::from_chars_result intResult = std::from_chars(start, end, integer);
+  if (intResult.ec == std::errc() && intResult.ptr == end &&
+      std::to_string(integer) == trueValue) {
+    mData->push_back((char)ValueTag::Integer);
+    WriteVarint(((unsigned long long)integer << 1) ^ (integer >> 63));
+    return;
+  }
+
+  float number;
+  std::from_chars_result floatResult = std::from_chars(start, end, number);
+  if (floatResult.ec == std::errc() && floatResult.ptr == end) {
+    char text[32];
+    std::to_chars_result textResult = std::to_chars(text, text + 32, number);
+    if (std::string_view(text, textResult.ptr - text) == trueValue) {
+      unsigned int bits;
+      memcpy(&bits, &number, sizeof(bits));
+      mData->push_back((char)ValueTag::Float);
+      for (int i = 0; i < 4; ++i) {
+        mData->push_back((char)(bits >> (i * 8)));
+      }
+      return;
+    }
+  }
+
+  mData->push_back((char)ValueTag::String);
+  WriteString(trueValue);
+}
+
+Result Decoder::Decode(const char* data, size_t size, Value* root) {
+  if (!IsBinary(data, size)) {
+    return Result("Binary Valkor is missing its header.");
+  }
+  mData = data + sizeof(nBinaryMagic);
+  mEnd = data + size;
+  unsigned long long version;
+  if (!ReadVarint(&version) || version != nBinaryVersion) {
+    return Result("Binary Valkor has an unsupported version.");
+  }
+
+  size_t keyCount;
+  if (!ReadSize(&keyCount)) {
+    return Result("Binary Valkor is truncated.");
+  }
+  mKeys.Resize(keyCount);
+  for (std::string& key: mKeys) {
+    if (!ReadString(&key)) {
+      return Result("Binary Valkor is truncated.");
+    }
+  }
+  if (!ReadValue(root, 0)) {
+    root->Clear();
+    return Result("Binary Valkor is malformed.");
+  }
+  return Result();
+}
+
+bool Decoder::ReadVarint(unsigned long long* value) {
+  *value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (mData == mEnd) {
+      return false;
+    }
+    unsigned char byte = (unsigned char)*mData++;
+    *value |= (unsigned long long)(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Decoder::ReadSize(size_t* size) {
+  // Every element takes at least one byte, so a size can't exceed the number
+  // of remaining bytes. This prevents huge allocations for malformed data.
+  unsigned long long value;
+  if (!ReadVarint(&value) || value > (unsigned long long)(mEnd - mData)) {
+    return false;
+  }
+  *size = (size_t)value;
+  return true;
+}
+
+bool Decoder::ReadString(std::string* string) {
+  size_t length;
+  if (!ReadSize(&length)) {
+    return false;
+  }
+  string->assign(mData, length);
+  mData += length;
+  return true;
+}
+
+bool Decoder::ReadValue(Value* value, size_t depth) {
+  if (mData == mEnd || depth > nMaxDecodeDepth) {
+    return false;
+  }
+  ValueTag tag = (ValueTag)*mData++;
+  switch (tag) {
+  case ValueTag::Invalid: return true;
+  case ValueTag::String:
+    value->Init(Value::Type::TrueValue);
+    return ReadString(&value->mTrueValue);
+  case ValueTag::Integer: {
+    unsigned long long zigzag;
+    if (!ReadVarint(&zigzag)) {
+      return false;
+    }
+    long long integer = (long long)(zigzag >> 1) ^ -(long long)(zigzag & 1);
+    value->Init(Value::Type::TrueValue);
+    value->mTrueValue = std::to_string(integer);
+    return true;
+  }
+  case ValueTag::Float: {
+    if (mEnd - mData < 4) {
+      return false;
+    }
+    unsigned int bits = 0;
+    for (int i = 0; i < 4; ++i) {
+      bits |= (unsigned int)(unsigned char)mData[i] << (i * 8);
+    }
+    mData += 4;
+    float number;
+    memcpy(&number, &bits, sizeof(number));
+    char text[32];
+    std::to_chars_result textResult = std::to_chars(text, text + 32, number);
+    value->Init(Value::Type::TrueValue);
+    value->mTrueValue.assign(text, textResult.ptr - text);
+    return true;
+  }
+  case ValueTag::ValueArray: {
+    size_t count;
+    if (!ReadSize(&count)) {
+      return false;
+    }
+    value->Init(Value::Type::ValueArray);
+    value->mValueArray.Resize(count);
+    for (Value& element: value->mValueArray) {
+      if (!ReadValue(&element, depth + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  case ValueTag::PairArray: {
+    size_t count;
+    if (!ReadSize(&count)) {
+      return false;
+    }
+    value->Init(Value::Type::PairArray);
+    value->mPairArray.Reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      unsigned long long keyIndex;
+      if (!ReadVarint(&keyIndex) || keyIndex >= mKeys.Size()) {
+        return false;
+      }
+      value->mPairArray.Emplace(mKeys[(size_t)keyIndex]);
+      if (!ReadValue(&value->mPairArray.Top(), depth + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  default: return false;
+  }
+}
+
+} // namespace Vlk
@@ -0,0 +1,76 @@
+#ifndef vlk_Binary_h
+#define vlk_Binary_h
+
+#include <string>
+
+#include "Result.h"
+#include "ds/Map.h"
+#include "ds/Vector.h"
+#include "vlk/Value.h"
+
+// Binary Valkor stores the same data as Valkor text, but it's smaller and it
+// doesn't need to be tokenized. Keys are stored once in a dictionary and Pairs
+// refer to them by index. TrueValues that are integers or floats are stored as
+// numbers, but only when formatting the number gives back the exact TrueValue.
+// This keeps conversions between text and binary lossless.
+//
+// Layout
+// - Header: The "VLKB" magic and a version.
+// - Dictionary: A key count followed by every key.
+// - Root: The root Value.
+//
+// Values begin with a ValueTag. Strings are a length followed by characters,
+// integers are zigzag encoded, floats are four little-endian bytes, and arrays
+// are an element count followed by the elements. Every length, count, and index
+// is a LEB128 varint.
+
+namespace Vlk {
+
+enum class ValueTag : unsigned char {
+  Invalid,
+  String,
+  Integer,
+  Float,
+  ValueArray,
+  PairArray,
+  Count,
+};
+
+bool IsBinary(const char* data, size_t size);
+
+// An Encoder and a Decoder should only be used for a single Value.
+
+struct Encoder {
+public:
+  void Encode(const Value& value, std::string* data);
+
+private:
+  Ds::Map<std::string, size_t> mKeyIndices;
+  Ds::Vector<const std::string*> mKeys;
+  std::string* mData;
+
+  void AddKeys(const Value& value);
+  void WriteVarint(unsigned long long value);
+  void WriteString(const std::string& string);
+  void WriteValue(const Value& value);
+  void WriteTrueValue(const std::string& trueValue);
+};
+
+struct Decoder {
+public:
+  Result Decode(const char* data, size_t size, Value* root);
+
+private:
+  const char* mData;
+  const char* mEnd;
+  Ds::Vector<std::string> mKeys;
+
+  bool ReadVarint(unsigned long long* value);
+  bool ReadSize(size_t* size);
+  bool ReadString(std::string* string);
+  bool ReadValue(Value* value, size_t depth);
+};
+
+} // namespace Vlk
+
+#endif
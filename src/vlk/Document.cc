@@ -0,0 +1,172 @@
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "Error.h"
+#include "debug/MemTrack.h"
+#include "vlk/Document.h"
+#include "vlk/Parser.h"
+
+namespace Vlk {
+
+// Most documents fit within a single block. Larger documents add blocks that
+// are at least this large.
+constexpr size_t nDocumentBlockSize = 1 << 16;
+
+Value::Type View::GetType() const {
+  return mType;
+}
+
+size_t View::Size() const {
+  LogAbortIf(
+    mType != Value::Type::ValueArray && mType != Value::Type::PairArray,
+    "Only ValueArray and PairArray Views have a size.");
+  return mSize;
+}
+
+std::string_view View::Key() const {
+  return mKey;
+}
+
+std::string_view View::TrueValue() const {
+  LogAbortIf(
+    mType != Value::Type::TrueValue, "The View is not a TrueValue.");
+  return std::string_view(mTrueValue, mSize);
+}
+
+const View* View::TryGetPair(std::string_view key) const {
+  if (mType != Value::Type::PairArray) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < mSize; ++i) {
+    if (key == mChildren[i].mKey) {
+      return &mChildren[i];
+    }
+  }
+  return nullptr;
+}
+
+const View* View::TryGetPair(size_t index) const {
+  if (mType != Value::Type::PairArray || mSize <= index) {
+    return nullptr;
+  }
+  return &mChildren[index];
+}
+
+const View* View::TryGetValue(size_t index) const {
+  if (mType != Value::Type::ValueArray || mSize <= index) {
+    return nullptr;
+  }
+  return &mChildren[index];
+}
+
+const View& View::operator()(std::string_view key) const {
+  const View* pair = TryGetPair(key);
+  if (pair == nullptr) {
+    std::stringstream error;
+    error << "Pair with key \"" << key << "\" not found.";
+    LogAbort(error.str().c_str());
+  }
+  return *pair;
+}
+
+const View& View::operator()(size_t index) const {
+  const View* pair = TryGetPair(index);
+  LogAbortIf(pair == nullptr, "Pair index out of range.");
+  return *pair;
+}
+
+const View& View::operator[](size_t index) const {
+  const View* value = TryGetValue(index);
+  LogAbortIf(value == nullptr, "Value index out of range.");
+  return *value;
+}
+
+template<>
+bool View::Deserialize<std::string>(std::string* value) const {
+  if (mType != Value::Type::TrueValue) {
+    return false;
+  }
+  *value = TrueValue();
+  return true;
+}
+
+template<>
+bool View::Deserialize<std::string_view>(std::string_view* value) const {
+  if (mType != Value::Type::TrueValue) {
+    return false;
+  }
+  *value = TrueValue();
+  return true;
+}
+
+Document::Document(): mArena(nDocumentBlockSize) {
+  mRoot.mType = Value::Type::Invalid;
+  mRoot.mSize = 0;
+}
+
+Result Document::Read(const char* filename) {
+  // The file is read into a buffer of the file's size so the text is only
+  // allocated once.
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
+  if (!stream.is_open()) {
+    std::stringstream error;
+    error << "Failed to open \"" << filename << "\".";
+    return Result(error.str());
+  }
+  stream.seekg(0, std::ifstream::end);
+  std::string text((size_t)stream.tellg(), '\0');
+  stream.seekg(0, std::ifstream::beg);
+  stream.read(text.data(), text.size());
+  stream.close();
+
+  Result result = Parse(std::move(text));
+  if (!result.Success()) {
+    std::stringstream error;
+    error << filename << result.mError;
+    return Result(error.str());
+  }
+  return result;
+}
+
+Result Document::Parse(std::string&& text) {
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::Vlk);
+  Clear();
+  mText = std::move(text);
+  Parser parser;
+  Result result = parser.Parse(mText.c_str(), this);
+  if (!result.Success()) {
+    Clear();
+  }
+  return result;
+}
+
+const View& Document::Root() const {
+  return mRoot;
+}
+
+void Document::Clear() {
+  mText.clear();
+  mArena.Reset();
+  mRoot.mType = Value::Type::Invalid;
+  mRoot.mKey = {};
+  mRoot.mSize = 0;
+}
+
+const char* Document::CopyText(const char* text, size_t length) {
+  char* copy = (char*)mArena.Allocate(length);
+  memcpy(copy, text, length);
+  return copy;
+}
+
+const View* Document::CopyViews(const View* views, size_t count) {
+  if (count == 0) {
+    return nullptr;
+  }
+  View* copy = (View*)mArena.Allocate(sizeof(View) * count);
+  memcpy(copy, views, sizeof(View) * count);
+  return copy;
+}
+
+} // namespace Vlk
@@ -0,0 +1,144 @@
+#ifndef vlk_Document_h
+#define vlk_Document_h
+
+#include <charconv>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+#include "Error.h"
+#include "Result.h"
+#include "ds/Arena.h"
+#include "vlk/Value.h"
+
+namespace Vlk {
+
+// A Document is a read-only alternative to parsing text into a Value. The
+// Document keeps the text alive and the Views within it refer to that text
+// instead of owning copies of keys and TrueValues. Every View is allocated from
+// the Document's arena, so a large file is parsed without allocating for every
+// Value and the entire tree is freed at once.
+
+// Views are only valid while the Document that contains them exists. A Value
+// should be used instead when the tree needs to be modified.
+
+struct View {
+public:
+  Value::Type GetType() const;
+  size_t Size() const;
+  std::string_view Key() const;
+  std::string_view TrueValue() const;
+
+  const View* TryGetPair(std::string_view key) const;
+  const View* TryGetPair(size_t index) const;
+  const View* TryGetValue(size_t index) const;
+  const View& operator()(std::string_view key) const;
+  const View& operator()(size_t index) const;
+  const View& operator[](size_t index) const;
+
+  template<typename T>
+  T As() const;
+  template<typename T>
+  T As(const T& defaultValue) const;
+
+private:
+  Value::Type mType;
+  // Only Views within PairArrays have keys.
+  std::string_view mKey;
+  union {
+    const char* mTrueValue;
+    const View* mChildren;
+  };
+  // The length of a TrueValue or the number of children in an array.
+  size_t mSize;
+
+  template<typename T>
+  bool Deserialize(T* value) const;
+
+  friend struct Document;
+  friend struct Parser;
+};
+
+struct Document {
+public:
+  Document();
+  Document(const Document& other) = delete;
+  Document& operator=(const Document& other) = delete;
+
+  Result Read(const char* filename);
+  Result Parse(std::string&& text);
+  const View& Root() const;
+
+private:
+  std::string mText;
+  Ds::Arena mArena;
+  View mRoot;
+
+  void Clear();
+  const char* CopyText(const char* text, size_t length);
+  const View* CopyViews(const View* views, size_t count);
+
+  friend Parser;
+};
+
+// Deserializing from a View matches the Converters. Numbers are read with
+// from_chars and everything else with stream extraction. Both read directly
+// from the Document's text.
+struct ViewStreamBuffer: public std::streambuf {
+  ViewStreamBuffer(std::string_view text) {
+    char* start = const_cast<char*>(text.data());
+    setg(start, start, start + text.size());
+  }
+};
+
+template<typename T>
+bool View::Deserialize(T* value) const {
+  if (mType != Value::Type::TrueValue) {
+    return false;
+  }
+  std::string_view text = TrueValue();
+  if constexpr (IsNumber<T>) {
+    // The whole TrueValue must be the number. "12abc" is not 12.
+    const char* end = text.data() + text.size();
+    T number;
+    std::from_chars_result result = std::from_chars(text.data(), end, number);
+    if (result.ec != std::errc() || result.ptr != end) {
+      return false;
+    }
+    *value = number;
+    return true;
+  }
+  else {
+    ViewStreamBuffer buffer(text);
+    std::istream stream(&buffer);
+    stream >> *value;
+    return true;
+  }
+}
+
+template<>
+bool View::Deserialize<std::string>(std::string* value) const;
+template<>
+bool View::Deserialize<std::string_view>(std::string_view* value) const;
+
+template<typename T>
+T View::As() const {
+  T value;
+  bool deserialized = Deserialize(&value);
+  LogAbortIf(!deserialized, "As without a default failed deserialization.");
+  return value;
+}
+
+template<typename T>
+T View::As(const T& defaultValue) const {
+  T value;
+  if (!Deserialize(&value)) {
+    return defaultValue;
+  }
+  return value;
+}
+
+} // namespace Vlk
+
+#endif
@@ -15,24 +15,43 @@ namespace Vlk {
 template<typename T>
 struct Converter<Ds::Vector<T>> {
   static void Serialize(Value& val, const Ds::Vector<T>& vector) {
+    if constexpr (IsNumber<T>) {
+      NumberConverter<T>::SerializeArray(val, vector.CData(), vector.Size());
+      return;
+    }
     val[{vector.Size()}];
     for (int i = 0; i < vector.Size(); ++i) {
       val[i] = vector[i];
     }
   }
 
-  static void Deserialize(const Value& val, Ds::Vector<T>* vector) {
+  static bool Deserialize(const Value& val, Ds::Vector<T>* vector) {
+    if constexpr (IsNumber<T>) {
+      size_t start = vector->Size();
+      vector->Resize(start + val.Size());
+      if (!NumberConverter<T>::DeserializeArray(
+            val, vector->Data() + start, val.Size())) {
+        vector->Resize(start);
+        return false;
+      }
+      return true;
+    }
     for (int i = 0; i < val.Size(); ++i) {
       T element;
       Converter<T>::Deserialize(val[i], &element);
       vector->Push(element);
     }
+    return true;
   }
 };
 
 template<typename T, unsigned int N>
 struct Converter<Math::Vector<T, N>> {
   static void Serialize(Value& val, const Math::Vector<T, N>& value) {
+    if constexpr (IsNumber<T>) {
+      NumberConverter<T>::SerializeArray(val, value.mD, N);
+      return;
+    }
     val[{N}];
     for (int i = 0; i < N; ++i) {
       val[i] = value[i];
@@ -40,6 +59,9 @@ struct Converter<Math::Vector<T, N>> {
   }
 
   static bool Deserialize(const Value& val, Math::Vector<T, N>* value) {
+    if constexpr (IsNumber<T>) {
+      return NumberConverter<T>::DeserializeArray(val, value->mD, N);
+    }
     for (int i = 0; i < N; ++i) {
       const Value* element = val.TryGetConstValue(i);
       if (element == nullptr) {
@@ -56,23 +78,11 @@ struct Converter<Math::Vector<T, N>> {
 template<>
 struct Converter<Quat> {
   static void Serialize(Value& val, const Quat& quat) {
-    val[{4}];
-    for (int i = 0; i < 4; ++i) {
-      val[i] = quat[i];
-    }
+    NumberConverter<float>::SerializeArray(val, quat.mVec.mD, 4);
   }
 
   static bool Deserialize(const Value& val, Quat* quat) {
-    for (int i = 0; i < 4; ++i) {
-      const Value* element = val.TryGetConstValue(i);
-      if (element == nullptr) {
-        return false;
-      }
-      if (!Converter<float>::Deserialize(*element, quat->mVec.mD + i)) {
-        return false;
-      }
-    }
-    return true;
+    return NumberConverter<float>::DeserializeArray(val, quat->mVec.mD, 4);
   }
 };
 
@@ -98,14 +108,14 @@ template<>
 struct Converter<Rsl::ResId> {
   static void Serialize(Value& val, const ResId& value) {
     val.EnsureType(Value::Type::TrueValue);
-    val.mTrueValue = value.mId;
+    val.mTrueValue = value.GetId();
   }
 
   static bool Deserialize(const Value& val, ResId* value) {
     if (val.mType != Value::Type::TrueValue) {
       return false;
     }
-    value->mId = val.mTrueValue;
+    *value = val.mTrueValue;
     return true;
   }
 };
@@ -1,3 +1,4 @@
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -56,23 +57,51 @@ size_t Parser::LastTokenLength() {
   return mTokens[mCurrentToken].mText - lastToken.mText;
 }
 
-Result Parser::Parse(const char* text, Value* root) {
+Result Parser::Start(const char* text) {
   VResult<Ds::Vector<Token>> result = Tokenize(text);
   if (!result.Success()) {
     return Result(result.mError);
   }
   mCurrentToken = 0;
   mCurrentLine = 1;
-  mValueStack.Push(root);
   mTokens = std::move(result.mValue);
+  return Result();
+}
+
+Result Parser::ParseError(const char* error) {
+  std::stringstream errorStream;
+  errorStream << "[" << mCurrentLine << "] Parse Error: " << error;
+  return Result(errorStream.str());
+}
+
+Result Parser::Parse(const char* text, Value* root) {
+  Result result = Start(text);
+  if (!result.Success()) {
+    return result;
+  }
+  mValueStack.Push(root);
   try {
     Expect(ParseValue(), "Expected Value.");
   }
   catch (const char* error) {
-    std::stringstream errorStream;
-    errorStream << "[" << mCurrentLine << "] Parse Error: " << error;
-    return Result(errorStream.str());
+    return ParseError(error);
+  }
+  return Result();
+}
+
+Result Parser::Parse(const char* text, Document* document) {
+  Result result = Start(text);
+  if (!result.Success()) {
+    return result;
+  }
+  mDocument = document;
+  try {
+    Expect(ParseView({}), "Expected Value.");
+  }
+  catch (const char* error) {
+    return ParseError(error);
   }
+  document->mRoot = mViews.Top();
   return Result();
 }
 
@@ -178,4 +207,99 @@ bool Parser::ParseValueArrayList() {
   return true;
 }
 
+bool Parser::ParseView(std::string_view key) {
+  if (!Accept(Token::Type::TrueValue)) {
+    return ParsePairArrayView(key) || ParseValueArrayView(key);
+  }
+  mViews.Emplace();
+  View& view = mViews.Top();
+  view.mType = Value::Type::TrueValue;
+  view.mKey = key;
+
+  // The quotes surrounding the TrueValue are excluded from the View. Only
+  // TrueValues with escape sequences need their own copy of the text.
+  const char* text = LastToken().mText + 1;
+  size_t length = LastTokenLength() - 2;
+  const char* escape = (const char*)memchr(text, '\\', length);
+  if (escape == nullptr) {
+    view.mTrueValue = text;
+    view.mSize = length;
+    return true;
+  }
+  std::string trueValue(text, escape - text);
+  for (size_t i = escape - text; i < length; ++i) {
+    if (text[i] == '\\') {
+      ++i;
+    }
+    trueValue.push_back(text[i]);
+  }
+  view.mTrueValue = mDocument->CopyText(trueValue.data(), trueValue.size());
+  view.mSize = trueValue.size();
+  return true;
+}
+
+bool Parser::ParsePairArrayView(std::string_view key) {
+  if (!Accept(Token::Type::OpenBrace)) {
+    return false;
+  }
+  size_t firstChild = mViews.Size();
+  while (ParsePairView()) {
+  }
+  Expect(Token::Type::CloseBrace, "Expected } or Pair.");
+  EndArrayView(Value::Type::PairArray, key, firstChild);
+  return true;
+}
+
+bool Parser::ParseValueArrayView(std::string_view key) {
+  if (!Accept(Token::Type::OpenBracket)) {
+    return false;
+  }
+  size_t firstChild = mViews.Size();
+  ParseValueListView() || ParseValueArrayListView();
+  Expect(Token::Type::CloseBracket, "Expected ].");
+  EndArrayView(Value::Type::ValueArray, key, firstChild);
+  return true;
+}
+
+void Parser::EndArrayView(
+  Value::Type type, std::string_view key, size_t firstChild) {
+  // The children are replaced with the array that now owns them.
+  View view;
+  view.mType = type;
+  view.mKey = key;
+  view.mSize = mViews.Size() - firstChild;
+  view.mChildren =
+    mDocument->CopyViews(mViews.CData() + firstChild, view.mSize);
+  mViews.Resize(firstChild);
+  mViews.Push(view);
+}
+
+bool Parser::ParsePairView() {
+  if (!Accept(Token::Type::Key)) {
+    return false;
+  }
+  // We subtract 2 because text is wrapped with two colons.
+  std::string_view key(LastToken().mText + 1, LastTokenLength() - 2);
+  Expect(ParseView(key), "Expected Value.");
+  return true;
+}
+
+bool Parser::ParseValueListView() {
+  if (!ParseView({})) {
+    return false;
+  }
+  while (Accept(Token::Type::Comma) && ParseView({})) {
+  }
+  return true;
+}
+
+bool Parser::ParseValueArrayListView() {
+  if (!ParseValueArrayView({})) {
+    return false;
+  }
+  while (Accept(Token::Type::Comma) && ParseValueArrayView({})) {
+  }
+  return true;
+}
+
 } // namespace Vlk
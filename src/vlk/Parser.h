@@ -1,8 +1,11 @@
 #ifndef vlk_Parser_h
 #define vlk_Parser_h
 
+#include <string_view>
+
 #include "Result.h"
 #include "ds/Vector.h"
+#include "vlk/Document.h"
 #include "vlk/Tokenizer.h"
 #include "vlk/Value.h"
 
@@ -11,6 +14,7 @@ namespace Vlk {
 struct Parser {
 public:
   Result Parse(const char* text, Value* root);
+  Result Parse(const char* text, Document* document);
 
 private:
   size_t mCurrentToken;
@@ -18,6 +22,14 @@ private:
   Ds::Vector<Value*> mValueStack;
   Ds::Vector<Token> mTokens;
 
+  // When parsing a Document, the children of the arrays being parsed are kept
+  // here until the array is complete and they can be copied to the arena.
+  Document* mDocument;
+  Ds::Vector<View> mViews;
+
+  Result Start(const char* text);
+  Result ParseError(const char* error);
+
   bool Accept(Token::Type tokenType);
   bool Expect(Token::Type tokenType, const char* error);
   bool Expect(bool success, const char* error);
@@ -30,6 +42,14 @@ private:
   bool ParsePair();
   bool ParseValueList();
   bool ParseValueArrayList();
+
+  bool ParseView(std::string_view key);
+  bool ParsePairArrayView(std::string_view key);
+  bool ParseValueArrayView(std::string_view key);
+  void EndArrayView(Value::Type type, std::string_view key, size_t firstChild);
+  bool ParsePairView();
+  bool ParseValueListView();
+  bool ParseValueArrayListView();
 };
 
 } // namespace Vlk
@@ -0,0 +1,298 @@
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+#include "Error.h"
+#include "vlk/Reader.h"
+
+namespace Vlk {
+
+// The buffer grows when a single token needs more than half of it.
+constexpr size_t nReaderBufferSize = 1 << 16;
+
+Reader::Reader(): mBufferEnd(nullptr) {
+  Start("");
+}
+
+Result Reader::Open(const char* filename) {
+  if (mFile.is_open()) {
+    mFile.close();
+  }
+  mFile.clear();
+  mFile.open(filename, std::ifstream::in | std::ifstream::binary);
+  if (!mFile.is_open()) {
+    std::stringstream error;
+    error << "Failed to open \"" << filename << "\".";
+    return Result(error.str());
+  }
+  Reset();
+  mBuffer.Resize(nReaderBufferSize);
+  mBuffer[0] = '\0';
+  mText = mBuffer.Data();
+  mBufferEnd = mText;
+  return Result();
+}
+
+void Reader::Start(const char* text) {
+  if (mFile.is_open()) {
+    mFile.close();
+  }
+  Reset();
+  mText = text;
+  mBufferEnd = nullptr;
+}
+
+VResult<Reader::Event> Reader::Next() {
+  if (!mError.empty()) {
+    return Result(mError);
+  }
+  if (mExpect == Expect::Nothing) {
+    return Event::End;
+  }
+  while (true) {
+    Token token = NextToken();
+    if (token.mType == Token::Type::Invalid) {
+      std::stringstream error;
+      error << "[" << mCurrentLine << "] Invalid token: "
+            << std::string(token.mText, mTokenEnd - token.mText);
+      mError = error.str();
+      return Result(mError);
+    }
+
+    switch (mExpect) {
+    case Expect::Value: return BeginValue(token);
+    case Expect::PairOrClose:
+      if (token.mType == Token::Type::Key) {
+        // We subtract 2 because text is wrapped with two colons.
+        mKey = std::string_view(token.mText + 1, mTokenEnd - token.mText - 2);
+        mExpect = Expect::Value;
+        return Event::Key;
+      }
+      if (token.mType == Token::Type::CloseBrace) {
+        return EndValue(Event::EndPairArray);
+      }
+      return Fail("Expected } or Pair.");
+    case Expect::ValueOrClose:
+      if (token.mType == Token::Type::CloseBracket) {
+        return EndValue(Event::EndValueArray);
+      }
+      return BeginValue(token);
+    case Expect::CommaOrClose:
+      if (token.mType == Token::Type::Comma) {
+        mExpect = Expect::ValueOrClose;
+        continue;
+      }
+      if (token.mType == Token::Type::CloseBracket) {
+        return EndValue(Event::EndValueArray);
+      }
+      return Fail("Expected ].");
+    default: return Event::End;
+    }
+  }
+}
+
+std::string_view Reader::Key() const {
+  return mKey;
+}
+
+std::string_view Reader::TrueValue() const {
+  return mTrueValue;
+}
+
+Result Reader::ReadValue(Value* value) {
+  LogAbortIf(
+    value->GetType() != Value::Type::Invalid,
+    "ReadValue can only be used on an uninitialized Value.");
+  VResult<Event> result = Next();
+  if (!result.Success()) {
+    return Result(std::move(result.mError));
+  }
+  return ReadValue(result.mValue, value);
+}
+
+Result Reader::SkipValue() {
+  size_t depth = 0;
+  do {
+    VResult<Event> result = Next();
+    if (!result.Success()) {
+      return Result(std::move(result.mError));
+    }
+    switch (result.mValue) {
+    case Event::BeginPairArray:
+    case Event::BeginValueArray: ++depth; break;
+    case Event::EndPairArray:
+    case Event::EndValueArray: --depth; break;
+    default: break;
+    }
+  } while (depth > 0);
+  return Result();
+}
+
+void Reader::Reset() {
+  mExpect = Expect::Value;
+  mOpenArrays.Clear();
+  mCurrentLine = 1;
+  mError.clear();
+  mKey = {};
+  mTrueValue = {};
+}
+
+Token Reader::NextToken() {
+  while (true) {
+    // A token that reaches the end of the buffer may continue in the part of
+    // the file that hasn't been read yet, so it's read again after a refill.
+    const char* start = mText;
+    if (*mText == '\0') {
+      if (mText == mBufferEnd && Refill(&start)) {
+        mText = start;
+        continue;
+      }
+      mTokenEnd = mText;
+      return {mText, Token::Type::Terminator};
+    }
+    Token token = ReadToken(&mText);
+    if (mText == mBufferEnd && Refill(&start)) {
+      mText = start;
+      continue;
+    }
+    if (token.mType == Token::Type::Whitespace) {
+      mCurrentLine += CountNewLines(token.mText, mText);
+      continue;
+    }
+    mTokenEnd = mText;
+    return token;
+  }
+}
+
+bool Reader::Refill(const char** text) {
+  if (!mFile.is_open()) {
+    return false;
+  }
+  if (mFile.peek() == std::ifstream::traits_type::eof()) {
+    mFile.close();
+    return false;
+  }
+
+  // The text that hasn't been used is moved to the front of the buffer and the
+  // rest of the buffer is filled from the file.
+  size_t offset = *text - mBuffer.CData();
+  size_t keptSize = mBufferEnd - *text;
+  memmove(mBuffer.Data(), mBuffer.Data() + offset, keptSize);
+  if (keptSize * 2 > mBuffer.Size()) {
+    mBuffer.Resize(mBuffer.Size() * 2);
+  }
+  // One character is reserved for the null terminator.
+  char* readStart = mBuffer.Data() + keptSize;
+  mFile.read(readStart, mBuffer.Size() - keptSize - 1);
+  size_t readSize = (size_t)mFile.gcount();
+  readStart[readSize] = '\0';
+  mBufferEnd = readStart + readSize;
+  *text = mBuffer.Data();
+  return true;
+}
+
+VResult<Reader::Event> Reader::Fail(const char* error) {
+  std::stringstream errorStream;
+  errorStream << "[" << mCurrentLine << "] Parse Error: " << error;
+  mError = errorStream.str();
+  return Result(mError);
+}
+
+VResult<Reader::Event> Reader::BeginValue(const Token& token) {
+  switch (token.mType) {
+  case Token::Type::TrueValue: break;
+  case Token::Type::OpenBrace:
+    mOpenArrays.Push(Value::Type::PairArray);
+    mExpect = Expect::PairOrClose;
+    return Event::BeginPairArray;
+  case Token::Type::OpenBracket:
+    mOpenArrays.Push(Value::Type::ValueArray);
+    mExpect = Expect::ValueOrClose;
+    return Event::BeginValueArray;
+  default:
+    if (mExpect == Expect::ValueOrClose) {
+      return Fail("Expected ].");
+    }
+    return Fail("Expected Value.");
+  }
+
+  // The quotes surrounding the TrueValue are excluded. Only TrueValues with
+  // escape sequences are copied.
+  const char* text = token.mText + 1;
+  size_t length = mTokenEnd - token.mText - 2;
+  const char* escape = (const char*)memchr(text, '\\', length);
+  if (escape == nullptr) {
+    mTrueValue = std::string_view(text, length);
+    return EndValue(Event::TrueValue);
+  }
+  mEscapedTrueValue.assign(text, escape - text);
+  for (size_t i = escape - text; i < length; ++i) {
+    if (text[i] == '\\') {
+      ++i;
+    }
+    mEscapedTrueValue.push_back(text[i]);
+  }
+  mTrueValue = mEscapedTrueValue;
+  return EndValue(Event::TrueValue);
+}
+
+VResult<Reader::Event> Reader::EndValue(Event event) {
+  if (event == Event::EndPairArray || event == Event::EndValueArray) {
+    mOpenArrays.Pop();
+  }
+  if (mOpenArrays.Empty()) {
+    mExpect = Expect::Nothing;
+  }
+  else if (mOpenArrays.Top() == Value::Type::PairArray) {
+    mExpect = Expect::PairOrClose;
+  }
+  else {
+    mExpect = Expect::CommaOrClose;
+  }
+  return event;
+}
+
+Result Reader::ReadValue(Event event, Value* value) {
+  switch (event) {
+  case Event::TrueValue:
+    value->EnsureType(Value::Type::TrueValue);
+    value->mTrueValue.assign(mTrueValue);
+    return Result();
+  case Event::BeginPairArray:
+    value->EnsureType(Value::Type::PairArray);
+    while (true) {
+      VResult<Event> result = Next();
+      if (!result.Success()) {
+        return Result(std::move(result.mError));
+      }
+      if (result.mValue == Event::EndPairArray) {
+        return Result();
+      }
+      value->mPairArray.Emplace(std::string(mKey));
+      Result pairResult = ReadValue(&value->mPairArray.Top());
+      if (!pairResult.Success()) {
+        return pairResult;
+      }
+    }
+  case Event::BeginValueArray:
+    value->EnsureType(Value::Type::ValueArray);
+    while (true) {
+      VResult<Event> result = Next();
+      if (!result.Success()) {
+        return Result(std::move(result.mError));
+      }
+      if (result.mValue == Event::EndValueArray) {
+        return Result();
+      }
+      value->mValueArray.Emplace();
+      Result elementResult =
+        ReadValue(result.mValue, &value->mValueArray.Top());
+      if (!elementResult.Success()) {
+        return elementResult;
+      }
+    }
+  default: return Result("Expected Value.");
+  }
+}
+
+} // namespace Vlk
@@ -0,0 +1,89 @@
+#ifndef vlk_Reader_h
+#define vlk_Reader_h
+
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "Result.h"
+#include "ds/Vector.h"
+#include "vlk/Tokenizer.h"
+#include "vlk/Value.h"
+
+namespace Vlk {
+
+// A Reader visits Valkor text one event at a time instead of creating a Value
+// tree for all of it. Files are read in chunks, so the memory used by a Reader
+// only depends on the longest token and the depth of the arrays being read.
+
+// Parts of the text can still be read into a Value with ReadValue. This allows
+// small Values within a large file to be used with Explorers.
+
+struct Reader {
+public:
+  enum class Event {
+    BeginPairArray,
+    EndPairArray,
+    BeginValueArray,
+    EndValueArray,
+    Key,
+    TrueValue,
+    End,
+  };
+
+  Reader();
+  Reader(const Reader& other) = delete;
+  Reader& operator=(const Reader& other) = delete;
+
+  // The text given to Start must exist for as long as it's being read.
+  Result Open(const char* filename);
+  void Start(const char* text);
+
+  VResult<Event> Next();
+  // The key and TrueValue of the most recent Key and TrueValue events. They are
+  // only valid until the next event.
+  std::string_view Key() const;
+  std::string_view TrueValue() const;
+
+  // These handle the Value that starts with the next event. After a Key event,
+  // this is the Pair's Value.
+  Result ReadValue(Value* value);
+  Result SkipValue();
+
+private:
+  enum class Expect {
+    Value,
+    PairOrClose,
+    ValueOrClose,
+    CommaOrClose,
+    Nothing,
+  };
+  Expect mExpect;
+  Ds::Vector<Value::Type> mOpenArrays;
+  size_t mCurrentLine;
+  std::string mError;
+
+  const char* mText;
+  const char* mTokenEnd;
+  std::string_view mKey;
+  std::string_view mTrueValue;
+  std::string mEscapedTrueValue;
+
+  // When reading a file, mText points into mBuffer and mBufferEnd is the end of
+  // the text that has been read from the file.
+  std::ifstream mFile;
+  Ds::Vector<char> mBuffer;
+  const char* mBufferEnd;
+
+  void Reset();
+  Token NextToken();
+  bool Refill(const char** text);
+  VResult<Event> Fail(const char* error);
+  VResult<Event> BeginValue(const Token& token);
+  VResult<Event> EndValue(Event event);
+  Result ReadValue(Event event, Value* value);
+};
+
+} // namespace Vlk
+
+#endif
@@ -1,6 +1,16 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
 #include <sstream>
 #include <utility>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "Error.h"
 #include "vlk/Tokenizer.h"
 
 namespace Vlk {
@@ -88,6 +98,108 @@ struct State {
 // Tokenizer ///////////////////////////////////////////////////////////////////
 Ds::Vector<State> nStates;
 StateIndex nRoot;
+std::once_flag nInitTokenizerFlag;
+// Tokenize never reserves more than 1 MiB of Tokens up front.
+constexpr size_t nMaxTokenReservation = (1 << 20) / sizeof(Token);
+
+// The States are compiled into a table with a column for every byte value, so
+// finding the next state is a single lookup instead of a walk over the edges.
+constexpr int nByteValueCount = 256;
+constexpr int nMaxStateCount = 16;
+StateIndex nTransitions[nMaxStateCount * nByteValueCount];
+// These states loop on most characters, so runs of those characters are
+// skipped without any transitions.
+StateIndex nWhitespaceState;
+StateIndex nQuotedState;
+
+StateIndex Transition(StateIndex state, char c) {
+  return nTransitions[state * nByteValueCount + (unsigned char)c];
+}
+
+void CompileTransitions() {
+  LogAbortIf(
+    nStates.Size() > nMaxStateCount, "The tokenizer has too many states.");
+  for (StateIndex state = 0; state < (StateIndex)nStates.Size(); ++state) {
+    for (int c = 0; c < nByteValueCount; ++c) {
+      nTransitions[state * nByteValueCount + c] =
+        nStates[state].NextState((char)c);
+    }
+  }
+}
+
+#ifdef __SSE2__
+// Blocks are loaded from 16 byte aligned addresses. An aligned block never
+// crosses a page boundary, so reading past the null terminator within the
+// final block is safe. Bits for the bytes before the text are masked off.
+constexpr uintptr_t nBlockSize = 16;
+constexpr unsigned int nFullBlockMask = 0xffff;
+
+unsigned int WhitespaceMask(__m128i block) {
+  __m128i mask = _mm_or_si128(
+    _mm_or_si128(
+      _mm_cmpeq_epi8(block, _mm_set1_epi8(' ')),
+      _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))),
+    _mm_or_si128(
+      _mm_cmpeq_epi8(block, _mm_set1_epi8('\r')),
+      _mm_cmpeq_epi8(block, _mm_set1_epi8('\n'))));
+  return (unsigned int)_mm_movemask_epi8(mask);
+}
+
+unsigned int EndsQuoteMask(__m128i block) {
+  __m128i mask = _mm_or_si128(
+    _mm_or_si128(
+      _mm_cmpeq_epi8(block, _mm_set1_epi8('\'')),
+      _mm_cmpeq_epi8(block, _mm_set1_epi8('\\'))),
+    _mm_cmpeq_epi8(block, _mm_setzero_si128()));
+  return (unsigned int)_mm_movemask_epi8(mask);
+}
+
+const char* SkipWhitespace(const char* text) {
+  uintptr_t offset = (uintptr_t)text & (nBlockSize - 1);
+  const __m128i* block = (const __m128i*)(text - offset);
+  unsigned int mask = WhitespaceMask(_mm_load_si128(block));
+  mask |= (1u << offset) - 1;
+  while (mask == nFullBlockMask) {
+    ++block;
+    mask = WhitespaceMask(_mm_load_si128(block));
+  }
+  return (const char*)block + std::countr_zero(~mask);
+}
+
+const char* SkipQuoted(const char* text) {
+  uintptr_t offset = (uintptr_t)text & (nBlockSize - 1);
+  const __m128i* block = (const __m128i*)(text - offset);
+  unsigned int mask = EndsQuoteMask(_mm_load_si128(block));
+  mask &= ~((1u << offset) - 1);
+  while (mask == 0) {
+    ++block;
+    mask = EndsQuoteMask(_mm_load_si128(block));
+  }
+  return (const char*)block + std::countr_zero(mask);
+}
+#else
+bool IsWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool EndsQuote(char c) {
+  return c == '\'' || c == '\\' || c == '\0';
+}
+
+const char* SkipWhitespace(const char* text) {
+  while (IsWhitespace(*text)) {
+    ++text;
+  }
+  return text;
+}
+
+const char* SkipQuoted(const char* text) {
+  while (!EndsQuote(*text)) {
+    ++text;
+  }
+  return text;
+}
+#endif
 
 StateIndex AddStates(Token::Type tokenType, size_t amount) {
   for (size_t i = 0; i < amount; ++i) {
@@ -135,6 +247,7 @@ void InitTokenizer() {
     StateIndex valid = AddStates(Token::Type::TrueValue, 1);
     StateIndex invalid = AddStates(Token::Type::Invalid, 2);
 
+    nQuotedState = invalid;
     Qualifier q;
     q.WhitelistChar('\'');
     AddEdge(nRoot, invalid, q);
@@ -152,6 +265,7 @@ void InitTokenizer() {
   // Whitespace
   {
     StateIndex valid = AddStates(Token::Type::Whitespace, 1);
+    nWhitespaceState = valid;
     Qualifier q;
     q.WhitelistChar(' ');
     q.WhitelistChar('\t');
@@ -166,16 +280,23 @@ void InitTokenizer() {
   AddLoneState(Token::Type::OpenBrace, '{');
   AddLoneState(Token::Type::CloseBrace, '}');
   AddLoneState(Token::Type::Comma, ',');
+  CompileTransitions();
 }
 
 Token ReadNextToken(const char** text) {
   const char* start = *text;
   StateIndex currentState = nRoot;
-  StateIndex nextState = nStates[nRoot].NextState(**text);
+  StateIndex nextState = Transition(nRoot, **text);
   while (nextState != nInvalidTerminal) {
     ++(*text);
     currentState = nextState;
-    nextState = nStates[currentState].NextState(**text);
+    if (currentState == nWhitespaceState) {
+      *text = SkipWhitespace(*text);
+    }
+    else if (currentState == nQuotedState) {
+      *text = SkipQuoted(*text);
+    }
+    nextState = Transition(currentState, **text);
   }
 
   // When first character does not qualify for any edges leading from the root,
@@ -190,15 +311,18 @@ Token ReadNextToken(const char** text) {
 }
 
 VResult<Ds::Vector<Token>> Tokenize(const char* text) {
-  // Initialize the Tokenizer if it hasn't been.
-  if (nStates.Empty()) {
-    InitTokenizer();
-  }
+  // Initialize the Tokenizer if it hasn't been. Values can be read from
+  // multiple threads, so this must only happen once.
+  std::call_once(nInitTokenizerFlag, InitTokenizer);
 
   // Tokenize the text.
   size_t lineNumber = 1;
   std::stringstream error;
   Ds::Vector<Token> tokens;
+  // Asset configs average about five characters per token, whitespace tokens
+  // included. The reservation is capped because a Token is larger than the
+  // text it covers and large documents can grow the vector instead.
+  tokens.Reserve(std::min(strlen(text) / 5 + 1, nMaxTokenReservation));
   while (*text != '\0') {
     Token token = ReadNextToken(&text);
     switch (token.mType) {
@@ -215,6 +339,11 @@ VResult<Ds::Vector<Token>> Tokenize(const char* text) {
   return VResult<Ds::Vector<Token>>(std::move(tokens));
 }
 
+Token ReadToken(const char** text) {
+  std::call_once(nInitTokenizerFlag, InitTokenizer);
+  return ReadNextToken(text);
+}
+
 size_t CountNewLines(const char* start, const char* end) {
   size_t newLineCount = 0;
   const char* currentChar = start;
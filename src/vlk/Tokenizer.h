@@ -24,6 +24,9 @@ struct Token {
 };
 
 VResult<Ds::Vector<Token>> Tokenize(const char* text);
+// Reads the Token at the start of the text and moves the text past it. A Token
+// that doesn't qualify as any other type is an Invalid Token.
+Token ReadToken(const char** text);
 size_t CountNewLines(const char* start, const char* end);
 
 } // namespace Vlk
@@ -1,27 +1,32 @@
 #include <fstream>
+#include <functional>
 #include <utility>
 
 #include "Error.h"
+#include "debug/MemLeak.h"
+#include "debug/MemTrack.h"
+#include "vlk/Binary.h"
 #include "vlk/Parser.h"
 #include "vlk/Value.h"
+#include "vlk/Writer.h"
 
 namespace Vlk {
 
-Value::Value(): mType(Type::Invalid) {}
+Value::Value(): mType(Type::Invalid), mPairIndex(nullptr) {}
 
-Value::Value(Value::Type type): mType(Type::Invalid) {
+Value::Value(Value::Type type): mType(Type::Invalid), mPairIndex(nullptr) {
   // We initialize mType in the initializer list with Invalid because Init
   // expects mType to be Invalid.
   Init(type);
 }
 
-Value::Value(const Value& other): mType(Type::Invalid) {
+Value::Value(const Value& other):
+  mType(Type::Invalid), mPairIndex(nullptr) {
   mType = Type::Invalid;
   *this = other;
 }
 
-Value::Value(Value&& other) {
-  mType = Type::Invalid;
+Value::Value(Value&& other): mType(Type::Invalid), mPairIndex(nullptr) {
   *this = std::move(other);
 }
 
@@ -33,7 +38,10 @@ void Value::Clear() {
   switch (mType) {
   case Type::TrueValue: mTrueValue.~basic_string(); break;
   case Type::ValueArray: mValueArray.~Vector(); break;
-  case Type::PairArray: mPairArray.~Vector(); break;
+  case Type::PairArray:
+    mPairArray.~Vector();
+    DeletePairIndex();
+    break;
   default: break;
   }
   mType = Type::Invalid;
@@ -71,6 +79,7 @@ Value& Value::operator=(Value&& other) {
     break;
   case Type::PairArray:
     new (&mPairArray) Ds::Vector<Pair>(std::move(other.mPairArray));
+    mPairIndex = other.mPairIndex.exchange(nullptr);
     break;
   default: break;
   }
@@ -200,13 +209,23 @@ bool Value::ReachedThreshold(size_t& elementCount) const {
 }
 
 Result Value::Read(const char* filename) {
-  // Read the file's content.
-  std::ifstream stream(filename, std::ifstream::in);
+  // Binary files are identified by the magic at the start of the file.
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
   if (!stream.is_open()) {
     std::stringstream error;
     error << "Failed to open \"" << filename << "\".";
     return Result(error.str());
   }
+  char magic[4];
+  stream.read(magic, sizeof(magic));
+  if (IsBinary(magic, (size_t)stream.gcount())) {
+    stream.close();
+    return ReadBinary(filename);
+  }
+  stream.close();
+
+  // Read the file's content.
+  stream.open(filename, std::ifstream::in);
   std::stringstream content;
   content << stream.rdbuf();
   stream.close();
@@ -222,22 +241,68 @@ Result Value::Read(const char* filename) {
 }
 
 Result Value::Write(const char* filename) {
-  std::ofstream stream(filename, std::ofstream::out);
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::Vlk);
+  Writer writer;
+  Result result = writer.Open(filename);
+  if (!result.Success()) {
+    return result;
+  }
+  writer.WriteValue(*this);
+  return writer.Close();
+}
+
+Result Value::Parse(const char* text) {
+  LogAbortIf(
+    mType != Value::Type::Invalid,
+    "Parse can only be used on an uninitialized Value.");
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::Vlk);
+  Parser parser;
+  return parser.Parse(text, this);
+}
+
+Result Value::ReadBinary(const char* filename) {
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
+  if (!stream.is_open()) {
+    std::stringstream error;
+    error << "Failed to open \"" << filename << "\".";
+    return Result(error.str());
+  }
+  std::stringstream content;
+  content << stream.rdbuf();
+  stream.close();
+
+  std::string data = content.str();
+  Result result = ParseBinary(data.data(), data.size());
+  if (!result.Success()) {
+    std::stringstream error;
+    error << filename << ": " << result.mError;
+    return Result(error.str());
+  }
+  return result;
+}
+
+Result Value::WriteBinary(const char* filename) {
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::Vlk);
+  std::ofstream stream(filename, std::ofstream::out | std::ofstream::binary);
   if (!stream.is_open()) {
     std::stringstream error;
     error << filename << " failed to open while writing.";
     return Result(error.str());
   }
-  stream << *this;
+  std::string data;
+  Encoder encoder;
+  encoder.Encode(*this, &data);
+  stream.write(data.data(), data.size());
   return Result();
 }
 
-Result Value::Parse(const char* text) {
+Result Value::ParseBinary(const char* data, size_t size) {
   LogAbortIf(
     mType != Value::Type::Invalid,
-    "Parse can only be used on an uninitialized Value.");
-  Parser parser;
-  return parser.Parse(text, this);
+    "ParseBinary can only be used on an uninitialized Value.");
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::Vlk);
+  Decoder decoder;
+  return decoder.Decode(data, size, this);
 }
 
 size_t Value::Size() const {
@@ -250,16 +315,91 @@ size_t Value::Size() const {
   return 0;
 }
 
+struct Value::PairIndex {
+  PairIndex(const Ds::Vector<Pair>& pairArray);
+  size_t Find(const std::string& key, const Ds::Vector<Pair>& pairArray) const;
+  void Insert(size_t pairIndex, const Ds::Vector<Pair>& pairArray);
+  size_t FindSlot(
+    const std::string& key, const Ds::Vector<Pair>& pairArray) const;
+
+  // Slots contain Pair indices and empty slots contain smNoPair. The slot count
+  // is a power of two that's at least twice the Pair count.
+  constexpr static size_t smNoPair = (size_t)-1;
+  Ds::Vector<size_t> mSlots;
+};
+
+Value::PairIndex::PairIndex(const Ds::Vector<Pair>& pairArray) {
+  size_t slotCount = smPairIndexThreshold * 2;
+  while (slotCount < pairArray.Size() * 2) {
+    slotCount *= 2;
+  }
+  mSlots.Resize(slotCount, smNoPair);
+  for (size_t i = 0; i < pairArray.Size(); ++i) {
+    Insert(i, pairArray);
+  }
+}
+
+size_t Value::PairIndex::Find(
+  const std::string& key, const Ds::Vector<Pair>& pairArray) const {
+  return mSlots[FindSlot(key, pairArray)];
+}
+
+void Value::PairIndex::Insert(
+  size_t pairIndex, const Ds::Vector<Pair>& pairArray) {
+  // When keys are repeated, the first Pair with the key is found, just like it
+  // would be without the index.
+  size_t slot = FindSlot(pairArray[pairIndex].Key(), pairArray);
+  if (mSlots[slot] == smNoPair) {
+    mSlots[slot] = pairIndex;
+  }
+}
+
+size_t Value::PairIndex::FindSlot(
+  const std::string& key, const Ds::Vector<Pair>& pairArray) const {
+  size_t mask = mSlots.Size() - 1;
+  size_t slot = std::hash<std::string>()(key) & mask;
+  while (mSlots[slot] != smNoPair && pairArray[mSlots[slot]].Key() != key) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+const Value::PairIndex& Value::GetPairIndex() const {
+  PairIndex* index = mPairIndex.load(std::memory_order_acquire);
+  if (index != nullptr) {
+    return *index;
+  }
+  // When multiple threads create the index at once, the first index stored is
+  // used and the others are deleted.
+  PairIndex* newIndex = alloc PairIndex(mPairArray);
+  if (mPairIndex.compare_exchange_strong(index, newIndex)) {
+    return *newIndex;
+  }
+  delete newIndex;
+  return *index;
+}
+
+void Value::DeletePairIndex() {
+  delete mPairIndex.exchange(nullptr);
+}
+
 int Value::TryGetPairIndex(const std::string& key) const {
   if (mType != Type::PairArray) {
     return smInvalidPairIndex;
   }
-  for (size_t i = 0; i < mPairArray.Size(); ++i) {
-    if (key == mPairArray[i].mKey) {
-      return (int)i;
+  if (mPairArray.Size() < smPairIndexThreshold) {
+    for (size_t i = 0; i < mPairArray.Size(); ++i) {
+      if (key == mPairArray[i].mKey) {
+        return (int)i;
+      }
     }
+    return smInvalidPairIndex;
   }
-  return smInvalidPairIndex;
+  size_t pairIndex = GetPairIndex().Find(key, mPairArray);
+  if (pairIndex == PairIndex::smNoPair) {
+    return smInvalidPairIndex;
+  }
+  return (int)pairIndex;
 }
 
 const Pair* Value::TryGetConstPair(const std::string& key) const {
@@ -312,6 +452,14 @@ Pair& Value::operator()(const std::string& key) {
   Pair* pair = TryGetPair(key);
   if (pair == nullptr) {
     mPairArray.Emplace(key);
+    // The index is recreated by the next lookup once it needs more slots.
+    PairIndex* index = mPairIndex.load();
+    if (index != nullptr && mPairArray.Size() * 2 > index->mSlots.Size()) {
+      DeletePairIndex();
+    }
+    else if (index != nullptr) {
+      index->Insert(mPairArray.Size() - 1, mPairArray);
+    }
     return mPairArray.Top();
   }
   return *pair;
@@ -327,6 +475,7 @@ bool Value::TryRemovePair(const std::string& key) {
   int pairIndex = TryGetPairIndex(key);
   if (pairIndex != smInvalidPairIndex) {
     mPairArray.Remove(pairIndex);
+    DeletePairIndex();
     return true;
   }
   return false;
@@ -391,75 +540,14 @@ std::ostream& operator<<(std::ostream& os, Value::Type valueType) {
 }
 
 std::ostream& operator<<(std::ostream& os, const Value& value) {
-  static std::string indent = "";
-  value.PrintValue(os, indent);
+  std::string text;
+  Writer writer;
+  writer.Start(&text);
+  writer.WriteValue(value);
+  os << text;
   return os;
 }
 
-void Value::PrintValue(std::ostream& os, std::string& indent) const {
-  // Invalid values will always become empty pair arrays.
-  switch (mType) {
-  case Type::Invalid: os << "{}"; break;
-  case Type::TrueValue: PrintTrueValue(os); break;
-  case Type::ValueArray: PrintValueArray(os, indent); break;
-  case Type::PairArray: PrintPairArray(os, indent); break;
-  }
-}
-
-void Value::PrintTrueValue(std::ostream& os) const {
-  std::string trueText;
-  trueText.push_back('\'');
-  for (size_t i = 0; i < mTrueValue.size(); ++i) {
-    switch (mTrueValue[i]) {
-    case '\'': trueText.append("\\\'"); break;
-    case '\\': trueText.append("\\\\"); break;
-    default: trueText.push_back(mTrueValue[i]);
-    }
-  }
-  trueText.push_back('\'');
-  os << trueText;
-}
-
-void Value::PrintValueArray(std::ostream& os, std::string& indent) const {
-  if (mValueArray.Empty()) {
-    os << "[]";
-    return;
-  }
-  if (BelowPackThreshold()) {
-    os << "[";
-    mValueArray[0].PrintValue(os, indent);
-    for (size_t i = 1; i < mValueArray.Size(); ++i) {
-      os << ", ";
-      mValueArray[i].PrintValue(os, indent);
-    }
-    os << "]";
-    return;
-  }
-  indent += "  ";
-  os << "[\n" << indent;
-  mValueArray[0].PrintValue(os, indent);
-  for (size_t i = 1; i < mValueArray.Size(); ++i) {
-    os << ",\n" << indent;
-    mValueArray[i].PrintValue(os, indent);
-  }
-  indent.erase(indent.size() - 2);
-  os << "\n" << indent << "]";
-}
-
-void Value::PrintPairArray(std::ostream& os, std::string& indent) const {
-  if (mPairArray.Empty()) {
-    os << "{}";
-    return;
-  }
-  os << "{\n";
-  indent += "  ";
-  for (const Pair& pair: mPairArray) {
-    pair.PrintPair(os, indent);
-  }
-  indent.erase(indent.size() - 2);
-  os << indent << "}";
-}
-
 void Converter<std::string>::Serialize(Value& val, const std::string& value) {
   val.EnsureType(Value::Type::TrueValue);
   val.mTrueValue = value;
@@ -497,10 +585,4 @@ bool Pair::operator!=(const Pair& other) const {
   return !(*this == other);
 }
 
-void Pair::PrintPair(std::ostream& os, std::string& indent) const {
-  os << indent << ':' << mKey << ": ";
-  PrintValue(os, indent);
-  os << '\n';
-}
-
 } // namespace Vlk
@@ -1,17 +1,24 @@
 #ifndef vlk_Value_h
 #define vlk_Value_h
 
+#include <atomic>
+#include <charconv>
 #include <initializer_list>
 #include <ostream>
 #include <sstream>
+#include <type_traits>
 
 #include "Result.h"
 #include "ds/Vector.h"
 
 namespace Vlk {
 
+struct Decoder;
+struct Encoder;
 struct Pair;
 struct Parser;
+struct Reader;
+struct Writer;
 template<typename T>
 struct Serializer;
 
@@ -41,6 +48,11 @@ public:
   Result Read(const char* filename);
   Result Write(const char* filename);
   Result Parse(const char* text);
+  // Binary Valkor is described in vlk/Binary.h. Read detects the format, so it
+  // can be used for both text and binary files.
+  Result ReadBinary(const char* filename);
+  Result WriteBinary(const char* filename);
+  Result ParseBinary(const char* data, size_t size);
 
   enum class Type {
     Invalid,
@@ -92,6 +104,16 @@ private:
     Ds::Vector<Pair> mPairArray;
   };
 
+  // Finding a key in a PairArray with at least smPairIndexThreshold Pairs
+  // creates an index of the keys, so following lookups don't compare the key
+  // against every Pair. Removing a Pair deletes the index. The index is atomic
+  // because const lookups create it and Values may be read by many threads.
+  struct PairIndex;
+  constexpr static size_t smPairIndexThreshold = 16;
+  mutable std::atomic<PairIndex*> mPairIndex;
+  const PairIndex& GetPairIndex() const;
+  void DeletePairIndex();
+
   Value(Value::Type type);
 
   void Init(Type type);
@@ -102,37 +124,105 @@ private:
 
   friend std::ostream& operator<<(std::ostream& os, Type valueType);
   friend std::ostream& operator<<(std::ostream& os, const Value& value);
-  void PrintValue(std::ostream& os, std::string& indent) const;
-  void PrintTrueValue(std::ostream& os) const;
-  void PrintValueArray(std::ostream& os, std::string& indent) const;
-  void PrintPairArray(std::ostream& os, std::string& indent) const;
 
+  friend Decoder;
+  friend Encoder;
   friend Pair;
   friend Parser;
+  friend Reader;
+  friend Writer;
   template<typename>
   friend struct Converter;
+  template<typename>
+  friend struct NumberConverter;
   friend Ds::Vector<Value>;
 };
 
+// Numbers are converted with to_chars and from_chars instead of streams. They
+// don't allocate and floats are written with the fewest digits that still read
+// back as the same float.
 template<typename T>
-struct Converter {
-  static void Serialize(Value& val, const T& value) {
+constexpr bool IsNumber = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+  !std::is_same_v<T, char> && !std::is_same_v<T, signed char> &&
+  !std::is_same_v<T, unsigned char>;
+
+template<typename T>
+struct NumberConverter {
+  static void Serialize(Value& val, T value) {
     val.EnsureType(Value::Type::TrueValue);
-    std::stringstream ss;
-    ss << value;
-    val.mTrueValue = ss.str();
+    char text[64];
+    std::to_chars_result result = std::to_chars(text, text + 64, value);
+    val.mTrueValue.assign(text, result.ptr - text);
   }
 
   static bool Deserialize(const Value& val, T* value) {
     if (val.mType != Value::Type::TrueValue) {
       return false;
     }
-    std::stringstream ss(val.mTrueValue);
-    ss >> *value;
+    const char* start = val.mTrueValue.data();
+    const char* end = start + val.mTrueValue.size();
+    // The whole TrueValue must be the number. "12abc" is not 12.
+    T number;
+    std::from_chars_result result = std::from_chars(start, end, number);
+    if (result.ec != std::errc() || result.ptr != end) {
+      return false;
+    }
+    *value = number;
+    return true;
+  }
+
+  // These convert between arrays of numbers and ValueArrays without going
+  // through the Value interface for every element.
+  static void SerializeArray(Value& val, const T* values, size_t count) {
+    val[{count}];
+    for (size_t i = 0; i < count; ++i) {
+      Serialize(val.mValueArray[i], values[i]);
+    }
+  }
+
+  static bool DeserializeArray(const Value& val, T* values, size_t count) {
+    if (val.mType != Value::Type::ValueArray ||
+        val.mValueArray.Size() < count) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (!Deserialize(val.mValueArray[i], values + i)) {
+        return false;
+      }
+    }
     return true;
   }
 };
 
+template<typename T>
+struct Converter {
+  static void Serialize(Value& val, const T& value) {
+    if constexpr (IsNumber<T>) {
+      NumberConverter<T>::Serialize(val, value);
+    }
+    else {
+      val.EnsureType(Value::Type::TrueValue);
+      std::stringstream ss;
+      ss << value;
+      val.mTrueValue = ss.str();
+    }
+  }
+
+  static bool Deserialize(const Value& val, T* value) {
+    if constexpr (IsNumber<T>) {
+      return NumberConverter<T>::Deserialize(val, value);
+    }
+    else {
+      if (val.mType != Value::Type::TrueValue) {
+        return false;
+      }
+      std::stringstream ss(val.mTrueValue);
+      ss >> *value;
+      return true;
+    }
+  }
+};
+
 template<>
 struct Converter<std::string> {
   static void Serialize(Value& val, const std::string& value);
@@ -184,8 +274,6 @@ private:
   Pair();
   Pair(const std::string& key);
 
-  void PrintPair(std::ostream& os, std::string& indent) const;
-
   friend Value;
   friend Parser;
   friend Ds::Vector<Pair>;
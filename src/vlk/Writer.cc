@@ -0,0 +1,229 @@
+#include <sstream>
+
+#include "Error.h"
+#include "vlk/Writer.h"
+
+namespace Vlk {
+
+// The buffer is written to the file once it reaches this size.
+constexpr size_t nWriterBufferSize = 1 << 16;
+
+Writer::Writer(): mKeyWritten(false), mText(&mBuffer) {}
+
+Writer::~Writer() {
+  if (mFile.is_open()) {
+    Flush();
+  }
+}
+
+Result Writer::Open(const char* filename) {
+  LogAbortIf(mFile.is_open(), "Close must be used before Open.");
+  mFile.clear();
+  mFile.open(filename, std::ofstream::out);
+  if (!mFile.is_open()) {
+    std::stringstream error;
+    error << filename << " failed to open while writing.";
+    return Result(error.str());
+  }
+  mOpenArrays.Clear();
+  mKeyWritten = false;
+  mBuffer.clear();
+  mText = &mBuffer;
+  mFilename = filename;
+  return Result();
+}
+
+Result Writer::Close() {
+  LogAbortIf(!mOpenArrays.Empty(), "Close used before every array ended.");
+  if (!mFile.is_open()) {
+    return Result();
+  }
+  Flush();
+  mFile.close();
+  if (mFile.fail()) {
+    std::stringstream error;
+    error << mFilename << " failed while writing.";
+    return Result(error.str());
+  }
+  return Result();
+}
+
+void Writer::Start(std::string* text) {
+  LogAbortIf(mFile.is_open(), "Close must be used before Start.");
+  mOpenArrays.Clear();
+  mKeyWritten = false;
+  mText = text;
+}
+
+void Writer::BeginPairArray() {
+  BeginValue();
+  mText->push_back('{');
+  mOpenArrays.Push({Value::Type::PairArray, 0});
+}
+
+void Writer::EndPairArray() {
+  LogAbortIf(
+    mOpenArrays.Empty() || mOpenArrays.Top().mType != Value::Type::PairArray ||
+      mKeyWritten,
+    "EndPairArray must end a PairArray.");
+  size_t size = mOpenArrays.Top().mSize;
+  mOpenArrays.Pop();
+  if (size > 0) {
+    Indent(mOpenArrays.Size() * 2);
+  }
+  mText->push_back('}');
+  EndValue();
+}
+
+void Writer::BeginValueArray() {
+  BeginValue();
+  mText->push_back('[');
+  mOpenArrays.Push({Value::Type::ValueArray, 0});
+}
+
+void Writer::EndValueArray() {
+  LogAbortIf(
+    mOpenArrays.Empty() || mOpenArrays.Top().mType != Value::Type::ValueArray,
+    "EndValueArray must end a ValueArray.");
+  size_t size = mOpenArrays.Top().mSize;
+  mOpenArrays.Pop();
+  if (size > 0) {
+    mText->push_back('\n');
+    Indent(mOpenArrays.Size() * 2);
+  }
+  mText->push_back(']');
+  EndValue();
+}
+
+void Writer::Key(std::string_view key) {
+  LogAbortIf(
+    mOpenArrays.Empty() || mOpenArrays.Top().mType != Value::Type::PairArray ||
+      mKeyWritten,
+    "Keys can only be written within a PairArray and before a Value.");
+  OpenArray& openArray = mOpenArrays.Top();
+  if (openArray.mSize == 0) {
+    mText->push_back('\n');
+  }
+  ++openArray.mSize;
+  Indent(mOpenArrays.Size() * 2);
+  mText->push_back(':');
+  mText->append(key);
+  mText->append(": ");
+  mKeyWritten = true;
+}
+
+void Writer::TrueValue(std::string_view trueValue) {
+  BeginValue();
+  PrintTrueValue(trueValue);
+  EndValue();
+}
+
+void Writer::WriteValue(const Value& value) {
+  BeginValue();
+  PrintValue(value, mOpenArrays.Size() * 2);
+  EndValue();
+}
+
+void Writer::BeginValue() {
+  if (mOpenArrays.Empty()) {
+    return;
+  }
+  OpenArray& openArray = mOpenArrays.Top();
+  if (openArray.mType == Value::Type::PairArray) {
+    LogAbortIf(!mKeyWritten, "A Value within a PairArray needs a key.");
+    mKeyWritten = false;
+    return;
+  }
+  mText->append(openArray.mSize == 0 ? "\n" : ",\n");
+  ++openArray.mSize;
+  Indent(mOpenArrays.Size() * 2);
+}
+
+void Writer::EndValue() {
+  if (!mOpenArrays.Empty() &&
+      mOpenArrays.Top().mType == Value::Type::PairArray) {
+    mText->push_back('\n');
+  }
+  if (mFile.is_open() && mBuffer.size() >= nWriterBufferSize) {
+    Flush();
+  }
+}
+
+void Writer::Flush() {
+  mFile.write(mBuffer.data(), mBuffer.size());
+  mBuffer.clear();
+}
+
+void Writer::Indent(size_t indent) {
+  mText->append(indent, ' ');
+}
+
+void Writer::PrintValue(const Value& value, size_t indent) {
+  // Invalid values will always become empty pair arrays.
+  switch (value.mType) {
+  case Value::Type::Invalid: mText->append("{}"); break;
+  case Value::Type::TrueValue: PrintTrueValue(value.mTrueValue); break;
+  case Value::Type::ValueArray: PrintValueArray(value, indent); break;
+  case Value::Type::PairArray: PrintPairArray(value, indent); break;
+  }
+}
+
+void Writer::PrintTrueValue(std::string_view trueValue) {
+  mText->push_back('\'');
+  for (char c: trueValue) {
+    if (c == '\'' || c == '\\') {
+      mText->push_back('\\');
+    }
+    mText->push_back(c);
+  }
+  mText->push_back('\'');
+}
+
+void Writer::PrintValueArray(const Value& value, size_t indent) {
+  const Ds::Vector<Value>& valueArray = value.mValueArray;
+  if (valueArray.Empty()) {
+    mText->append("[]");
+    return;
+  }
+  if (value.BelowPackThreshold()) {
+    mText->push_back('[');
+    PrintValue(valueArray[0], indent);
+    for (size_t i = 1; i < valueArray.Size(); ++i) {
+      mText->append(", ");
+      PrintValue(valueArray[i], indent);
+    }
+    mText->push_back(']');
+    return;
+  }
+  mText->append("[\n");
+  Indent(indent + 2);
+  PrintValue(valueArray[0], indent + 2);
+  for (size_t i = 1; i < valueArray.Size(); ++i) {
+    mText->append(",\n");
+    Indent(indent + 2);
+    PrintValue(valueArray[i], indent + 2);
+  }
+  mText->push_back('\n');
+  Indent(indent);
+  mText->push_back(']');
+}
+
+void Writer::PrintPairArray(const Value& value, size_t indent) {
+  if (value.mPairArray.Empty()) {
+    mText->append("{}");
+    return;
+  }
+  mText->append("{\n");
+  for (const Pair& pair: value.mPairArray) {
+    Indent(indent + 2);
+    mText->push_back(':');
+    mText->append(pair.Key());
+    mText->append(": ");
+    PrintValue(pair, indent + 2);
+    mText->push_back('\n');
+  }
+  Indent(indent);
+  mText->push_back('}');
+}
+
+} // namespace Vlk
@@ -0,0 +1,72 @@
+#ifndef vlk_Writer_h
+#define vlk_Writer_h
+
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "Result.h"
+#include "ds/Vector.h"
+#include "vlk/Value.h"
+
+namespace Vlk {
+
+// A Writer creates Valkor text one event at a time instead of printing a Value
+// tree that contains all of it. When writing a file, the text is written in
+// chunks, so the memory used by a Writer doesn't depend on the size of the
+// output. The text is formatted the same way Values are printed.
+
+// Small Values within a large output can still be created as Values and written
+// with WriteValue. ValueArrays that are written one event at a time always put
+// every element on its own line because a Writer can't look ahead.
+
+struct Writer {
+public:
+  Writer();
+  ~Writer();
+  Writer(const Writer& other) = delete;
+  Writer& operator=(const Writer& other) = delete;
+
+  // Close must be used to know whether everything was written to the file and
+  // before the Writer is used for anything else. The text given to Start must
+  // exist for as long as it's being written to.
+  Result Open(const char* filename);
+  Result Close();
+  void Start(std::string* text);
+
+  void BeginPairArray();
+  void EndPairArray();
+  void BeginValueArray();
+  void EndValueArray();
+  void Key(std::string_view key);
+  void TrueValue(std::string_view trueValue);
+  void WriteValue(const Value& value);
+
+private:
+  struct OpenArray {
+    Value::Type mType;
+    size_t mSize;
+  };
+  Ds::Vector<OpenArray> mOpenArrays;
+  bool mKeyWritten;
+
+  // When writing a file, mText points to mBuffer and mBuffer is written to the
+  // file whenever it becomes large enough.
+  std::string* mText;
+  std::ofstream mFile;
+  std::string mBuffer;
+  std::string mFilename;
+
+  void BeginValue();
+  void EndValue();
+  void Flush();
+  void Indent(size_t indent);
+  void PrintValue(const Value& value, size_t indent);
+  void PrintTrueValue(std::string_view trueValue);
+  void PrintValueArray(const Value& value, size_t indent);
+  void PrintPairArray(const Value& value, size_t indent);
+};
+
+} // namespace Vlk
+
+#endif
@@ -4,7 +4,9 @@
 #include "Error.h"
 #include "comp/Name.h"
 #include "comp/Relationship.h"
+#include "vlk/Reader.h"
 #include "vlk/Valkor.h"
+#include "vlk/Writer.h"
 #include "world/Object.h"
 #include "world/Space.h"
 
@@ -306,17 +308,12 @@ bool Space::HasComponent(Comp::TypeId typeId, MemberId memberId) const {
 }
 
 Ds::Vector<MemberId> Space::Slice(Comp::TypeId typeId) const {
-  Ds::Vector<MemberId> members;
-  if (!mTables.Valid((SparseId)typeId)) {
-    return members;
-  }
+  return CreateSlice<Ds::HeapAllocator>(typeId);
+}
 
-  const Table& table = mTables[(SparseId)typeId];
-  members.Reserve(table.Size());
-  for (size_t i = 0; i < table.Size(); ++i) {
-    members.Push(table.GetOwnerAtDenseIndex(i));
-  }
-  return members;
+Ds::Vector<MemberId, Ds::FrameAllocator> Space::FrameSlice(
+  Comp::TypeId typeId) const {
+  return CreateSlice<Ds::FrameAllocator>(typeId);
 }
 
 Ds::Vector<MemberId> Space::RootMemberIds() const {
@@ -376,9 +373,37 @@ void Space::Serialize(Vlk::Value& spaceVal) const {
   }
 }
 
+void Space::Serialize(Vlk::Writer* writer) const {
+  writer->BeginPairArray();
+  for (int i = 0; i < mMembers.DenseUsage(); ++i) {
+    MemberId memberId = mMembers.Dense()[i];
+    writer->Key(std::to_string(memberId));
+    writer->BeginPairArray();
+    for (Ds::PoolId i = 0; i < mTables.Capacity(); ++i) {
+      if (!mTables.Valid(i)) {
+        continue;
+      }
+      const Table& table = mTables[i];
+      if (!table.ValidComponent(memberId)) {
+        continue;
+      }
+      const Comp::TypeData& typeData = Comp::nTypeData[table.TypeId()];
+      Vlk::Value componentVal;
+      if (typeData.mVSerialize.Open()) {
+        void* component = table.GetComponent(memberId);
+        typeData.mVSerialize.Invoke(component, componentVal);
+      }
+      writer->Key(typeData.mName);
+      writer->WriteValue(componentVal);
+    }
+    writer->EndPairArray();
+  }
+  writer->EndPairArray();
+}
+
 Result Space::Deserialize(const Vlk::Explorer& spaceEx) {
   if (!spaceEx.Valid(Vlk::Value::Type::PairArray)) {
-    return Result("Space Value must be a ValueArray");
+    return Result("Space Value must be a PairArray");
   }
 
   for (size_t i = 0; i < spaceEx.Size(); ++i) {
@@ -390,7 +415,6 @@ Result Space::Deserialize(const Vlk::Explorer& spaceEx) {
     mMembers.Request(memberId);
 
     // Get the member's component data.
-    World::Object owner(this, memberId);
     for (size_t i = 0; i < memberEx.Size(); ++i) {
       Vlk::Explorer componentEx = memberEx(i);
       Comp::TypeId typeId = Comp::GetTypeId(componentEx.Key());
@@ -399,26 +423,91 @@ Result Space::Deserialize(const Vlk::Explorer& spaceEx) {
           "Component type \"" + componentEx.Key() + "\" at " +
           componentEx.Path() + " isn't a valid type.");
       }
-      void* component = TryGetComponent(typeId, memberId);
-      if (component == nullptr) {
-        component = AddComponent(typeId, memberId, false);
+      DeserializeComponent(typeId, memberId, componentEx);
+    }
+  }
+  return Result();
+}
+
+Result Space::Deserialize(Vlk::Reader* reader) {
+  using Event = Vlk::Reader::Event;
+  VResult<Event> result = reader->Next();
+  if (!result.Success()) {
+    return Result(std::move(result.mError));
+  }
+  if (result.mValue != Event::BeginPairArray) {
+    return Result("Space Value must be a PairArray");
+  }
+
+  while (true) {
+    result = reader->Next();
+    if (!result.Success()) {
+      return Result(std::move(result.mError));
+    }
+    if (result.mValue == Event::EndPairArray) {
+      return Result();
+    }
+
+    // Create the member.
+    std::string memberPath = "{}{" + std::string(reader->Key()) + "}";
+    std::stringstream idStream(std::string(reader->Key()));
+    MemberId memberId;
+    idStream >> memberId;
+    mMembers.Request(memberId);
+    result = reader->Next();
+    if (!result.Success()) {
+      return Result(std::move(result.mError));
+    }
+    if (result.mValue != Event::BeginPairArray) {
+      return Result("Member at " + memberPath + " must be a PairArray.");
+    }
+
+    // Read and deserialize the member's components one at a time.
+    while (true) {
+      result = reader->Next();
+      if (!result.Success()) {
+        return Result(std::move(result.mError));
       }
-      const Comp::TypeData& typeData = Comp::GetTypeData(typeId);
-      if (typeData.mVDeserialize.Open()) {
-        typeData.mVDeserialize.Invoke(component, componentEx);
+      if (result.mValue == Event::EndPairArray) {
+        break;
       }
-      else if (typeData.mVInit.Open()) {
-        typeData.mVInit.Invoke(component, owner);
+      std::string typeName(reader->Key());
+      Comp::TypeId typeId = Comp::GetTypeId(typeName);
+      if (typeId == Comp::nInvalidTypeId) {
+        return Result(
+          "Component type \"" + typeName + "\" at " + memberPath + "{" +
+          typeName + "} isn't a valid type.");
       }
+      Vlk::Value componentVal;
+      Result readResult = reader->ReadValue(&componentVal);
+      if (!readResult.Success()) {
+        return readResult;
+      }
+      DeserializeComponent(typeId, memberId, Vlk::Explorer(componentVal));
     }
   }
-  return Result();
 }
 
 bool Space::ValidMemberId(MemberId memberId) const {
   return mMembers.Valid(memberId);
 }
 
+void Space::DeserializeComponent(
+  Comp::TypeId typeId, MemberId memberId, const Vlk::Explorer& componentEx) {
+  void* component = TryGetComponent(typeId, memberId);
+  if (component == nullptr) {
+    component = AddComponent(typeId, memberId, false);
+  }
+  const Comp::TypeData& typeData = Comp::GetTypeData(typeId);
+  if (typeData.mVDeserialize.Open()) {
+    typeData.mVDeserialize.Invoke(component, componentEx);
+  }
+  else if (typeData.mVInit.Open()) {
+    World::Object owner(this, memberId);
+    typeData.mVInit.Invoke(component, owner);
+  }
+}
+
 void Space::VerifyMemberId(MemberId memberId) const {
   if (ValidMemberId(memberId)) {
     return;
@@ -10,6 +10,11 @@
 #include "world/Table.h"
 #include "world/Types.h"
 
+namespace Vlk {
+struct Reader;
+struct Writer;
+}
+
 namespace World {
 
 struct Object;
@@ -76,6 +81,12 @@ struct Space {
   template<typename T>
   Ds::Vector<MemberId> Slice() const;
   Ds::Vector<MemberId> Slice(Comp::TypeId typeId) const;
+  // These are the same as Slice, but the member ids are stored in the frame
+  // arena, so the result must not be kept beyond the current frame.
+  template<typename T>
+  Ds::Vector<MemberId, Ds::FrameAllocator> FrameSlice() const;
+  Ds::Vector<MemberId, Ds::FrameAllocator> FrameSlice(
+    Comp::TypeId typeId) const;
   Ds::Vector<MemberId> RootMemberIds() const;
   Ds::Vector<Comp::TypeId> GetComponentTypes(MemberId owner) const;
 
@@ -83,13 +94,23 @@ struct Space {
   const Ds::Pool<Table>& Tables() const;
 
   void Serialize(Vlk::Value& spaceVal) const;
+  // The Space is written as the Writer's next Value. Only the Value of the
+  // component being serialized exists at any time.
+  void Serialize(Vlk::Writer* writer) const;
   Result Deserialize(const Vlk::Explorer& spaceEx);
+  // The Reader's next Value must be the Space's PairArray. Only the Value of
+  // the component being deserialized exists at any time.
+  Result Deserialize(Vlk::Reader* reader);
 
 private:
   Ds::SparseSet mMembers;
   Ds::Pool<Table> mTables;
 
+  template<typename A>
+  Ds::Vector<MemberId, A> CreateSlice(Comp::TypeId typeId) const;
   bool ValidMemberId(MemberId memberId) const;
+  void DeserializeComponent(
+    Comp::TypeId typeId, MemberId memberId, const Vlk::Explorer& componentEx);
   void VerifyMemberId(MemberId memberId) const;
 
   friend World::Object;
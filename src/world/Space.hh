@@ -78,4 +78,24 @@ Ds::Vector<MemberId> Space::Slice() const {
   return Slice(Comp::Type<T>::smId);
 }
 
+template<typename T>
+Ds::Vector<MemberId, Ds::FrameAllocator> Space::FrameSlice() const {
+  return FrameSlice(Comp::Type<T>::smId);
+}
+
+template<typename A>
+Ds::Vector<MemberId, A> Space::CreateSlice(Comp::TypeId typeId) const {
+  Ds::Vector<MemberId, A> members;
+  if (!mTables.Valid((SparseId)typeId)) {
+    return members;
+  }
+
+  const Table& table = mTables[(SparseId)typeId];
+  members.Reserve(table.Size());
+  for (size_t i = 0; i < table.Size(); ++i) {
+    members.Push(table.GetOwnerAtDenseIndex(i));
+  }
+  return members;
+}
+
 } // namespace World
@@ -1,4 +1,5 @@
 #include "debug/MemLeak.h"
+#include "debug/MemTrack.h"
 #include "util/Memory.h"
 
 #include "world/Table.h"
@@ -125,6 +126,7 @@ void* Table::AllocateComponent(MemberId owner) {
 }
 
 void Table::Grow() {
+  Debug::MemTrack::Scope memTrackScope(Debug::MemTrack::Tag::World);
   const Comp::TypeData& typeData = Comp::GetTypeData(mTypeId);
   if (mData == nullptr) {
     mData = alloc char[smStartCapacity * typeData.mSize];
@@ -3,7 +3,9 @@
 
 #include "Log.h"
 #include "gfx/Renderer.h"
+#include "vlk/Reader.h"
 #include "vlk/Valkor.h"
+#include "vlk/Writer.h"
 #include "world/Registrar.h"
 #include "world/World.h"
 
@@ -63,14 +65,7 @@ void DeleteLayer(LayerIt it) {
   nLayers.Erase(it);
 }
 
-VResult<LayerIt> LoadLayer(const char* filename) {
-  Vlk::Value rootVal;
-  Result result = rootVal.Read(filename);
-  if (!result.Success()) {
-    return VResult<LayerIt>(nLayers.end(), std::move(result));
-  }
-  Vlk::Explorer rootEx(rootVal);
-  Vlk::Explorer metadataEx = rootEx("Metadata");
+Layer& AddLayer(const char* filename, const Vlk::Explorer& metadataEx) {
   nLayers.EmplaceBack();
   Layer& newLayer = *nLayers.Back();
   newLayer.mName = metadataEx("Name").As<std::string>("DefaultName");
@@ -84,6 +79,25 @@ VResult<LayerIt> LoadLayer(const char* filename) {
       .As<ResId>(Gfx::Renderer::nDefaultIntenseExtractId);
   newLayer.mTonemapMaterialId =
     metadataEx("TonemapMaterialId").As<ResId>(Gfx::Renderer::nDefaultTonemapId);
+  return newLayer;
+}
+
+VResult<LayerIt> DeserializationFailure(const char* filename, Result&& result) {
+  std::stringstream error;
+  error << "Layer \"" << filename << "\" failed deserialization.\n"
+        << result.mError;
+  return VResult<LayerIt>(nLayers.end(), Result(error.str()));
+}
+
+VResult<LayerIt> LoadProgressedLayer(const char* filename) {
+  Vlk::Value rootVal;
+  Result result = rootVal.Read(filename);
+  if (!result.Success()) {
+    return VResult<LayerIt>(nLayers.end(), std::move(result));
+  }
+  Vlk::Explorer rootEx(rootVal);
+  Vlk::Explorer metadataEx = rootEx("Metadata");
+  Layer& newLayer = AddLayer(filename, metadataEx);
 
   // Progress the layer forward.
   int layerProgression =
@@ -114,19 +128,69 @@ VResult<LayerIt> LoadLayer(const char* filename) {
   Vlk::Explorer spaceEx(spaceVal);
   result = newLayer.mSpace.Deserialize(spaceEx);
   if (!result.Success()) {
-    std::stringstream error;
-    error << "Layer \"" << filename << "\" failed deserialization.\n"
-          << result.mError;
-    return VResult<LayerIt>(nLayers.end(), Result(error.str()));
+    return DeserializationFailure(filename, std::move(result));
   }
   return VResult<LayerIt>(nLayers.Back());
 }
 
+VResult<LayerIt> LoadLayer(const char* filename) {
+  // Layers that don't need progression are streamed so their Space never
+  // exists as a Value tree. This requires the Metadata to precede the Space,
+  // which is how layers are saved. Anything else is handled by reading the
+  // entire layer.
+  Vlk::Reader reader;
+  if (!reader.Open(filename).Success() ||
+      reader.Next().mValue != Vlk::Reader::Event::BeginPairArray) {
+    return LoadProgressedLayer(filename);
+  }
+  Vlk::Value metadataVal;
+  while (true) {
+    VResult<Vlk::Reader::Event> result = reader.Next();
+    if (!result.Success() || result.mValue != Vlk::Reader::Event::Key) {
+      return LoadProgressedLayer(filename);
+    }
+    if (reader.Key() == "Metadata" &&
+        metadataVal.GetType() == Vlk::Value::Type::Invalid) {
+      if (!reader.ReadValue(&metadataVal).Success()) {
+        return LoadProgressedLayer(filename);
+      }
+      continue;
+    }
+    if (reader.Key() != "Space") {
+      reader.SkipValue();
+      continue;
+    }
+
+    Vlk::Explorer metadataEx(metadataVal);
+    int layerProgression =
+      metadataEx("LayerProgression").As<int>(Registrar::nInvalidProgression);
+    int progression = metadataEx("ComponentProgression")
+                        .As<int>(Registrar::nInvalidProgression);
+    if (layerProgression < Registrar::nCurrentLayerProgression ||
+        progression < Registrar::nCurrentComponentProgression) {
+      return LoadProgressedLayer(filename);
+    }
+    Layer& newLayer = AddLayer(filename, metadataEx);
+    Result deserializeResult = newLayer.mSpace.Deserialize(&reader);
+    if (!deserializeResult.Success()) {
+      return DeserializationFailure(filename, std::move(deserializeResult));
+    }
+    return VResult<LayerIt>(nLayers.Back());
+  }
+}
+
 Result SaveLayer(LayerIt it, const char* filename) {
   Layer& layer = *it;
   layer.mFilename = filename;
-  Vlk::Value rootVal;
-  Vlk::Value& metadataVal = rootVal("Metadata");
+  Vlk::Writer writer;
+  Result result = writer.Open(filename);
+  if (!result.Success()) {
+    return result;
+  }
+
+  // The Space is written directly so a Value for the entire layer is never
+  // created.
+  Vlk::Value metadataVal;
   metadataVal("Name") = layer.mName;
   metadataVal("CameraId") = layer.mCameraId;
   metadataVal("PostMaterialId") = layer.mPostMaterialId;
@@ -134,9 +198,13 @@ Result SaveLayer(LayerIt it, const char* filename) {
   metadataVal("TonemapMaterialId") = layer.mTonemapMaterialId;
   metadataVal("ComponentProgression") = Registrar::nCurrentComponentProgression;
   metadataVal("LayerProgression") = Registrar::nCurrentLayerProgression;
-  Vlk::Value& spaceVal = rootVal("Space");
-  layer.mSpace.Serialize(spaceVal);
-  return rootVal.Write(filename);
+  writer.BeginPairArray();
+  writer.Key("Metadata");
+  writer.WriteValue(metadataVal);
+  writer.Key("Space");
+  layer.mSpace.Serialize(&writer);
+  writer.EndPairArray();
+  return writer.Close();
 }
 
 } // namespace World